@@ -29,6 +29,38 @@
 #define I2C_RETRY_ATTEMPTS 3
 #define I2C_RETRY_DELAY_MS 100
 
+// I2C Bus Recovery
+#define I2C_RECOVERY_ENABLED true        // Clear a stuck bus and restore reset boards without a reboot
+#define I2C_RECOVERY_SCL_PULSES 9        // Clock pulses to make a slave release SDA
+#define I2C_HEALTH_CHECK_INTERVAL_MS 200 // One board's registers are checked against the cache this often (round robin)
+#define I2C_OFFLINE_RETRY_MS 100         // Restore attempt interval for a board that stopped responding
+
+// Limit Switch Interrupts (MCP23017 INTA/INTB mirrored, active-low push-pull)
+#ifdef TIDECLOCK_SIM
+#define SWITCH_INTERRUPTS_ENABLED false // Simulated plant has no INT lines - homing polls
+#else
+#define SWITCH_INTERRUPTS_ENABLED true  // Stop homing motors from the switch interrupt path
+#endif
+#define SWITCH_INT_PIN_0 34             // ESP32 GPIO wired to MCP_SWITCH_0 INTA
+#define SWITCH_INT_PIN_1 35             // ESP32 GPIO wired to MCP_SWITCH_1 INTA
+#define SWITCH_IRQ_TASK_PRIORITY 20     // Interrupt handler task priority (above the motion task)
+#define SWITCH_IRQ_TASK_CORE 1          // Core for the interrupt handler task
+#define SWITCH_IRQ_RECHECK_MS 100       // Re-check INT lines this often in case an edge was missed
+#define SWITCH_IRQ_FALLBACK_POLL_MS 250 // Homing safety poll interval while interrupts are active
+
+// Switch Sampler
+#define SWITCH_SAMPLE_INTERVAL_MS 10    // Background read of every switch (also the debounce sample period)
+#define SWITCH_SAMPLER_TASK_PRIORITY 3  // Above the network task, so web traffic cannot delay samples
+#define SWITCH_SAMPLER_TASK_CORE 0      // Keeps its bus reads off the motion core
+#define SWITCH_SNAPSHOT_RING 8          // Recent snapshots kept for consumers
+#define SWITCH_SNAPSHOT_MAX_AGE_MS 100  // Older cached snapshots are stale - wait for a fresh one
+
+// Emergency Stop
+#define ESTOP_TASK_PRIORITY 24          // Stop task priority (configMAX_PRIORITIES - 1, above everything)
+#define ESTOP_TASK_CORE 1               // Same core as the motion task so a stop preempts it at once
+#define ESTOP_BUTTON_PIN -1             // GPIO for a normally-open stop button to GND (-1 = none)
+#define ESTOP_LOCK_TIMEOUT_MS 5         // Wait this long for an in-progress output write before forcing the stop
+
 // ============================================================================
 // MOTOR SYSTEM CONFIGURATION
 // ============================================================================
@@ -44,6 +76,72 @@
 #define MAX_RUN_TIME_MS 9000            // Maximum motor runtime for positioning
 #define PAUSE_BETWEEN_MOTORS_MS 1000    // Delay between sequential motor operations
 #define SWITCH_POLL_INTERVAL_MS 10      // How often to check switch during homing
+#define SWITCH_SETTLE_TIME_MS 100       // Longest wait for a stopped motor's switch to read released (debounced)
+#define SWITCH_DEBOUNCE_SAMPLES 3       // Consecutive samples a switch change must hold (1-7; window = samples x sample interval)
+#define SWITCH_DEBOUNCE_STALE_MS 100    // Sample gap after which the debouncer restarts from the next read
+
+// Concurrent Homing
+#define HOMING_MAX_CONCURRENT 8         // Default max motors homing at once (limits supply current)
+
+// Concurrent Tide Sequence Planning
+#define TIDE_MAX_CONCURRENT 6           // Default max motors running at once during a tide sequence
+#define MOTOR_RUN_CURRENT_MA 250        // Typical running current of one gearmotor
+#define MOTOR_CURRENT_BUDGET_MA 1500    // Supply current available to all running motors
+#define TIDE_START_STAGGER_MS 100       // Minimum gap between motor starts (limits inrush spikes)
+
+// Position Model
+#define POSITION_DEADBAND_MS 20         // Skip delta moves shorter than this (below run-time accuracy)
+
+// Learned Motor Speed Model (speeds in permille of nominal, 1000 = nominal)
+#define MOTOR_SPEED_NOMINAL 1000        // Speed of a motor that travels 1 ms of position per ms run
+#define MOTOR_SPEED_MIN 700             // Lowest speed the fit will accept
+#define MOTOR_SPEED_MAX 1300            // Highest speed the fit will accept
+#define SPEED_FIT_WEIGHT 4              // Each new sample moves the fit 1/N of the way
+#define SPEED_FIT_MIN_TRAVEL_MS 1000    // Ignore reverse seeks shorter than this (switch tolerance dominates)
+#define SPEED_FIT_MIN_MOTORS 3          // Release samples needed before fitting forward speeds
+#define SPEED_SAVE_THRESHOLD 5          // Persist the fit once any speed has moved this far
+
+// Motor Telemetry (persisted in NVS)
+#define TELEMETRY_FLUSH_INTERVAL_MS 900000 // Write changed run-time counters to flash at most this often
+#define TELEMETRY_HOMING_AVG_WEIGHT 8   // Rolling homing duration: each home moves the average 1/N of the way
+
+// Drift-Budget Re-homing (open-loop error allowed before a motor is re-homed)
+#define REHOME_ENABLED true             // Re-home over-budget motors automatically when idle
+#define DRIFT_TRAVEL_BUDGET_MS 120000   // Travel since last home (ms at nominal speed)
+#define DRIFT_REVERSAL_BUDGET 24        // Direction reversals since last home
+#define DRIFT_MOVE_BUDGET 96            // Moves since last home
+#define REHOME_IDLE_DELAY_MS 30000      // Idle time required before re-homing starts
+#define REHOME_BATCH_SIZE 2             // Max motors re-homed per idle period
+
+// Timed Move Stop Scheduling
+#ifdef TIDECLOCK_SIM
+#define MOTION_TIMER_STOP_ENABLED false // Simulated plant follows Clock time - stop from tick()
+#else
+#define MOTION_TIMER_STOP_ENABLED true  // Stop timed moves from an esp_timer callback instead of the motion pass
+#endif
+#define MOTION_TIMER_LEAD_MAX_US 5000   // Upper bound on learned stop-write compensation
+#define MOTION_TIMER_GRACE_MS 10        // tick() stops a timed move whose stop timer is this late
+
+// Motion Jobs
+#define MOTION_JOB_SLOTS 4              // Jobs held at once (queued, running or finished)
+#define MOTION_JOB_MAX_MOVES 48         // Moves per job
+#define MOTION_JOB_MAX_OFFSET_MS 60000  // Latest start offset of a move within a job
+#define MOTION_JOB_STAGING_SLOTS 2      // Web jobs waiting for the motion task to queue them
+
+// Continuous Tide Tracking (6-minute NOAA predictions)
+#define CONTINUOUS_ENABLED false        // Track the tide with small periodic moves (toggle at runtime)
+#define CONTINUOUS_UPDATE_INTERVAL_MS 600000 // Move motors toward their interpolated targets this often
+#define CONTINUOUS_MAX_STEP_MS 1500     // Largest move per motor per update (bigger changes take several)
+#define CONTINUOUS_FETCH_RETRY_MS 300000 // Wait this long after a failed prediction fetch
+#define CONTINUOUS_SERIES_HOURS 48      // Hours of predictions fetched from local midnight (covers the rolling window)
+#define TIDE_SERIES_MAX_SAMPLES 512     // 6-minute samples held (at least CONTINUOUS_SERIES_HOURS * 10 + 1)
+
+// Rolling Display Window
+#define TIDE_DATASET_HOURS 48           // Hourly predictions held from local midnight (today and tomorrow)
+#define ROLLING_WINDOW_ENABLED false    // Motor 0 = current hour, motors 1-23 = next 23 hours (toggle at runtime)
+#define ROLLING_CHECK_INTERVAL_MS 1000  // How often to check for an hour change
+#define ROLLING_FETCH_RETRY_MS 300000   // Wait this long after a failed daily data refresh
+#define TIDE_WINDOW_INVALID 0xFF        // Hour index when the data does not cover the current time
 
 // ============================================================================
 // PIN MAPPING STRUCTURES
@@ -65,7 +163,8 @@ struct MotorPinMap {
 };
 
 // Motor to MCP board mapping lookup table
-const MotorPinMap MOTOR_PIN_MAP[NUM_MOTORS] = {
+// (constexpr: hardware/PinTopology.h derives and checks the board masks from it)
+constexpr MotorPinMap MOTOR_PIN_MAP[NUM_MOTORS] = {
     // Motors 0-7 on Board 0 (0x20)
     {MCP_MOTOR_0, 4, 5},    // Motor 0: GPA4, GPA5
     {MCP_MOTOR_0, 6, 7},    // Motor 1: GPA6, GPA7
@@ -110,7 +209,8 @@ struct SwitchPinMap {
 };
 
 // Switch to MCP board mapping lookup table
-const SwitchPinMap SWITCH_PIN_MAP[NUM_MOTORS] = {
+// (constexpr: hardware/PinTopology.h derives and checks the demux tables from it)
+constexpr SwitchPinMap SWITCH_PIN_MAP[NUM_MOTORS] = {
     // Switches 0-15 on Board 3 (0x23)
    // {MCP_SWITCH_0, 0},      // Switch 0: GPA0
     //{MCP_SWITCH_0, 1},      // Switch 1: GPA1
@@ -168,6 +268,24 @@ const SwitchPinMap SWITCH_PIN_MAP[NUM_MOTORS] = {
     {MCP_SWITCH_0, 4},     // Switch 23: GPA4
 };
 
+// ============================================================================
+// TASK CONFIGURATION
+// ============================================================================
+
+#define NETWORK_TASK_CORE 0             // Web server and WiFi share core 0 with the WiFi stack
+#define NETWORK_TASK_PRIORITY 1         // Same as the Arduino loop task
+#define NETWORK_TASK_STACK 8192         // Bytes (JSON handlers build large documents)
+#define NETWORK_TASK_PERIOD_MS 2        // Idle time between web server polls
+#define MOTION_TASK_CORE 1              // Motion, switches, LEDs and serial command execution
+#define MOTION_TASK_PRIORITY 5          // Above loop(), below the switch and stop tasks
+#define MOTION_TASK_STACK 8192          // Bytes (homing and tide sequences run on this task)
+#define MOTION_TASK_PERIOD_MS 5         // Fixed cadence of motion passes
+#define MOTION_COMMAND_QUEUE_LENGTH 16 // Pending motor commands (power of two)
+#define MOTION_COMMAND_PRIORITY_LENGTH 4 // Pending emergency stops (power of two)
+#define MOTION_COMMAND_HISTORY 16       // Recent command outcomes kept for status queries
+#define CONSOLE_LINE_MAX 32             // Longest serial command line, including terminator
+#define CONSOLE_QUEUE_LENGTH 8          // Serial lines waiting for the motion task (power of two)
+
 // ============================================================================
 // WIFI CONFIGURATION
 // ============================================================================
@@ -192,6 +310,8 @@ const SwitchPinMap SWITCH_PIN_MAP[NUM_MOTORS] = {
 
 #define EEPROM_SIZE 512                 // Total EEPROM size to allocate
 #define CONFIG_MAGIC "TIDE"             // Magic string to validate EEPROM data
+#define CONFIG_STAGING_SLOTS 2          // Web configuration changes waiting for the motion task
+#define CONFIG_APPLY_WAIT_MS 500        // How long a web save waits for the motion task's result
 
 // ============================================================================
 // LED STRIP CONFIGURATION (WS2812B via FastLED)
@@ -217,6 +337,20 @@ const SwitchPinMap SWITCH_PIN_MAP[NUM_MOTORS] = {
 
 #define SERIAL_BAUD_RATE 115200
 
+// ============================================================================
+// PLANT SIMULATOR (TIDECLOCK_SIM builds only)
+// ============================================================================
+
+#define SIM_TRAVEL_MAX_MS 10000         // Upper mechanical stop (ms of nominal travel above the switch)
+#define SIM_OVERTRAVEL_MS 300           // Lower mechanical stop below the switch trip point
+#define SIM_START_POSITION_MS 3000      // Position of every motor at power-up
+#define SIM_SWITCH_HYSTERESIS_MS 20     // Travel past the trip point before a closed switch opens
+#define SIM_SPEED_SPREAD 100            // Motor speeds spread +/- this (permille) around nominal
+#define SIM_SLIP_PERMILLE 5             // Up to this much travel lost per integration step
+#define SIM_BOUNCE_US 2000              // Switch reads are random this long after each edge
+#define SIM_READ_NOISE_PERMILLE 0       // Chance of a switch read returning the wrong level
+#define SIM_SEED 12345                  // Seed for speeds, slip and noise (runs are repeatable)
+
 // ============================================================================
 // DEBUG SETTINGS
 // ============================================================================
@@ -8,9 +8,14 @@
 #include <EEPROM.h>
 #include <string.h>
 
+static_assert(sizeof(TideClockConfig) <= EEPROM_SIZE, "TideClockConfig does not fit in EEPROM");
+
 // Static member initialization
 TideClockConfig ConfigManager::config;
 bool ConfigManager::configLoaded = false;
+portMUX_TYPE ConfigManager::configMux = portMUX_INITIALIZER_UNLOCKED;
+ConfigUpdate ConfigManager::staged[CONFIG_STAGING_SLOTS];
+std::atomic<bool> ConfigManager::stagedBusy[CONFIG_STAGING_SLOTS] = {};
 
 bool ConfigManager::begin() {
     Logger::info(CAT_SYSTEM, "Initializing Configuration Manager...");
@@ -97,12 +102,86 @@ const TideClockConfig& ConfigManager::getConfig() {
     return config;
 }
 
+void ConfigManager::copyConfig(TideClockConfig& out) {
+    portENTER_CRITICAL(&configMux);
+    out = config;
+    portEXIT_CRITICAL(&configMux);
+}
+
+int8_t ConfigManager::stageUpdate(const ConfigUpdate& update) {
+    for (uint8_t s = 0; s < CONFIG_STAGING_SLOTS; s++) {
+        bool expected = false;
+        if (stagedBusy[s].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            // Published to the motion task by the command queue push
+            staged[s] = update;
+            return s;
+        }
+    }
+
+    Logger::warning(CAT_SYSTEM, "Configuration staging full");
+    return -1;
+}
+
+bool ConfigManager::takeUpdate(uint8_t slot, ConfigUpdate& update) {
+    if (slot >= CONFIG_STAGING_SLOTS || !stagedBusy[slot].load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    update = staged[slot];
+    discardUpdate(slot);
+    return true;
+}
+
+void ConfigManager::discardUpdate(uint8_t slot) {
+    if (slot < CONFIG_STAGING_SLOTS) {
+        stagedBusy[slot].store(false, std::memory_order_release);
+    }
+}
+
+void ConfigManager::applyUpdate(const ConfigUpdate& update) {
+    if (update.fields & CONFIG_UPDATE_WIFI) {
+        setWiFiCredentials(update.wifiSSID, update.wifiPassword);
+    }
+    if (update.fields & CONFIG_UPDATE_MOTOR_TIMING) {
+        setMotorTiming(update.switchReleaseTime, update.maxRunTime);
+    }
+    if (update.fields & CONFIG_UPDATE_STATION) {
+        setNOAAStation(update.stationID);
+    }
+    if (update.fields & CONFIG_UPDATE_TIDE_RANGE) {
+        setTideRange(update.minTideHeight, update.maxTideHeight);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_ENABLED) {
+        setLEDEnabled(update.ledEnabled);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_PIN) {
+        setLEDPin(update.ledPin);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_COUNT) {
+        setLEDCount(update.ledCount);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_MODE) {
+        setLEDMode(update.ledMode);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_BRIGHTNESS) {
+        setLEDBrightness(update.ledBrightness);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_COLOR) {
+        setLEDColorIndex(update.ledColorIndex);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_HOURS) {
+        setLEDActiveHours(update.ledStartHour, update.ledEndHour);
+    }
+}
+
 void ConfigManager::setWiFiCredentials(const char* ssid, const char* password) {
+    portENTER_CRITICAL(&configMux);
     strncpy(config.wifiSSID, ssid, sizeof(config.wifiSSID) - 1);
     config.wifiSSID[sizeof(config.wifiSSID) - 1] = '\0';
 
     strncpy(config.wifiPassword, password, sizeof(config.wifiPassword) - 1);
     config.wifiPassword[sizeof(config.wifiPassword) - 1] = '\0';
+    portEXIT_CRITICAL(&configMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM, "WiFi credentials updated: SSID=%s", ssid);
 }
@@ -119,8 +198,10 @@ void ConfigManager::setMotorTiming(uint16_t switchRelease, uint16_t maxRun) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.switchReleaseTime = switchRelease;
     config.maxRunTime = maxRun;
+    portEXIT_CRITICAL(&configMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM,
                  "Motor timing updated: switch=%ums, maxRun=%ums",
@@ -133,8 +214,10 @@ void ConfigManager::setNOAAStation(const char* stationID) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     strncpy(config.stationID, stationID, sizeof(config.stationID) - 1);
     config.stationID[sizeof(config.stationID) - 1] = '\0';
+    portEXIT_CRITICAL(&configMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM, "NOAA station ID updated: %s", stationID);
 }
@@ -151,54 +234,26 @@ void ConfigManager::setTideRange(float minHeight, float maxHeight) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.minTideHeight = minHeight;
     config.maxTideHeight = maxHeight;
+    portEXIT_CRITICAL(&configMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM,
                  "Tide range updated: %.1f to %.1f feet",
                  minHeight, maxHeight);
 }
 
-void ConfigManager::setMotorOffset(uint8_t motorIndex, float offset) {
-    if (motorIndex >= 24) {
-        Logger::warning(CAT_SYSTEM, "Invalid motor index");
-        return;
-    }
-
-    if (offset < 0.8 || offset > 1.2) {
-        Logger::warning(CAT_SYSTEM, "Motor offset out of range (0.8-1.2)");
-        return;
-    }
-
-    config.motorOffsets[motorIndex] = offset;
-
-    Logger::logf(LOG_INFO, CAT_SYSTEM,
-                 "Motor %u offset updated: %.3f",
-                 motorIndex, offset);
-}
-
-float ConfigManager::getMotorOffset(uint8_t motorIndex) {
-    if (motorIndex >= 24) {
-        return 1.0;  // Default if invalid
-    }
-    return config.motorOffsets[motorIndex];
-}
-
-void ConfigManager::resetMotorOffsets() {
-    Logger::info(CAT_SYSTEM, "Resetting all motor offsets to 1.0");
-    for (uint8_t i = 0; i < 24; i++) {
-        config.motorOffsets[i] = 1.0;
-    }
-}
-
 void ConfigManager::setAutoFetch(bool enabled, uint8_t hour) {
     if (hour > 23) {
         Logger::warning(CAT_SYSTEM, "Invalid fetch hour (0-23)");
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.autoFetchEnabled = enabled;
     config.fetchHour = hour;
+    portEXIT_CRITICAL(&configMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM,
                  "Auto-fetch %s (hour: %u)",
@@ -206,7 +261,9 @@ void ConfigManager::setAutoFetch(bool enabled, uint8_t hour) {
 }
 
 void ConfigManager::setLEDEnabled(bool enabled) {
+    portENTER_CRITICAL(&configMux);
     config.ledEnabled = enabled;
+    portEXIT_CRITICAL(&configMux);
     Logger::logf(LOG_INFO, CAT_SYSTEM, "LED system %s", enabled ? "enabled" : "disabled");
 }
 
@@ -222,7 +279,9 @@ void ConfigManager::setLEDPin(uint8_t pin) {
         Logger::warning(CAT_SYSTEM, "Warning: GPIO pin conflicts with I2C (21/22)");
     }
 
+    portENTER_CRITICAL(&configMux);
     config.ledPin = pin;
+    portEXIT_CRITICAL(&configMux);
     Logger::logf(LOG_INFO, CAT_SYSTEM, "LED data pin set to GPIO %u", pin);
 }
 
@@ -232,7 +291,9 @@ void ConfigManager::setLEDCount(uint16_t count) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.ledCount = count;
+    portEXIT_CRITICAL(&configMux);
     Logger::logf(LOG_INFO, CAT_SYSTEM, "LED count set to %u", count);
 }
 
@@ -242,7 +303,9 @@ void ConfigManager::setLEDMode(uint8_t mode) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.ledMode = mode;
+    portEXIT_CRITICAL(&configMux);
     const char* modeName = (mode == LED_MODE_STATIC) ? "Static" : "Test Pattern";
     Logger::logf(LOG_INFO, CAT_SYSTEM, "LED mode set to %s", modeName);
 }
@@ -255,7 +318,9 @@ void ConfigManager::setLEDBrightness(uint8_t brightness) {
         brightness = LED_MAX_BRIGHTNESS;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.ledBrightness = brightness;
+    portEXIT_CRITICAL(&configMux);
     Logger::logf(LOG_INFO, CAT_SYSTEM, "LED brightness set to %u (%.0f%%)",
                  brightness, (brightness / 255.0) * 100);
 }
@@ -266,7 +331,9 @@ void ConfigManager::setLEDColorIndex(uint8_t colorIndex) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.ledColorIndex = colorIndex;
+    portEXIT_CRITICAL(&configMux);
     Logger::logf(LOG_INFO, CAT_SYSTEM, "LED color index set to %u", colorIndex);
 }
 
@@ -276,8 +343,10 @@ void ConfigManager::setLEDActiveHours(uint8_t startHour, uint8_t endHour) {
         return;
     }
 
+    portENTER_CRITICAL(&configMux);
     config.ledStartHour = startHour;
     config.ledEndHour = endHour;
+    portEXIT_CRITICAL(&configMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM,
                  "LED active hours set to %02u:00 - %02u:00",
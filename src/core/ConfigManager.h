@@ -3,12 +3,21 @@
  *
  * Manages persistent configuration storage in EEPROM
  * Phase 2: WiFi credentials and basic motor settings
+ *
+ * The motion task owns the configuration: only it calls the setters and
+ * save(). Other tasks stage a ConfigUpdate and post
+ * MOTION_COMMAND_APPLY_CONFIG with the staging slot, and read the
+ * configuration through copyConfig(), which never sees a half-written
+ * setting.
  */
 
 #ifndef CONFIG_MANAGER_H
 #define CONFIG_MANAGER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <atomic>
+#include "../config.h"
 
 /**
  * Configuration structure stored in EEPROM
@@ -25,7 +34,7 @@ struct TideClockConfig {
     char stationID[10];             // NOAA station ID (e.g., "8729108")
     float minTideHeight;            // Expected minimum tide (feet, MLLW)
     float maxTideHeight;            // Expected maximum tide (feet, MLLW)
-    float motorOffsets[24];         // Motor-specific calibration multipliers
+    float motorOffsets[24];         // Unused since MotorSpeedModel; kept for the EEPROM layout
     bool autoFetchEnabled;          // Enable automatic daily fetch
     uint8_t fetchHour;              // Hour to fetch (0-23, for automatic mode)
 
@@ -42,6 +51,45 @@ struct TideClockConfig {
     uint16_t checksum;              // Simple checksum for validation
 };
 
+/**
+ * Settings present in a ConfigUpdate
+ */
+enum ConfigUpdateField {
+    CONFIG_UPDATE_WIFI          = 1 << 0,
+    CONFIG_UPDATE_MOTOR_TIMING  = 1 << 1,
+    CONFIG_UPDATE_STATION       = 1 << 2,
+    CONFIG_UPDATE_TIDE_RANGE    = 1 << 3,
+    CONFIG_UPDATE_LED_ENABLED   = 1 << 4,
+    CONFIG_UPDATE_LED_PIN       = 1 << 5,
+    CONFIG_UPDATE_LED_COUNT     = 1 << 6,
+    CONFIG_UPDATE_LED_MODE      = 1 << 7,
+    CONFIG_UPDATE_LED_BRIGHTNESS = 1 << 8,
+    CONFIG_UPDATE_LED_COLOR     = 1 << 9,
+    CONFIG_UPDATE_LED_HOURS     = 1 << 10
+};
+
+/**
+ * Settings changed by one request, applied on the motion task
+ */
+struct ConfigUpdate {
+    uint16_t fields;                // ConfigUpdateField bits
+    char wifiSSID[32];
+    char wifiPassword[64];
+    uint16_t switchReleaseTime;
+    uint16_t maxRunTime;
+    char stationID[10];
+    float minTideHeight;
+    float maxTideHeight;
+    bool ledEnabled;
+    uint8_t ledPin;
+    uint16_t ledCount;
+    uint8_t ledMode;
+    uint8_t ledBrightness;
+    uint8_t ledColorIndex;
+    uint8_t ledStartHour;
+    uint8_t ledEndHour;
+};
+
 class ConfigManager {
 public:
     /**
@@ -68,44 +116,58 @@ public:
     static void factoryReset();
 
     /**
-     * Get current configuration (read-only access)
+     * Get current configuration (read-only access, motion task)
      */
     static const TideClockConfig& getConfig();
 
     /**
-     * Update WiFi credentials
+     * Copy the current configuration (any task)
      */
-    static void setWiFiCredentials(const char* ssid, const char* password);
+    static void copyConfig(TideClockConfig& out);
 
     /**
-     * Update motor timing parameters
+     * Stage a configuration change for the motion task (any task)
+     * @return Staging slot to post with MOTION_COMMAND_APPLY_CONFIG, or -1
+     *         if every staging slot is taken
      */
-    static void setMotorTiming(uint16_t switchRelease, uint16_t maxRun);
+    static int8_t stageUpdate(const ConfigUpdate& update);
 
     /**
-     * Update NOAA station configuration
+     * Take a staged change and free its slot (motion task)
+     * @return false if the slot holds no change
      */
-    static void setNOAAStation(const char* stationID);
+    static bool takeUpdate(uint8_t slot, ConfigUpdate& update);
 
     /**
-     * Update tide range configuration
+     * Free a staging slot without applying its change
      */
-    static void setTideRange(float minHeight, float maxHeight);
+    static void discardUpdate(uint8_t slot);
 
     /**
-     * Update motor offset for specific motor
+     * Apply every setting in a change through the setters (motion task)
+     * Settings the setters reject keep their current value.
      */
-    static void setMotorOffset(uint8_t motorIndex, float offset);
+    static void applyUpdate(const ConfigUpdate& update);
 
     /**
-     * Get motor offset for specific motor
+     * Update WiFi credentials
      */
-    static float getMotorOffset(uint8_t motorIndex);
+    static void setWiFiCredentials(const char* ssid, const char* password);
 
     /**
-     * Reset all motor offsets to 1.0
+     * Update motor timing parameters
      */
-    static void resetMotorOffsets();
+    static void setMotorTiming(uint16_t switchRelease, uint16_t maxRun);
+
+    /**
+     * Update NOAA station configuration
+     */
+    static void setNOAAStation(const char* stationID);
+
+    /**
+     * Update tide range configuration
+     */
+    static void setTideRange(float minHeight, float maxHeight);
 
     /**
      * Update automatic fetch settings
@@ -132,6 +194,9 @@ public:
 private:
     static TideClockConfig config;
     static bool configLoaded;
+    static portMUX_TYPE configMux;      // Setter writes vs. copyConfig()
+    static ConfigUpdate staged[CONFIG_STAGING_SLOTS];
+    static std::atomic<bool> stagedBusy[CONFIG_STAGING_SLOTS];
 
     static uint16_t calculateChecksum();
     static void setDefaults();
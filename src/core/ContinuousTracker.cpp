@@ -0,0 +1,321 @@
+/**
+ * TideClock Continuous Tide Tracker Implementation
+ */
+
+#include "ContinuousTracker.h"
+#include "ConfigManager.h"
+#include "RollingWindow.h"
+#include "StateManager.h"
+#include "../hardware/MotorController.h"
+#include "../hardware/MotionExecutor.h"
+#include "../hardware/MotionJobQueue.h"
+#include "../hardware/TideSequencePlanner.h"
+#include "../network/NOAAClient.h"
+#include "../network/TimeManager.h"
+#include "../utils/Logger.h"
+#include "../utils/Clock.h"
+
+// Static member initialization
+std::atomic<bool> ContinuousTracker::enabled(CONTINUOUS_ENABLED);
+std::atomic<bool> ContinuousTracker::updateRequested(false);
+std::atomic<bool> ContinuousTracker::fetchRequested(false);
+TideSeries ContinuousTracker::series;
+TideSeries ContinuousTracker::fetchBuffer;
+std::atomic<uint32_t> ContinuousTracker::seriesSequence(0);
+uint64_t ContinuousTracker::lastUpdateAt = 0;
+uint64_t ContinuousTracker::lastFetchAttempt = 0;
+int32_t ContinuousTracker::targets[NUM_MOTORS];
+ContinuousUpdate ContinuousTracker::lastUpdate = {0, NUM_MOTORS, 0, 0, 0, 0};
+
+void ContinuousTracker::begin() {
+    memset(&series, 0, sizeof(series));
+    series.isValid = false;
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        targets[i] = -1;
+    }
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Continuous tracking %s (update every %lu s, max step %d ms)",
+                 enabled ? "enabled" : "disabled",
+                 (unsigned long)(CONTINUOUS_UPDATE_INTERVAL_MS / 1000), CONTINUOUS_MAX_STEP_MS);
+}
+
+void ContinuousTracker::serviceFetch() {
+    if (!enabled || !TimeManager::isTimeSynced()) {
+        return;
+    }
+
+    // Only this task writes the series, so it can be read here without the sequence check
+    String today = TimeManager::getFormattedDate();
+    if (series.isValid && strcmp(series.date, today.c_str()) == 0) {
+        return;
+    }
+
+    uint64_t now = Clock::nowMillis();
+    bool requested = fetchRequested.exchange(false);
+    if (!requested && lastFetchAttempt != 0 && now - lastFetchAttempt < CONTINUOUS_FETCH_RETRY_MS) {
+        return;
+    }
+    lastFetchAttempt = now;
+
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
+    if (strlen(config.stationID) == 0) {
+        Logger::warning(CAT_SYSTEM, "Continuous: NOAA station ID not configured");
+        return;
+    }
+
+    NOAAClient::FetchResult result = NOAAClient::fetchPredictionSeries(
+        config.stationID, &fetchBuffer, CONTINUOUS_SERIES_HOURS);
+
+    if (result != NOAAClient::SUCCESS) {
+        Logger::logf(LOG_WARNING, CAT_SYSTEM, "Continuous: prediction fetch failed (%s) - retry in %lu s",
+                     NOAAClient::getErrorMessage(result),
+                     (unsigned long)(CONTINUOUS_FETCH_RETRY_MS / 1000));
+        return;
+    }
+
+    // Publish: odd sequence while copying tells the motion task to retry
+    uint32_t sequence = seriesSequence.load(std::memory_order_relaxed);
+    seriesSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&series, &fetchBuffer, sizeof(series));
+    seriesSequence.store(sequence + 2, std::memory_order_release);
+
+    // Apply new data at the next quiet motion pass instead of waiting for the cadence
+    updateRequested = true;
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Continuous: loaded %u predictions for %s",
+                 series.count, series.date);
+}
+
+void ContinuousTracker::service() {
+    if (!enabled) {
+        return;
+    }
+
+    uint64_t now = Clock::nowMillis();
+    if (!updateRequested && lastUpdateAt != 0 && now - lastUpdateAt < CONTINUOUS_UPDATE_INTERVAL_MS) {
+        return;
+    }
+
+    // Wait for a quiet pass; the cadence is slow enough that a late update costs nothing
+    if (StateManager::getState() != STATE_READY || MotorController::isEmergencyStopped() ||
+        !MotionExecutor::isIdle() || MotionJobQueue::isBusy()) {
+        return;
+    }
+
+    if (!TimeManager::isTimeSynced() || !hasSeries()) {
+        return;
+    }
+
+    updateRequested = false;
+    lastUpdateAt = now;
+    update();
+}
+
+void ContinuousTracker::setEnabled(bool enable) {
+    enabled = enable;
+    if (enable) {
+        updateRequested = true;
+        fetchRequested = true;
+    }
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Continuous tracking %s", enable ? "enabled" : "disabled");
+}
+
+bool ContinuousTracker::isEnabled() {
+    return enabled;
+}
+
+bool ContinuousTracker::hasSeries() {
+    return series.isValid;
+}
+
+int32_t ContinuousTracker::getTarget(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return -1;
+    }
+    return targets[motorIndex];
+}
+
+const ContinuousUpdate& ContinuousTracker::getLastUpdate() {
+    return lastUpdate;
+}
+
+uint16_t ContinuousTracker::getSampleCount() {
+    return series.isValid ? series.count : 0;
+}
+
+void ContinuousTracker::update() {
+    int32_t newTargets[NUM_MOTORS];
+    uint8_t liveMotor;
+
+    if (!computeTargets(newTargets, liveMotor)) {
+        // New series copied in while reading - try again next pass
+        updateRequested = true;
+        return;
+    }
+
+    TidePlan plan;
+    TideSequencePlanner::clearPlan(plan);
+    uint8_t limited = 0;
+    uint8_t skipped = 0;
+
+    for (uint8_t motor = 0; motor < NUM_MOTORS; motor++) {
+        targets[motor] = newTargets[motor];
+
+        // Stepping toward a target needs a reference; unhomed motors wait for homing
+        if (newTargets[motor] < 0 || !MotorController::isPositionKnown(motor)) {
+            skipped++;
+            continue;
+        }
+
+        int32_t position = MotorController::getPosition(motor);
+        int32_t step = newTargets[motor];
+        if (step > position + CONTINUOUS_MAX_STEP_MS) {
+            step = position + CONTINUOUS_MAX_STEP_MS;
+            limited++;
+        } else if (step < position - CONTINUOUS_MAX_STEP_MS) {
+            step = position - CONTINUOUS_MAX_STEP_MS;
+            limited++;
+        }
+
+        MotorDirection direction;
+        uint16_t runTime;
+        MotorController::planMoveToPosition(motor, step > 0xFFFF ? 0xFFFF : step, direction, runTime);
+        TideSequencePlanner::addMove(plan, motor, direction, runTime);
+    }
+
+    lastUpdate.at = Clock::nowMillis();
+    lastUpdate.liveMotor = liveMotor;
+    lastUpdate.moveCount = plan.moveCount;
+    lastUpdate.limitedCount = limited;
+    lastUpdate.skippedCount = skipped;
+    lastUpdate.jobId = 0;
+
+    if (plan.moveCount == 0) {
+        Logger::logf(LOG_DEBUG, CAT_MOTOR, "Continuous: motors on target (live motor %d)", liveMotor);
+        return;
+    }
+
+    // Same lane packing as the tide sequence, run as a job so this pass returns at once
+    TideSequencePlanner::buildPlan(plan, TIDE_MAX_CONCURRENT);
+
+    JobMove moves[NUM_MOTORS];
+    for (uint8_t i = 0; i < plan.moveCount; i++) {
+        moves[i].motor = plan.moves[i].motor;
+        moves[i].direction = plan.moves[i].direction;
+        moves[i].durationMs = plan.moves[i].durationMs;
+        moves[i].offsetMs = plan.moves[i].startOffsetMs;
+    }
+
+    lastUpdate.jobId = MotionJobQueue::submit(moves, plan.moveCount);
+    if (lastUpdate.jobId == 0) {
+        Logger::warning(CAT_MOTOR, "Continuous: could not queue step moves");
+        return;
+    }
+
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Continuous: %u step moves (%u limited), live motor %d, job %u",
+                 plan.moveCount, limited, liveMotor, lastUpdate.jobId);
+}
+
+bool ContinuousTracker::computeTargets(int32_t* out, uint8_t& liveMotor) {
+    struct tm timeinfo;
+    TimeManager::getCurrentDateTime(&timeinfo);
+    uint32_t now = (uint32_t)TimeManager::getEpochTime();
+
+    // Motor index = hour of day, or hours from now with the rolling window
+    uint8_t firstHour = RollingWindow::isEnabled() ? timeinfo.tm_hour : 0;
+    liveMotor = timeinfo.tm_hour - firstHour;
+
+    uint32_t sequence = seriesSequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    for (uint8_t motor = 0; motor < NUM_MOTORS; motor++) {
+        uint32_t when = now;
+        if (motor != liveMotor) {
+            // mktime() carries hours past 23 into tomorrow
+            struct tm hourStart = timeinfo;
+            hourStart.tm_hour = firstHour + motor;
+            hourStart.tm_min = 0;
+            hourStart.tm_sec = 0;
+            hourStart.tm_isdst = -1;
+            when = (uint32_t)mktime(&hourStart);
+        }
+
+        float height;
+        out[motor] = heightAt(when, height) ? heightToPosition(height) : -1;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seriesSequence.load(std::memory_order_relaxed) == sequence;
+}
+
+bool ContinuousTracker::heightAt(uint32_t epoch, float& height) {
+    uint16_t count = series.count;
+    if (!series.isValid || count < 2 || count > TIDE_SERIES_MAX_SAMPLES ||
+        epoch < series.times[0] || epoch > series.times[count - 1]) {
+        return false;
+    }
+
+    // Bracketing samples: times[low] <= epoch <= times[high]
+    uint16_t low = 0;
+    uint16_t high = count - 1;
+    while (high - low > 1) {
+        uint16_t mid = (low + high) / 2;
+        if (series.times[mid] <= epoch) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    float fraction = (float)(epoch - series.times[low]) / (float)(series.times[high] - series.times[low]);
+    height = series.heights[low] + (series.heights[high] - series.heights[low]) * fraction;
+    return true;
+}
+
+uint16_t ContinuousTracker::heightToPosition(float height) {
+    // Same scaling as NOAAClient applies to the hourly data
+    const TideClockConfig& config = ConfigManager::getConfig();
+    float tideRange = config.maxTideHeight - config.minTideHeight;
+    if (tideRange <= 0.0) {
+        return 0;
+    }
+
+    float position = (height - config.minTideHeight) / tideRange * config.maxRunTime;
+    if (position < 0.0) {
+        position = 0.0;
+    } else if (position > config.maxRunTime) {
+        position = config.maxRunTime;
+    }
+
+    return (uint16_t)(position + 0.5);
+}
+
+void ContinuousTracker::printStatus() {
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Continuous tracking %s, %u predictions%s%s",
+                 enabled ? "enabled" : "disabled", getSampleCount(),
+                 series.isValid ? " for " : "", series.isValid ? series.date : "");
+
+    if (lastUpdate.at == 0) {
+        Logger::info(CAT_SYSTEM, "  No update yet");
+        return;
+    }
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "  Last update %lu s ago: %u moves (%u limited, %u skipped), live motor %d",
+                 (unsigned long)((Clock::nowMillis() - lastUpdate.at) / 1000), lastUpdate.moveCount,
+                 lastUpdate.limitedCount, lastUpdate.skippedCount, lastUpdate.liveMotor);
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (!MotorController::isPositionKnown(i)) {
+            Logger::logf(LOG_INFO, CAT_SYSTEM, "  Motor %02d: target %5ld ms  (not homed)",
+                         i, (long)targets[i]);
+            continue;
+        }
+        Logger::logf(LOG_INFO, CAT_SYSTEM, "  Motor %02d: target %5ld ms  position %5ld ms%s",
+                     i, (long)targets[i], (long)MotorController::getPosition(i),
+                     i == lastUpdate.liveMotor ? "  (live)" : "");
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * TideClock Continuous Tide Tracker
+ *
+ * Keeps the display in step with the tide between full sequences. The
+ * network task fetches NOAA 6-minute predictions for the day; the motion
+ * task, on a fixed cadence, interpolates each motor's target from them and
+ * moves every motor a small step toward it as one motion job.
+ *
+ * Motor N shows the predicted level at the start of its hour, as in the
+ * tide sequence (hour N, or the Nth hour from now with the rolling
+ * window), except the motor for the hour in progress, which follows the
+ * live level through the hour.
+ * Steps are capped at CONTINUOUS_MAX_STEP_MS per update, so large changes
+ * (new data, first start) are spread over several updates instead of one
+ * long burst. Motors without a position estimate are left alone until
+ * they are homed.
+ */
+
+#ifndef CONTINUOUS_TRACKER_H
+#define CONTINUOUS_TRACKER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../config.h"
+#include "../data/TideData.h"
+
+/**
+ * Outcome of the most recent update
+ */
+struct ContinuousUpdate {
+    uint64_t at;                // Clock::nowMillis() of the update (0 = none yet)
+    uint8_t liveMotor;          // Motor following the live level (NUM_MOTORS = none)
+    uint8_t moveCount;          // Moves submitted
+    uint8_t limitedCount;       // Moves cut short by CONTINUOUS_MAX_STEP_MS
+    uint8_t skippedCount;       // Motors skipped (not homed or outside the series)
+    uint16_t jobId;             // Motion job running the moves (0 = none)
+};
+
+class ContinuousTracker {
+public:
+    /**
+     * Initialize tracker with no prediction series
+     */
+    static void begin();
+
+    /**
+     * Fetch predictions when the series is missing or from another day
+     * (call from the network task; blocks during the HTTP request)
+     */
+    static void serviceFetch();
+
+    /**
+     * Move motors toward their targets when an update is due
+     * (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Enable or disable continuous tracking (any task)
+     * Enabling runs an update as soon as predictions are available.
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Check if a prediction series for today is loaded
+     */
+    static bool hasSeries();
+
+    /**
+     * Get a motor's target from the latest update
+     * @return Position in ms of travel at nominal speed, or -1 if none
+     */
+    static int32_t getTarget(uint8_t motorIndex);
+
+    /**
+     * Get the outcome of the most recent update
+     */
+    static const ContinuousUpdate& getLastUpdate();
+
+    /**
+     * Number of samples in the loaded series (0 = none)
+     */
+    static uint16_t getSampleCount();
+
+    /**
+     * Print tracker state and targets
+     */
+    static void printStatus();
+
+private:
+    static std::atomic<bool> enabled;
+    static std::atomic<bool> updateRequested;
+    static std::atomic<bool> fetchRequested;
+
+    // Series read by the motion task, guarded by a sequence count
+    // (odd while the network task copies in a new fetch)
+    static TideSeries series;
+    static TideSeries fetchBuffer;
+    static std::atomic<uint32_t> seriesSequence;
+
+    static uint64_t lastUpdateAt;       // Motion task
+    static uint64_t lastFetchAttempt;   // Network task
+    static int32_t targets[NUM_MOTORS];
+    static ContinuousUpdate lastUpdate;
+
+    /**
+     * Compute targets and submit the step moves
+     */
+    static void update();
+
+    /**
+     * Compute every motor's target from the series
+     * @param out Receives targets (-1 where the series does not cover the time)
+     * @param liveMotor Receives the motor for the hour in progress
+     * @return false if the series changed while being read
+     */
+    static bool computeTargets(int32_t* out, uint8_t& liveMotor);
+
+    /**
+     * Interpolate the tide height at a Unix time
+     * @return false if the time is outside the series
+     */
+    static bool heightAt(uint32_t epoch, float& height);
+
+    /**
+     * Scale a tide height to a motor position (tide range and run time)
+     */
+    static uint16_t heightToPosition(float height);
+};
+
+#endif // CONTINUOUS_TRACKER_H
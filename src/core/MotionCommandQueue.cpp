@@ -0,0 +1,435 @@
+/**
+ * TideClock Motion Command Queue Implementation
+ */
+
+#include "MotionCommandQueue.h"
+#include "StateManager.h"
+#include "ConfigManager.h"
+#include "../hardware/MotionExecutor.h"
+#include "../hardware/MotionJobQueue.h"
+#include "../hardware/EmergencyStop.h"
+#include "../hardware/LEDController.h"
+#include "../hardware/MotorSpeedModel.h"
+#include "../data/TideData.h"
+#include "../utils/Clock.h"
+#include "../utils/Logger.h"
+
+#ifdef TIDECLOCK_SIM
+#include "../sim/PlantSimulator.h"
+#endif
+
+// Static member initialization
+BoundedQueue<MotionCommand, MOTION_COMMAND_QUEUE_LENGTH> MotionCommandQueue::normalLane;
+BoundedQueue<MotionCommand, MOTION_COMMAND_PRIORITY_LENGTH> MotionCommandQueue::priorityLane;
+MotionCommandStatus MotionCommandQueue::history[MOTION_COMMAND_HISTORY];
+MotionCommandStats MotionCommandQueue::stats = {0, 0, 0, 0, 0, 0};
+MotionOperation MotionCommandQueue::lastOperation = {MOTION_COMMAND_HOME_ALL, false, false, false, 0, 0, 0, 0};
+std::atomic<uint32_t> MotionCommandQueue::nextId(1);
+std::atomic<uint32_t> MotionCommandQueue::postedCount(0);
+std::atomic<uint32_t> MotionCommandQueue::queueFullCount(0);
+
+uint32_t MotionCommandQueue::post(MotionCommand command) {
+    command.id = nextId.fetch_add(1, std::memory_order_relaxed);
+    if (command.id == 0) {
+        // 0 marks "not queued"; skip it when the counter wraps
+        command.id = nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Recorded before the push - the motion task may finish it before post() returns
+    setStatus(command.id, command.type, COMMAND_QUEUED, "Queued");
+
+    bool queued;
+    if (command.type == MOTION_COMMAND_ESTOP) {
+        // Outputs go low now; the lane only carries the follow-up
+        EmergencyStop::trigger(command.source == COMMAND_SOURCE_WEB ? ESTOP_SOURCE_WEB
+                                                                   : ESTOP_SOURCE_SERIAL);
+        queued = priorityLane.push(command);
+    } else {
+        queued = normalLane.push(command);
+    }
+
+    if (!queued) {
+        setStatus(command.id, command.type, COMMAND_REJECTED, "Command queue full");
+        queueFullCount.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    postedCount.fetch_add(1, std::memory_order_relaxed);
+    return command.id;
+}
+
+void MotionCommandQueue::drain() {
+    MotionCommand command;
+
+    for (;;) {
+        // Stops first, including any posted while the last command ran
+        while (priorityLane.pop(command)) {
+            execute(command);
+        }
+
+        uint32_t depth = normalLane.size();
+        if (depth > stats.maxDepth) {
+            stats.maxDepth = depth;
+        }
+
+        if (!normalLane.pop(command)) {
+            break;
+        }
+        execute(command);
+    }
+}
+
+bool MotionCommandQueue::getStatus(uint32_t id, MotionCommandStatus& status) {
+    if (id == 0) {
+        return false;
+    }
+
+    status = history[id % MOTION_COMMAND_HISTORY];
+    return status.id == id;
+}
+
+const MotionOperation& MotionCommandQueue::getLastOperation() {
+    return lastOperation;
+}
+
+MotionCommandStats MotionCommandQueue::getStats() {
+    MotionCommandStats snapshot = stats;
+    snapshot.posted = postedCount.load(std::memory_order_relaxed);
+    snapshot.queueFull = queueFullCount.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+const char* MotionCommandQueue::getTypeName(MotionCommandType type) {
+    switch (type) {
+        case MOTION_COMMAND_MOVE:       return "move";
+        case MOTION_COMMAND_MOVE_TO:    return "move-to";
+        case MOTION_COMMAND_STOP:       return "stop";
+        case MOTION_COMMAND_HOME:       return "home";
+        case MOTION_COMMAND_HOME_ALL:   return "home-all";
+        case MOTION_COMMAND_RUN_TIDE:   return "run-tide";
+        case MOTION_COMMAND_CLEAR_STOP: return "clear-stop";
+        case MOTION_COMMAND_SUBMIT_JOB: return "submit-job";
+        case MOTION_COMMAND_CANCEL_JOB: return "cancel-job";
+        case MOTION_COMMAND_LED_TEST:   return "led-test";
+        case MOTION_COMMAND_RESET_SPEEDS: return "reset-speeds";
+        case MOTION_COMMAND_APPLY_CONFIG: return "apply-config";
+        case MOTION_COMMAND_ESTOP:      return "emergency-stop";
+        default:                        return "unknown";
+    }
+}
+
+const char* MotionCommandQueue::getStateName(MotionCommandState state) {
+    switch (state) {
+        case COMMAND_QUEUED:   return "queued";
+        case COMMAND_RUNNING:  return "running";
+        case COMMAND_DONE:     return "done";
+        case COMMAND_FAILED:   return "failed";
+        case COMMAND_REJECTED: return "rejected";
+        case COMMAND_DROPPED:  return "dropped";
+        default:               return "unknown";
+    }
+}
+
+// ============================================================================
+// EXECUTION (motion task)
+// ============================================================================
+
+void MotionCommandQueue::execute(const MotionCommand& command) {
+    SystemState state = StateManager::getState();
+
+    switch (command.type) {
+        case MOTION_COMMAND_ESTOP: {
+            // EmergencyStop::service() has already latched the state; nothing
+            // queued before the stop may start after it
+            MotionCommand pending;
+            while (normalLane.pop(pending)) {
+                if (pending.type == MOTION_COMMAND_SUBMIT_JOB) {
+                    MotionJobQueue::discardStaged(pending.value);
+                } else if (pending.type == MOTION_COMMAND_APPLY_CONFIG) {
+                    ConfigManager::discardUpdate(pending.value);
+                }
+                finish(pending, COMMAND_DROPPED, "Dropped by emergency stop");
+            }
+            if (state != STATE_EMERGENCY_STOP) {
+                StateManager::enterEmergencyStop();
+            }
+            finish(command, COMMAND_DONE, "Emergency stop activated");
+            return;
+        }
+
+        case MOTION_COMMAND_MOVE:
+        case MOTION_COMMAND_MOVE_TO: {
+            // Moves on different motors may overlap; nothing else may run
+            if (state != STATE_READY && state != STATE_TESTING) {
+                finish(command, COMMAND_REJECTED, "Cannot test motors in current state");
+                return;
+            }
+
+            // MotionExecutor returns to READY when the last move ends
+            StateManager::setState(STATE_TESTING);
+            bool started;
+            if (command.type == MOTION_COMMAND_MOVE) {
+                started = MotionExecutor::startMove(command.motor, command.direction, command.value);
+            } else {
+                started = MotorController::moveToPosition(command.motor, command.value);
+            }
+
+            if (!started) {
+                finish(command, COMMAND_REJECTED, "Failed to start motor");
+                return;
+            }
+            finish(command, COMMAND_DONE, "Motor move started");
+            return;
+        }
+
+        case MOTION_COMMAND_STOP:
+            MotionExecutor::cancelMove(command.motor);
+            Logger::logf(LOG_INFO, CAT_TEST, "Motor %d stopped", command.motor);
+            finish(command, COMMAND_DONE, "Motor stopped");
+            return;
+
+        case MOTION_COMMAND_HOME:
+        case MOTION_COMMAND_HOME_ALL:
+            if (!StateManager::canHome()) {
+                finish(command, COMMAND_REJECTED, "Cannot home motors in current state");
+                return;
+            }
+            runHoming(command);
+            return;
+
+        case MOTION_COMMAND_RUN_TIDE:
+            if (!TideDataManager::isDataValid()) {
+                finish(command, COMMAND_REJECTED, "No valid tide data - fetch data first");
+                return;
+            }
+            if (state != STATE_READY) {
+                finish(command, COMMAND_REJECTED, "System not ready - wait for the current operation to finish");
+                return;
+            }
+            runTide(command);
+            return;
+
+        case MOTION_COMMAND_CLEAR_STOP:
+            if (state != STATE_EMERGENCY_STOP && !MotorController::isEmergencyStopped()) {
+                finish(command, COMMAND_REJECTED, "Emergency stop not active");
+                return;
+            }
+            MotorController::clearEmergencyStop();
+            StateManager::clearEmergencyStop();
+            finish(command, COMMAND_DONE, "Emergency stop cleared");
+            return;
+
+        case MOTION_COMMAND_SUBMIT_JOB:
+            // Jobs may queue behind a running job, otherwise the system must be idle
+            if (!StateManager::canTest() && !MotionJobQueue::isBusy()) {
+                MotionJobQueue::discardStaged(command.value);
+                finish(command, COMMAND_REJECTED, "Cannot test motors in current state");
+                return;
+            }
+            if (MotionJobQueue::submitStaged(command.value) == 0) {
+                finish(command, COMMAND_REJECTED, "Motion job queue full");
+                return;
+            }
+            finish(command, COMMAND_DONE, "Motion job queued");
+            return;
+
+        case MOTION_COMMAND_CANCEL_JOB:
+            if (!MotionJobQueue::cancel(command.value)) {
+                finish(command, COMMAND_REJECTED, "No queued or running job with that ID");
+                return;
+            }
+            finish(command, COMMAND_DONE, "Motion job cancelled");
+            return;
+
+        case MOTION_COMMAND_LED_TEST:
+            LEDController::runTestPattern();
+            finish(command, COMMAND_DONE, "Test pattern activated");
+            return;
+
+        // The model is fitted and saved on this task at the end of homing
+        case MOTION_COMMAND_RESET_SPEEDS:
+            if (state == STATE_HOMING) {
+                finish(command, COMMAND_REJECTED, "Cannot reset speeds while homing");
+                return;
+            }
+            if (!MotorSpeedModel::reset()) {
+                finish(command, COMMAND_FAILED, "Failed to save speed model");
+                return;
+            }
+            finish(command, COMMAND_DONE, "Motor speed model reset to nominal");
+            return;
+
+        case MOTION_COMMAND_APPLY_CONFIG: {
+            // getMotorRunTime() and the planners read the config on this task
+            ConfigUpdate update;
+            if (!ConfigManager::takeUpdate(command.value, update)) {
+                finish(command, COMMAND_REJECTED, "No staged configuration change");
+                return;
+            }
+            if (command.flag && !StateManager::canChangeConfig()) {
+                finish(command, COMMAND_REJECTED, "Cannot change config in current state");
+                return;
+            }
+            if (!applyConfig(update)) {
+                finish(command, COMMAND_FAILED, "Failed to save configuration to EEPROM");
+                return;
+            }
+            finish(command, COMMAND_DONE, "Configuration saved");
+            return;
+        }
+
+        default:
+            finish(command, COMMAND_REJECTED, "Unknown motion command");
+            return;
+    }
+}
+
+bool MotionCommandQueue::applyConfig(const ConfigUpdate& update) {
+    const TideClockConfig& config = ConfigManager::getConfig();
+    uint8_t oldPin = config.ledPin;
+    uint16_t oldCount = config.ledCount;
+
+    ConfigManager::applyUpdate(update);
+
+    // The LED strip takes the values the setters accepted
+    if (update.fields & CONFIG_UPDATE_LED_ENABLED) {
+        LEDController::setEnabled(config.ledEnabled);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_MODE) {
+        LEDController::setMode(config.ledMode);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_BRIGHTNESS) {
+        LEDController::setBrightness(config.ledBrightness);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_COLOR) {
+        LEDController::setColorIndex(config.ledColorIndex);
+    }
+    if (update.fields & CONFIG_UPDATE_LED_HOURS) {
+        LEDController::setActiveHours(config.ledStartHour, config.ledEndHour);
+    }
+    if (config.ledPin != oldPin || config.ledCount != oldCount) {
+        if (!LEDController::reinit(config.ledPin, config.ledCount)) {
+            Logger::error(CAT_SYSTEM, "Failed to reinitialize LED controller");
+        }
+    }
+
+    return ConfigManager::save();
+}
+
+void MotionCommandQueue::finish(const MotionCommand& command, MotionCommandState state,
+                                const char* message) {
+    if (state == COMMAND_DROPPED) {
+        stats.dropped++;
+    } else {
+        stats.executed++;
+        if (state == COMMAND_REJECTED) {
+            stats.rejected++;
+            Logger::logf(LOG_WARNING, CAT_SYSTEM, "Command %lu (%s) rejected: %s",
+                         (unsigned long)command.id, getTypeName(command.type), message);
+        }
+    }
+
+    setStatus(command.id, command.type, state, message);
+}
+
+void MotionCommandQueue::setStatus(uint32_t id, MotionCommandType type, MotionCommandState state,
+                                   const char* message) {
+    // Readers match on ID, so it is written last
+    MotionCommandStatus& entry = history[id % MOTION_COMMAND_HISTORY];
+    entry.type = type;
+    entry.state = state;
+    entry.message = message;
+    entry.id = id;
+}
+
+void MotionCommandQueue::runHoming(const MotionCommand& command) {
+    beginOperation(command);
+    setStatus(command.id, command.type, COMMAND_RUNNING, "Homing in progress");
+    StateManager::setState(STATE_HOMING);
+
+    bool success;
+    if (command.type == MOTION_COMMAND_HOME) {
+        HomingResult result = MotorController::homeSingleMotor(command.motor);
+        Logger::logf(LOG_INFO, CAT_SYSTEM, "Homing result: %s",
+                     MotorController::getHomingResultString(result));
+        lastOperation.motorsHomed = (result == HOMING_SUCCESS) ? 1 : 0;
+        success = (result == HOMING_SUCCESS);
+    } else {
+        uint8_t homedCount;
+        if (command.value > 0) {
+            homedCount = MotorController::homeAllMotorsConcurrent(command.value);
+        } else {
+            homedCount = MotorController::homeAllMotors();
+        }
+        Logger::logf(LOG_INFO, CAT_SYSTEM,
+                     "Homing complete: %d/%d motors homed", homedCount, NUM_MOTORS);
+        lastOperation.motorsHomed = homedCount;
+        success = (homedCount == NUM_MOTORS);
+    }
+
+    // An emergency stop during homing keeps its own state
+    if (StateManager::getState() == STATE_HOMING) {
+        StateManager::setState(STATE_READY);
+    }
+
+    endOperation(success);
+    finish(command, success ? COMMAND_DONE : COMMAND_FAILED,
+           success ? "Homing complete" : "Homing failed - check logs for details");
+}
+
+void MotionCommandQueue::runTide(const MotionCommand& command) {
+    bool dryRun = command.flag;
+
+    beginOperation(command);
+    setStatus(command.id, command.type, COMMAND_RUNNING, "Tide sequence in progress");
+    if (!dryRun) {
+        StateManager::setState(STATE_RUNNING_TIDE);
+    }
+
+    TideDataset* dataset = TideDataManager::getMutableDataset();
+    bool success;
+    if (command.value > 0) {
+        success = MotorController::runTideSequencePlanned(dataset, command.value, dryRun);
+    } else {
+        success = MotorController::runTideSequence(dataset, dryRun);
+    }
+
+    if (!dryRun && StateManager::getState() == STATE_RUNNING_TIDE) {
+        StateManager::setState(STATE_READY);
+    }
+
+    endOperation(success);
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Tide sequence %s%s",
+                 success ? "completed" : "failed", dryRun ? " (dry run)" : "");
+    finish(command, success ? COMMAND_DONE : COMMAND_FAILED,
+           success ? "Tide sequence completed" : "Tide sequence failed - check logs for details");
+}
+
+void MotionCommandQueue::beginOperation(const MotionCommand& command) {
+#ifdef TIDECLOCK_SIM
+    // The simulated plant follows the Clock, so the whole operation can run on virtual time
+    if (PlantSimulator::isFastForward()) {
+        Clock::useVirtualTime();
+    }
+#endif
+
+    lastOperation.type = command.type;
+    lastOperation.running = true;
+    lastOperation.success = false;
+    lastOperation.dryRun = (command.type == MOTION_COMMAND_RUN_TIDE) && command.flag;
+    lastOperation.maxConcurrent = (command.type == MOTION_COMMAND_HOME) ? 0 : command.value;
+    lastOperation.motorsHomed = 0;
+    lastOperation.startedAt = Clock::nowMillis();
+}
+
+void MotionCommandQueue::endOperation(bool success) {
+    lastOperation.success = success;
+    lastOperation.finishedAt = Clock::nowMillis();
+    lastOperation.running = false;
+
+    if (Clock::isVirtual()) {
+        Clock::useHardwareTime();
+        Logger::logf(LOG_INFO, CAT_SYSTEM, "Fast-forward: %lu ms of virtual time",
+                     (unsigned long)(lastOperation.finishedAt - lastOperation.startedAt));
+    }
+}
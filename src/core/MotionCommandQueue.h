@@ -0,0 +1,176 @@
+/**
+ * TideClock Motion Command Queue
+ *
+ * Single entry point for motor commands. The web server and the serial
+ * console post typed commands (move, home, stop, run tide, ...) into one
+ * lock-free bounded queue. The motion task drains it, one command at a
+ * time, and is the only code that checks and changes the motion states
+ * of StateManager. Posting a command is a queue push; the outcome is kept
+ * in a short history that the caller can query by command ID.
+ *
+ * Emergency stops take a priority lane. post() halts the outputs at once
+ * through EmergencyStop, and the motion task handles the lane before any
+ * normal command. Normal commands still queued at that point are dropped
+ * rather than started after the stop.
+ */
+
+#ifndef MOTION_COMMAND_QUEUE_H
+#define MOTION_COMMAND_QUEUE_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "ConfigManager.h"
+#include "../hardware/MotorController.h"
+#include "../utils/BoundedQueue.h"
+
+/**
+ * Commands the motion task understands
+ */
+enum MotionCommandType {
+    MOTION_COMMAND_MOVE,        // Timed move (motor, direction, value = duration ms)
+    MOTION_COMMAND_MOVE_TO,     // Move to a position (motor, value = ms of travel from home)
+    MOTION_COMMAND_STOP,        // Cancel one motor's move (motor)
+    MOTION_COMMAND_HOME,        // Home one motor (motor)
+    MOTION_COMMAND_HOME_ALL,    // Home all motors (value = max concurrent, 0 = sequential)
+    MOTION_COMMAND_RUN_TIDE,    // Run the tide sequence (value = max concurrent, flag = dry run)
+    MOTION_COMMAND_CLEAR_STOP,  // Clear a latched emergency stop
+    MOTION_COMMAND_SUBMIT_JOB,  // Queue a staged motion job (value = staging slot)
+    MOTION_COMMAND_CANCEL_JOB,  // Cancel a motion job (value = job ID)
+    MOTION_COMMAND_LED_TEST,    // Start the LED test pattern
+    MOTION_COMMAND_RESET_SPEEDS, // Reset the motor speed model to nominal and save it
+    MOTION_COMMAND_APPLY_CONFIG, // Apply and save a staged config change (value = staging slot,
+                                 // flag = only when StateManager::canChangeConfig())
+    MOTION_COMMAND_ESTOP,       // Emergency stop (priority lane)
+    MOTION_COMMAND_TYPE_COUNT
+};
+
+/**
+ * Where a command came from
+ */
+enum MotionCommandSource {
+    COMMAND_SOURCE_WEB,
+    COMMAND_SOURCE_SERIAL,
+    COMMAND_SOURCE_COUNT
+};
+
+/**
+ * Lifecycle of a posted command
+ */
+enum MotionCommandState {
+    COMMAND_UNKNOWN,            // ID not in the history
+    COMMAND_QUEUED,             // Waiting for the motion task
+    COMMAND_RUNNING,            // Long operation in progress (homing, tide sequence)
+    COMMAND_DONE,               // Executed
+    COMMAND_FAILED,             // Executed but did not succeed (homing or tide sequence)
+    COMMAND_REJECTED,           // Refused (state or arguments)
+    COMMAND_DROPPED             // Discarded by an emergency stop before it ran
+};
+
+/**
+ * One queued command
+ */
+struct MotionCommand {
+    uint32_t id;                // Assigned by post()
+    MotionCommandType type;
+    MotionCommandSource source;
+    uint8_t motor;
+    MotorDirection direction;
+    uint32_t value;
+    bool flag;
+};
+
+/**
+ * Outcome of a recent command
+ */
+struct MotionCommandStatus {
+    uint32_t id;
+    MotionCommandType type;
+    MotionCommandState state;
+    const char* message;        // Static string
+};
+
+/**
+ * Latest long-running operation (homing or tide sequence)
+ */
+struct MotionOperation {
+    MotionCommandType type;
+    bool running;
+    bool success;
+    bool dryRun;
+    uint8_t maxConcurrent;      // 0 = sequential
+    uint8_t motorsHomed;        // Homing only
+    uint64_t startedAt;         // Clock::nowMillis() when it started (0 = none yet)
+    uint64_t finishedAt;        // Clock::nowMillis() when it finished
+};
+
+/**
+ * Command queue statistics
+ */
+struct MotionCommandStats {
+    uint32_t posted;            // Commands accepted into a lane
+    uint32_t executed;          // Commands the motion task has handled (any outcome)
+    uint32_t rejected;          // Refused by the motion task
+    uint32_t queueFull;         // Refused because the lane was full
+    uint32_t dropped;           // Discarded by an emergency stop
+    uint32_t maxDepth;          // Deepest the normal lane has been
+};
+
+class MotionCommandQueue {
+public:
+    /**
+     * Post a command (any task; never blocks)
+     * An emergency stop also halts the outputs before returning.
+     * @param command Command to post (id is assigned here)
+     * @return Command ID, or 0 if the lane was full
+     */
+    static uint32_t post(MotionCommand command);
+
+    /**
+     * Execute queued commands, priority lane first (motion task only)
+     */
+    static void drain();
+
+    /**
+     * Get the outcome of a recent command
+     * @return false if the ID has left the history
+     */
+    static bool getStatus(uint32_t id, MotionCommandStatus& status);
+
+    /**
+     * Latest homing or tide sequence
+     */
+    static const MotionOperation& getLastOperation();
+
+    /**
+     * Queue statistics
+     */
+    static MotionCommandStats getStats();
+
+    /**
+     * Names for logging and JSON
+     */
+    static const char* getTypeName(MotionCommandType type);
+    static const char* getStateName(MotionCommandState state);
+
+private:
+    static BoundedQueue<MotionCommand, MOTION_COMMAND_QUEUE_LENGTH> normalLane;
+    static BoundedQueue<MotionCommand, MOTION_COMMAND_PRIORITY_LENGTH> priorityLane;
+    static MotionCommandStatus history[MOTION_COMMAND_HISTORY];
+    static MotionCommandStats stats;          // Consumer-side counters
+    static MotionOperation lastOperation;
+    static std::atomic<uint32_t> nextId;
+    static std::atomic<uint32_t> postedCount;     // Producer-side counters
+    static std::atomic<uint32_t> queueFullCount;
+
+    static void execute(const MotionCommand& command);
+    static void finish(const MotionCommand& command, MotionCommandState state, const char* message);
+    static void setStatus(uint32_t id, MotionCommandType type, MotionCommandState state,
+                          const char* message);
+    static void runHoming(const MotionCommand& command);
+    static void runTide(const MotionCommand& command);
+    static bool applyConfig(const ConfigUpdate& update);
+    static void beginOperation(const MotionCommand& command);
+    static void endOperation(bool success);
+};
+
+#endif // MOTION_COMMAND_QUEUE_H
@@ -0,0 +1,193 @@
+/**
+ * TideClock Re-home Scheduler Implementation
+ */
+
+#include "RehomeScheduler.h"
+#include "StateManager.h"
+#include "../hardware/MotionExecutor.h"
+#include "../utils/Clock.h"
+#include "../utils/Logger.h"
+
+// Static member initialization
+DriftBudget RehomeScheduler::budgets[NUM_MOTORS];
+bool RehomeScheduler::enabled = REHOME_ENABLED;
+uint64_t RehomeScheduler::idleSince = 0;
+
+void RehomeScheduler::begin() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        resetMotor(i);
+    }
+    idleSince = Clock::nowMillis();
+
+    Logger::logf(LOG_INFO, CAT_HOMING, "Re-home scheduler %s (budget: %lu ms, %d reversals, %d moves)",
+                 enabled ? "enabled" : "disabled", (unsigned long)DRIFT_TRAVEL_BUDGET_MS,
+                 DRIFT_REVERSAL_BUDGET, DRIFT_MOVE_BUDGET);
+}
+
+void RehomeScheduler::service() {
+    uint64_t now = Clock::nowMillis();
+
+    // Any activity restarts the idle timer
+    if (!enabled || StateManager::getState() != STATE_READY ||
+        MotorController::isEmergencyStopped() || !MotionExecutor::isIdle()) {
+        idleSince = now;
+        return;
+    }
+
+    if (now - idleSince < REHOME_IDLE_DELAY_MS) {
+        return;
+    }
+
+    uint32_t mask = selectMotors(REHOME_BATCH_SIZE);
+    if (mask != 0) {
+        rehome(mask);
+    }
+
+    // Each batch waits for a fresh idle period
+    idleSince = Clock::nowMillis();
+}
+
+void RehomeScheduler::recordMove(uint8_t motorIndex, MotorDirection direction, uint32_t travelMs) {
+    if (motorIndex >= NUM_MOTORS || direction == MOTOR_STOP) {
+        return;
+    }
+
+    DriftBudget& budget = budgets[motorIndex];
+
+    budget.travelMs += travelMs;
+    if (budget.moves < 0xFFFF) {
+        budget.moves++;
+    }
+    if (budget.lastDirection != MOTOR_STOP && budget.lastDirection != direction &&
+        budget.reversals < 0xFFFF) {
+        budget.reversals++;
+    }
+    budget.lastDirection = direction;
+}
+
+void RehomeScheduler::resetMotor(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return;
+    }
+
+    budgets[motorIndex].travelMs = 0;
+    budgets[motorIndex].reversals = 0;
+    budgets[motorIndex].moves = 0;
+    budgets[motorIndex].lastDirection = MOTOR_STOP;
+}
+
+const DriftBudget& RehomeScheduler::getBudget(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        motorIndex = 0;
+    }
+    return budgets[motorIndex];
+}
+
+uint16_t RehomeScheduler::getBudgetUsage(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return 0;
+    }
+
+    const DriftBudget& budget = budgets[motorIndex];
+    uint32_t travel = (uint64_t)budget.travelMs * 1000 / DRIFT_TRAVEL_BUDGET_MS;
+    uint32_t reversals = (uint32_t)budget.reversals * 1000 / DRIFT_REVERSAL_BUDGET;
+    uint32_t moves = (uint32_t)budget.moves * 1000 / DRIFT_MOVE_BUDGET;
+
+    uint32_t usage = travel;
+    if (reversals > usage) usage = reversals;
+    if (moves > usage) usage = moves;
+
+    return (usage > 0xFFFF) ? 0xFFFF : usage;
+}
+
+void RehomeScheduler::setEnabled(bool enable) {
+    enabled = enable;
+    idleSince = Clock::nowMillis();
+    Logger::logf(LOG_INFO, CAT_HOMING, "Automatic re-homing %s", enabled ? "enabled" : "disabled");
+}
+
+bool RehomeScheduler::isEnabled() {
+    return enabled;
+}
+
+uint32_t RehomeScheduler::selectMotors(uint8_t maxMotors) {
+    uint32_t mask = 0;
+
+    for (uint8_t n = 0; n < maxMotors; n++) {
+        uint8_t worst = NUM_MOTORS;
+        uint16_t worstUsage = 0;
+
+        // Only motors with a position estimate can be put back afterwards
+        for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+            if ((mask & (1UL << i)) || !MotorController::isPositionKnown(i)) {
+                continue;
+            }
+
+            uint16_t usage = getBudgetUsage(i);
+            if (usage >= 1000 && usage > worstUsage) {
+                worst = i;
+                worstUsage = usage;
+            }
+        }
+
+        if (worst == NUM_MOTORS) {
+            break;
+        }
+        mask |= (1UL << worst);
+    }
+
+    return mask;
+}
+
+void RehomeScheduler::rehome(uint32_t motorMask) {
+    int32_t targets[NUM_MOTORS];
+    HomingResult results[NUM_MOTORS];
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        targets[i] = MotorController::getPosition(i);
+    }
+
+    Logger::logf(LOG_INFO, CAT_HOMING, "Drift budget: re-homing motors 0x%06lX",
+                 (unsigned long)motorMask);
+
+    StateManager::setState(STATE_HOMING);
+    uint8_t maxConcurrent = (REHOME_BATCH_SIZE < HOMING_MAX_CONCURRENT) ? REHOME_BATCH_SIZE
+                                                                        : HOMING_MAX_CONCURRENT;
+    MotorController::homeMotorsConcurrent(motorMask, maxConcurrent, results);
+
+    // An emergency stop during homing keeps its own state
+    if (StateManager::getState() == STATE_HOMING) {
+        StateManager::setState(STATE_READY);
+    }
+
+    if (MotorController::isEmergencyStopped()) {
+        Logger::warning(CAT_HOMING, "Drift budget: emergency stop - motors left at home");
+        return;
+    }
+
+    // Put each homed motor back where it was displaying
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (!(motorMask & (1UL << i))) {
+            continue;
+        }
+
+        if (results[i] != HOMING_SUCCESS) {
+            Logger::logf(LOG_WARNING, CAT_HOMING, "Drift budget: motor %d re-home failed (%s)",
+                         i, MotorController::getHomingResultString(results[i]));
+            continue;
+        }
+
+        MotorController::moveToPosition(i, targets[i] > 0xFFFF ? 0xFFFF : targets[i]);
+    }
+}
+
+void RehomeScheduler::printBudgets() {
+    Logger::logf(LOG_INFO, CAT_HOMING, "Drift budgets (re-homing %s):", enabled ? "enabled" : "disabled");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        const DriftBudget& budget = budgets[i];
+        Logger::logf(LOG_INFO, CAT_HOMING, "  Motor %02d: %6lu ms  %3u rev  %3u moves  %3u%%%s",
+                     i, (unsigned long)budget.travelMs, budget.reversals, budget.moves,
+                     getBudgetUsage(i) / 10,
+                     MotorController::isPositionKnown(i) ? "" : "  (not homed)");
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * TideClock Re-home Scheduler
+ *
+ * Tracks the open-loop drift budget of each motor since its last
+ * successful home (travel, direction reversals, move count) and re-homes
+ * only the motors that have used up their budget. Re-homes run a small
+ * batch at a time during idle periods, and each motor is returned to its
+ * previous position afterwards.
+ */
+
+#ifndef REHOME_SCHEDULER_H
+#define REHOME_SCHEDULER_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../hardware/MotorController.h"
+
+/**
+ * Open-loop error accumulated by one motor since it was last homed
+ */
+struct DriftBudget {
+    uint32_t travelMs;          // Travel since home (ms at nominal speed)
+    uint16_t reversals;         // Direction changes since home
+    uint16_t moves;             // Moves since home
+    MotorDirection lastDirection; // Direction of the most recent move
+};
+
+class RehomeScheduler {
+public:
+    /**
+     * Initialize scheduler with all budgets cleared
+     */
+    static void begin();
+
+    /**
+     * Check for idle time and re-home over-budget motors (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Charge a move against a motor's budget
+     * @param travelMs Distance moved (ms at nominal speed)
+     */
+    static void recordMove(uint8_t motorIndex, MotorDirection direction, uint32_t travelMs);
+
+    /**
+     * Clear a motor's budget (called when it homes successfully)
+     */
+    static void resetMotor(uint8_t motorIndex);
+
+    /**
+     * Get a motor's budget
+     */
+    static const DriftBudget& getBudget(uint8_t motorIndex);
+
+    /**
+     * Fraction of budget used on the worst axis, in permille (1000 = due)
+     */
+    static uint16_t getBudgetUsage(uint8_t motorIndex);
+
+    /**
+     * Enable or disable automatic re-homing
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Print budgets for all motors
+     */
+    static void printBudgets();
+
+private:
+    static DriftBudget budgets[NUM_MOTORS];
+    static bool enabled;
+    static uint64_t idleSince;
+
+    /**
+     * Pick up to maxMotors over-budget motors, most used first
+     * @return Bit mask of motors to re-home
+     */
+    static uint32_t selectMotors(uint8_t maxMotors);
+
+    /**
+     * Home the motors in the mask and return them to their positions
+     */
+    static void rehome(uint32_t motorMask);
+};
+
+#endif // REHOME_SCHEDULER_H
@@ -0,0 +1,260 @@
+/**
+ * TideClock Rolling Display Window Implementation
+ */
+
+#include "RollingWindow.h"
+#include "ConfigManager.h"
+#include "ContinuousTracker.h"
+#include "StateManager.h"
+#include "../hardware/MotorController.h"
+#include "../hardware/MotionExecutor.h"
+#include "../hardware/MotionJobQueue.h"
+#include "../hardware/TideSequencePlanner.h"
+#include "../network/NOAAClient.h"
+#include "../network/TimeManager.h"
+#include "../utils/Logger.h"
+#include "../utils/Clock.h"
+
+// Static member initialization
+std::atomic<bool> RollingWindow::enabled(ROLLING_WINDOW_ENABLED);
+std::atomic<bool> RollingWindow::shiftRequested(false);
+std::atomic<bool> RollingWindow::fetchRequested(false);
+uint64_t RollingWindow::lastCheck = 0;
+uint64_t RollingWindow::lastFetchAttempt = 0;
+uint8_t RollingWindow::appliedStart = TIDE_WINDOW_INVALID;
+time_t RollingWindow::appliedFetchTime = 0;
+int32_t RollingWindow::appliedTargets[NUM_MOTORS];
+bool RollingWindow::coverageWarned = false;
+RollingShift RollingWindow::lastShift = {0, TIDE_WINDOW_INVALID, 0, 0, 0, 0};
+TideDataset RollingWindow::fetchBuffer;
+
+void RollingWindow::begin() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        appliedTargets[i] = -1;
+    }
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Tide display: %s window",
+                 enabled ? "rolling 24-hour" : "calendar day");
+}
+
+void RollingWindow::serviceFetch() {
+    if (!enabled || !TimeManager::isTimeSynced()) {
+        return;
+    }
+
+    // Data from today covers every window until midnight (read through a
+    // copy - the motion task may be replacing the current data)
+    TideDataManager::copyDataset(fetchBuffer);
+    uint8_t index = TideDataManager::getCurrentHourIndex(&fetchBuffer);
+    bool valid = fetchBuffer.isValid && fetchBuffer.recordCount == TIDE_DATASET_HOURS;
+    if (valid && index != TIDE_WINDOW_INVALID && index < 24) {
+        return;
+    }
+
+    uint64_t now = Clock::nowMillis();
+    bool requested = fetchRequested.exchange(false);
+    if (!requested && lastFetchAttempt != 0 && now - lastFetchAttempt < ROLLING_FETCH_RETRY_MS) {
+        return;
+    }
+    lastFetchAttempt = now;
+
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
+    if (strlen(config.stationID) == 0) {
+        Logger::warning(CAT_SYSTEM, "Rolling window: NOAA station ID not configured");
+        return;
+    }
+
+    Logger::info(CAT_SYSTEM, "Rolling window: refreshing tide data for today");
+    NOAAClient::FetchResult result = NOAAClient::fetchTidePredictions(config.stationID, &fetchBuffer);
+    if (result != NOAAClient::SUCCESS) {
+        const char* errorMsg = NOAAClient::getErrorMessage(result);
+        TideDataManager::setError(errorMsg);
+        Logger::logf(LOG_WARNING, CAT_SYSTEM, "Rolling window: refresh failed - retry in %lu s",
+                     (unsigned long)(ROLLING_FETCH_RETRY_MS / 1000));
+        return;
+    }
+
+    // Applied by the motion task once no sequence is using the current data
+    TideDataManager::setData(&fetchBuffer);
+}
+
+void RollingWindow::service() {
+    // Continuous tracking moves every motor itself, using the same window
+    if (!enabled || ContinuousTracker::isEnabled()) {
+        return;
+    }
+
+    uint64_t now = Clock::nowMillis();
+    if (!shiftRequested && now - lastCheck < ROLLING_CHECK_INTERVAL_MS) {
+        return;
+    }
+    lastCheck = now;
+
+    if (!TimeManager::isTimeSynced() || !TideDataManager::isDataValid()) {
+        return;
+    }
+
+    const TideDataset* data = TideDataManager::getCurrentDataset();
+    uint8_t windowStart = getWindowStart(data);
+    if (windowStart == TIDE_WINDOW_INVALID) {
+        if (!coverageWarned) {
+            Logger::warning(CAT_MOTOR, "Rolling window: tide data does not cover the next 24 hours");
+            coverageWarned = true;
+        }
+        return;
+    }
+    coverageWarned = false;
+
+    if (!shiftRequested && windowStart == appliedStart && data->fetchTime == appliedFetchTime) {
+        return;
+    }
+
+    // Wait for a quiet moment; the check repeats every ROLLING_CHECK_INTERVAL_MS
+    if (StateManager::getState() != STATE_READY || MotorController::isEmergencyStopped() ||
+        !MotionExecutor::isIdle() || MotionJobQueue::isBusy()) {
+        return;
+    }
+
+    shift(data, windowStart, shiftRequested.exchange(false));
+}
+
+void RollingWindow::setEnabled(bool enable) {
+    enabled = enable;
+    if (enable) {
+        shiftRequested = true;
+        fetchRequested = true;
+    }
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Tide display: %s window",
+                 enable ? "rolling 24-hour" : "calendar day");
+}
+
+bool RollingWindow::isEnabled() {
+    return enabled;
+}
+
+uint8_t RollingWindow::getWindowStart(const TideDataset* data) {
+    if (!enabled) {
+        return 0;
+    }
+
+    uint8_t index = TideDataManager::getCurrentHourIndex(data);
+    if (index == TIDE_WINDOW_INVALID || index + NUM_MOTORS > TIDE_DATASET_HOURS) {
+        return TIDE_WINDOW_INVALID;
+    }
+    return index;
+}
+
+const RollingShift& RollingWindow::getLastShift() {
+    return lastShift;
+}
+
+void RollingWindow::shift(const TideDataset* data, uint8_t windowStart, bool full) {
+    int32_t newTargets[NUM_MOTORS];
+    bool partial[NUM_MOTORS] = {false};
+    uint8_t changed = 0;
+    uint8_t limited = 0;
+
+    TidePlan plan;
+    TideSequencePlanner::clearPlan(plan);
+
+    for (uint8_t motor = 0; motor < NUM_MOTORS; motor++) {
+        newTargets[motor] = TideDataManager::getMotorRunTime(data, windowStart + motor);
+
+        // Same target as last time: the motor is already showing it
+        if (!full && newTargets[motor] == appliedTargets[motor]) {
+            continue;
+        }
+        changed++;
+
+        // Delta from the estimated position, as in the tide sequence
+        MotorDirection direction;
+        uint16_t runTime;
+        MotorController::planMoveToPosition(motor, newTargets[motor], direction, runTime);
+
+        // Jobs refuse longer moves; the rest of the travel follows in the next shift
+        if (runTime > MAX_RUN_TIME_MS) {
+            runTime = MAX_RUN_TIME_MS;
+            partial[motor] = true;
+            limited++;
+        }
+        TideSequencePlanner::addMove(plan, motor, direction, runTime);
+    }
+
+    uint16_t jobId = 0;
+    uint8_t count = 0;
+    if (plan.moveCount > 0) {
+        TideSequencePlanner::buildPlan(plan, TIDE_MAX_CONCURRENT);
+
+        JobMove moves[NUM_MOTORS];
+        for (uint8_t i = 0; i < plan.moveCount; i++) {
+            // Moves planned to start later than a job allows wait for the next shift
+            if (plan.moves[i].startOffsetMs > MOTION_JOB_MAX_OFFSET_MS) {
+                if (!partial[plan.moves[i].motor]) {
+                    partial[plan.moves[i].motor] = true;
+                    limited++;
+                }
+                continue;
+            }
+            moves[count].motor = plan.moves[i].motor;
+            moves[count].direction = plan.moves[i].direction;
+            moves[count].durationMs = plan.moves[i].durationMs;
+            moves[count].offsetMs = plan.moves[i].startOffsetMs;
+            count++;
+        }
+
+        // Every move is within the job limits, so only a full queue refuses it
+        jobId = MotionJobQueue::submit(moves, count);
+        if (jobId == 0) {
+            // Keep the old targets so the next check tries again
+            Logger::warning(CAT_MOTOR, "Rolling window: could not queue shift moves");
+            shiftRequested = true;
+            return;
+        }
+    }
+
+    // A motor cut short has not reached its target yet
+    for (uint8_t motor = 0; motor < NUM_MOTORS; motor++) {
+        appliedTargets[motor] = partial[motor] ? -1 : newTargets[motor];
+    }
+    if (limited > 0) {
+        shiftRequested = true;
+    }
+    appliedStart = windowStart;
+    appliedFetchTime = data->fetchTime;
+
+    lastShift.at = Clock::nowMillis();
+    lastShift.windowStart = windowStart;
+    lastShift.changedCount = changed;
+    lastShift.moveCount = count;
+    lastShift.limitedCount = limited;
+    lastShift.jobId = jobId;
+
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Rolling window: motor 0 = %s, %u targets changed, %u moves (%u limited)%s",
+                 data->hours[windowStart].timestamp, changed, count, limited,
+                 jobId ? "" : " (none needed)");
+}
+
+void RollingWindow::printStatus() {
+    const TideDataset* data = TideDataManager::getCurrentDataset();
+
+    if (!enabled) {
+        Logger::info(CAT_SYSTEM, "Tide display: calendar day window (motor N = hour N)");
+        return;
+    }
+
+    uint8_t windowStart = getWindowStart(data);
+    if (!TideDataManager::isDataValid() || windowStart == TIDE_WINDOW_INVALID) {
+        Logger::info(CAT_SYSTEM, "Tide display: rolling 24-hour window - data does not cover it");
+        return;
+    }
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Tide display: rolling 24-hour window from %s",
+                 data->hours[windowStart].timestamp);
+    for (uint8_t motor = 0; motor < NUM_MOTORS; motor++) {
+        uint8_t index = windowStart + motor;
+        Logger::logf(LOG_INFO, CAT_SYSTEM, "  Motor %02d: %s  %.2f ft  %u ms",
+                     motor, data->hours[index].timestamp, data->hours[index].rawTideHeight,
+                     TideDataManager::getMotorRunTime(data, index));
+    }
+}
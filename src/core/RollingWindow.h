@@ -0,0 +1,99 @@
+/**
+ * TideClock Rolling Display Window
+ *
+ * Chooses which hour of the tide data each motor shows. In calendar mode
+ * (the default) motor N shows hour N of the day the data was fetched. In
+ * rolling mode motor 0 shows the current hour and motors 1-23 the next 23
+ * hours, using the two days held in the TideDataset.
+ *
+ * While rolling mode is on, each hour change moves only the motors whose
+ * target changed, each by its delta, as one motion job, instead of
+ * rerunning the whole sequence. A move longer than a job allows is cut to
+ * MAX_RUN_TIME_MS and the rest follows in another shift once the job is
+ * done. The network task refreshes the data once per day so the window
+ * stays covered.
+ */
+
+#ifndef ROLLING_WINDOW_H
+#define ROLLING_WINDOW_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../config.h"
+#include "../data/TideData.h"
+
+/**
+ * Outcome of the most recent shift
+ */
+struct RollingShift {
+    uint64_t at;                // Clock::nowMillis() of the shift (0 = none yet)
+    uint8_t windowStart;        // Index in hours[] shown by motor 0
+    uint8_t changedCount;       // Motors whose target changed
+    uint8_t moveCount;          // Moves submitted (changed motors not already in place)
+    uint8_t limitedCount;       // Moves cut to MAX_RUN_TIME_MS (finished by the next shift)
+    uint16_t jobId;             // Motion job running the moves (0 = none)
+};
+
+class RollingWindow {
+public:
+    /**
+     * Initialize with no targets applied
+     */
+    static void begin();
+
+    /**
+     * Refresh the tide data when it no longer starts today
+     * (call from the network task; blocks during the HTTP request)
+     */
+    static void serviceFetch();
+
+    /**
+     * Shift the display when the hour changes (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Switch between rolling and calendar mode (any task)
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Index in hours[] shown by motor 0
+     * @return 0 in calendar mode; the current hour's index in rolling mode,
+     *         or TIDE_WINDOW_INVALID if the data does not cover the window
+     */
+    static uint8_t getWindowStart(const TideDataset* data);
+
+    /**
+     * Get the outcome of the most recent shift
+     */
+    static const RollingShift& getLastShift();
+
+    /**
+     * Print mode, window and per-motor hours
+     */
+    static void printStatus();
+
+private:
+    static std::atomic<bool> enabled;
+    static std::atomic<bool> shiftRequested;
+    static std::atomic<bool> fetchRequested;
+
+    static uint64_t lastCheck;              // Motion task
+    static uint64_t lastFetchAttempt;       // Network task
+    static uint8_t appliedStart;            // Window of the last shift (TIDE_WINDOW_INVALID = none)
+    static time_t appliedFetchTime;         // Data of the last shift
+    static int32_t appliedTargets[NUM_MOTORS]; // Run time each motor was last sent to (-1 = none)
+    static bool coverageWarned;
+    static RollingShift lastShift;
+    static TideDataset fetchBuffer;
+
+    /**
+     * Move the motors whose target changed for a new window start
+     * @param full Check every motor against its target (after enabling or a failed shift)
+     */
+    static void shift(const TideDataset* data, uint8_t windowStart, bool full);
+};
+
+#endif // ROLLING_WINDOW_H
@@ -0,0 +1,181 @@
+/**
+ * TideClock Task Manager Implementation
+ */
+
+#include "TaskManager.h"
+#include "MotionCommandQueue.h"
+#include "ContinuousTracker.h"
+#include "RollingWindow.h"
+#include "RehomeScheduler.h"
+#include "../hardware/GPIOExpander.h"
+#include "../hardware/MotionExecutor.h"
+#include "../hardware/MotionJobQueue.h"
+#include "../hardware/EmergencyStop.h"
+#include "../hardware/MotorTelemetry.h"
+#include "../hardware/LEDController.h"
+#include "../network/WebServer.h"
+#include "../network/WiFiManager.h"
+#include "../data/TideData.h"
+#include "../utils/Clock.h"
+#include "../utils/Logger.h"
+
+// Static member initialization
+TaskHandle_t TaskManager::networkTask = nullptr;
+TaskHandle_t TaskManager::motionTask = nullptr;
+void (*TaskManager::consoleInput)() = nullptr;
+void (*TaskManager::console)() = nullptr;
+
+bool TaskManager::begin(void (*consoleReader)(), void (*consoleHandler)()) {
+    Logger::info(CAT_SYSTEM, "Starting network and motion tasks...");
+
+    consoleInput = consoleReader;
+    console = consoleHandler;
+
+    // Motion first, so commands posted by the first web pass have a consumer
+    if (xTaskCreatePinnedToCore(motionTaskMain, "motion", MOTION_TASK_STACK, nullptr,
+                                MOTION_TASK_PRIORITY, &motionTask, MOTION_TASK_CORE) != pdPASS) {
+        motionTask = nullptr;
+        Logger::error(CAT_SYSTEM, "Failed to start motion task - running from loop()");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(networkTaskMain, "network", NETWORK_TASK_STACK, nullptr,
+                                NETWORK_TASK_PRIORITY, &networkTask, NETWORK_TASK_CORE) != pdPASS) {
+        // The motion task keeps running; loop() takes over the network pass
+        networkTask = nullptr;
+        Logger::error(CAT_SYSTEM, "Failed to start network task - web server runs from loop()");
+        return false;
+    }
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Network task on core %d, motion task on core %d",
+                 NETWORK_TASK_CORE, MOTION_TASK_CORE);
+    return true;
+}
+
+bool TaskManager::isRunning() {
+    return networkTask != nullptr && motionTask != nullptr;
+}
+
+bool TaskManager::runFallbackPasses() {
+    if (isRunning()) {
+        return false;
+    }
+
+    if (networkTask == nullptr) {
+        runNetworkPass();
+    }
+    if (motionTask == nullptr) {
+        runMotionPass();
+    }
+    return true;
+}
+
+void TaskManager::runNetworkPass() {
+    // Handle web server requests
+    TideClockWebServer::handle();
+
+    // Handle WiFi events
+    WiFiManager::handle();
+
+    // Fetch 6-minute predictions for continuous tracking when due
+    ContinuousTracker::serviceFetch();
+
+    // Refresh hourly data once a day while the rolling window is shown
+    RollingWindow::serviceFetch();
+
+    // Read serial input (emergency stop posts from here)
+    if (consoleInput != nullptr) {
+        consoleInput();
+    }
+}
+
+void TaskManager::runMotionPass() {
+    // Finish any stop taken by the emergency stop task
+    EmergencyStop::service();
+
+    // Run serial commands read by the network task
+    if (console != nullptr) {
+        console();
+    }
+
+    // Take up tide data fetched by the network task (never mid-sequence)
+    TideDataManager::applyPending();
+
+    // Motor commands from the web server and serial console
+    MotionCommandQueue::drain();
+
+    // Stop motors whose timed moves have finished
+    MotionExecutor::tick();
+
+    // Start due moves of queued motion jobs
+    MotionJobQueue::service();
+
+    // Step motors toward the live tide when continuous tracking is due
+    ContinuousTracker::service();
+
+    // Shift the rolling window when the hour changes
+    RollingWindow::service();
+
+    // Update LED controller
+    LEDController::update();
+
+    // Re-home motors that have used up their drift budget while idle
+    RehomeScheduler::service();
+
+    // Persist changed motor telemetry counters
+    MotorTelemetry::service();
+
+    // Restore expander boards that reset or dropped off the bus
+    GPIOExpander::service();
+
+    // Push any expander writes still pending from this pass
+    GPIOExpander::flush();
+}
+
+void TaskManager::waitInOperation(uint32_t ms) {
+    uint64_t end = Clock::nowMillis() + ms;
+
+    for (;;) {
+        // The rest of the pass waits until the operation returns
+        EmergencyStop::service();
+        LEDController::update();
+
+        uint64_t now = Clock::nowMillis();
+        if (now >= end) {
+            return;
+        }
+        uint64_t slice = end - now;
+        Clock::delayMs(slice > MOTION_TASK_PERIOD_MS ? MOTION_TASK_PERIOD_MS : (uint32_t)slice);
+    }
+}
+
+// ============================================================================
+// TASKS
+// ============================================================================
+
+void TaskManager::networkTaskMain(void* arg) {
+    for (;;) {
+        runNetworkPass();
+        vTaskDelay(pdMS_TO_TICKS(NETWORK_TASK_PERIOD_MS));
+    }
+}
+
+void TaskManager::motionTaskMain(void* arg) {
+    const TickType_t period = pdMS_TO_TICKS(MOTION_TASK_PERIOD_MS);
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (;;) {
+        runMotionPass();
+
+        // vTaskDelayUntil only advances one period per call, so after a pass
+        // that overran (homing, tide sequence) resync to now instead of
+        // running the missed passes back to back
+        TickType_t now = xTaskGetTickCount();
+        if (now - lastWake >= period) {
+            lastWake = now;
+        }
+
+        // Fixed cadence between passes
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
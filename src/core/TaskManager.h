@@ -0,0 +1,86 @@
+/**
+ * TideClock Task Manager
+ *
+ * Runs the firmware as two pinned FreeRTOS tasks so network load never
+ * stalls motor timing:
+ *  - network task (core 0): web server, WiFi, prediction fetches and
+ *    serial console input, next to the WiFi stack
+ *  - motion task (core 1): emergency-stop follow-up, motor commands,
+ *    timed moves, motion jobs, continuous tracking, rolling-window
+ *    shifts, LEDs, re-homing, telemetry and serial command execution
+ *
+ * The console is read on the network task so an emergency stop typed
+ * while the motion task is blocked in homing or a sequence still posts
+ * at once; every other line is handed to the motion task to run.
+ *
+ * Homing and tide sequences still run to completion inside one motion
+ * pass; their wait loops call waitInOperation() so emergency stops and
+ * LED animation are serviced meanwhile.
+ *
+ * The tasks share no motion state. Web handlers post motor commands to
+ * MotionCommandQueue, which only the motion task drains. If a task cannot
+ * be created, loop() runs its pass instead.
+ */
+
+#ifndef TASK_MANAGER_H
+#define TASK_MANAGER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+
+class TaskManager {
+public:
+    /**
+     * Start the network and motion tasks
+     * Call at the end of setup(), after every module is initialized.
+     * @param consoleReader Called from every network pass to read serial input
+     * @param consoleHandler Called from every motion pass to run serial commands
+     * @return true if both tasks are running
+     */
+    static bool begin(void (*consoleReader)(), void (*consoleHandler)());
+
+    /**
+     * Check if both pinned tasks are running
+     */
+    static bool isRunning();
+
+    /**
+     * Run the pass of any task that failed to start (call from loop)
+     * @return false if both tasks are running and loop() has nothing to do
+     */
+    static bool runFallbackPasses();
+
+    /**
+     * One pass of the network task: web requests, WiFi housekeeping,
+     * background tide data fetches and serial console input
+     */
+    static void runNetworkPass();
+
+    /**
+     * One pass of the motion task: motor commands, timed moves, jobs,
+     * continuous tracking, rolling-window shifts, LEDs, re-homing,
+     * telemetry, serial commands and expander flush
+     */
+    static void runMotionPass();
+
+    /**
+     * Wait inside a long motion-task operation (homing, tide sequence)
+     * Finishes emergency stops and keeps the LEDs animating every motion
+     * period, as runMotionPass() would if the operation were not blocking it.
+     * @param ms Time to wait
+     */
+    static void waitInOperation(uint32_t ms);
+
+private:
+    static TaskHandle_t networkTask;
+    static TaskHandle_t motionTask;
+    static void (*consoleInput)();
+    static void (*console)();
+
+    static void networkTaskMain(void* arg);
+    static void motionTaskMain(void* arg);
+};
+
+#endif // TASK_MANAGER_H
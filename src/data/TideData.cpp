@@ -3,12 +3,18 @@
  */
 
 #include "TideData.h"
+#include "../core/ConfigManager.h"
 #include "../network/TimeManager.h"
 #include "../utils/Logger.h"
 #include <string.h>
 
 // Static member initialization
 TideDataset TideDataManager::currentData;
+TideDataset TideDataManager::pendingData;
+bool TideDataManager::pendingReady = false;
+portMUX_TYPE TideDataManager::pendingMux = portMUX_INITIALIZER_UNLOCKED;
+std::atomic<uint32_t> TideDataManager::dataSequence(0);
+char TideDataManager::lastError[128] = "";
 
 void TideDataManager::clear() {
     Logger::info(CAT_SYSTEM, "Clearing tide data");
@@ -20,10 +26,11 @@ void TideDataManager::clear() {
     currentData.stationID[0] = '\0';
     currentData.stationName[0] = '\0';
     currentData.errorMessage[0] = '\0';
+    lastError[0] = '\0';
 
     // Initialize all hourly data
-    for (uint8_t i = 0; i < 24; i++) {
-        currentData.hours[i].hour = i;
+    for (uint8_t i = 0; i < TIDE_DATASET_HOURS; i++) {
+        currentData.hours[i].hour = i % 24;
         currentData.hours[i].timestamp[0] = '\0';
         currentData.hours[i].rawTideHeight = 0.0;
         currentData.hours[i].scaledRunTime = 0;
@@ -32,7 +39,7 @@ void TideDataManager::clear() {
 }
 
 bool TideDataManager::isDataValid() {
-    return currentData.isValid && currentData.recordCount == 24;
+    return currentData.isValid && currentData.recordCount == TIDE_DATASET_HOURS;
 }
 
 bool TideDataManager::isDataStale(uint32_t maxAgeSeconds) {
@@ -44,11 +51,44 @@ bool TideDataManager::isDataStale(uint32_t maxAgeSeconds) {
     return ageSeconds > maxAgeSeconds;
 }
 
-HourlyTideData* TideDataManager::getHourData(uint8_t hour) {
-    if (hour >= 24 || !currentData.isValid) {
+HourlyTideData* TideDataManager::getHourData(uint8_t index) {
+    if (index >= TIDE_DATASET_HOURS || !currentData.isValid) {
         return nullptr;
     }
-    return &currentData.hours[hour];
+    return &currentData.hours[index];
+}
+
+uint8_t TideDataManager::getCurrentHourIndex(const TideDataset* data) {
+    if (data == nullptr || !data->isValid || data->startTime == 0) {
+        return TIDE_WINDOW_INVALID;
+    }
+
+    struct tm timeinfo;
+    TimeManager::getCurrentDateTime(&timeinfo);
+
+    // Whole days between the dataset's first midnight and today's (rounded - DST days are 23/25 h)
+    struct tm midnight = timeinfo;
+    midnight.tm_hour = 0;
+    midnight.tm_min = 0;
+    midnight.tm_sec = 0;
+    midnight.tm_isdst = -1;
+    long days = lround(difftime(mktime(&midnight), data->startTime) / 86400.0);
+
+    long index = days * 24 + timeinfo.tm_hour;
+    if (days < 0 || index >= TIDE_DATASET_HOURS) {
+        return TIDE_WINDOW_INVALID;
+    }
+    return (uint8_t)index;
+}
+
+uint16_t TideDataManager::getMotorRunTime(const TideDataset* data, uint8_t index) {
+    if (data == nullptr || index >= TIDE_DATASET_HOURS) {
+        return 0;
+    }
+
+    uint16_t maxRunTime = ConfigManager::getConfig().maxRunTime;
+    uint16_t target = data->hours[index].scaledRunTime;
+    return (target > maxRunTime) ? maxRunTime : target;
 }
 
 const TideDataset* TideDataManager::getCurrentDataset() {
@@ -65,12 +105,53 @@ void TideDataManager::setData(const TideDataset* newData) {
         return;
     }
 
-    // Copy data
-    memcpy(&currentData, newData, sizeof(TideDataset));
+    portENTER_CRITICAL(&pendingMux);
+    memcpy(&pendingData, newData, sizeof(TideDataset));
+    pendingReady = true;
+    portEXIT_CRITICAL(&pendingMux);
 
     Logger::logf(LOG_INFO, CAT_SYSTEM,
-                "Tide data updated: %u records from station %s",
-                currentData.recordCount, currentData.stationID);
+                "Tide data received: %u records from station %s",
+                newData->recordCount, newData->stationID);
+}
+
+bool TideDataManager::applyPending() {
+    if (!pendingReady) {
+        return false;
+    }
+
+    // Odd sequence while copying tells copyDataset() to retry
+    uint32_t sequence = dataSequence.load(std::memory_order_relaxed);
+    dataSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    portENTER_CRITICAL(&pendingMux);
+    memcpy(&currentData, &pendingData, sizeof(TideDataset));
+    pendingReady = false;
+    portEXIT_CRITICAL(&pendingMux);
+
+    dataSequence.store(sequence + 2, std::memory_order_release);
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Tide data updated: %u records from station %s",
+                 currentData.recordCount, currentData.stationID);
+    return true;
+}
+
+void TideDataManager::copyDataset(TideDataset& copy) {
+    for (;;) {
+        uint32_t sequence = dataSequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            yield();
+            continue;
+        }
+
+        memcpy(&copy, &currentData, sizeof(TideDataset));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (dataSequence.load(std::memory_order_relaxed) == sequence) {
+            return;
+        }
+    }
 }
 
 uint32_t TideDataManager::getDataAgeSeconds() {
@@ -96,17 +177,18 @@ String TideDataManager::getDataAgeString() {
 }
 
 void TideDataManager::setError(const char* errorMsg) {
+    // Kept apart from the dataset, which only the motion task writes
     if (errorMsg == nullptr) {
-        currentData.errorMessage[0] = '\0';
+        lastError[0] = '\0';
         return;
     }
 
-    strncpy(currentData.errorMessage, errorMsg, sizeof(currentData.errorMessage) - 1);
-    currentData.errorMessage[sizeof(currentData.errorMessage) - 1] = '\0';
+    strncpy(lastError, errorMsg, sizeof(lastError) - 1);
+    lastError[sizeof(lastError) - 1] = '\0';
 
     Logger::logf(LOG_ERROR, CAT_SYSTEM, "Tide data error: %s", errorMsg);
 }
 
 const char* TideDataManager::getLastError() {
-    return currentData.errorMessage;
+    return lastError;
 }
@@ -2,7 +2,8 @@
  * TideClock Tide Data Structures
  *
  * Data structures and manager for storing and managing
- * 24-hour tide predictions from NOAA.
+ * hourly tide predictions from NOAA (today and tomorrow, so a rolling
+ * 24-hour window can be shown at any hour).
  *
  * Phase 3: NOAA Integration
  */
@@ -12,6 +13,8 @@
 
 #include <Arduino.h>
 #include <time.h>
+#include <atomic>
+#include "../config.h"
 
 /**
  * Hourly tide data entry
@@ -21,27 +24,48 @@ struct HourlyTideData {
     uint8_t hour;                    // Hour of day (0-23)
     char timestamp[20];              // ISO format: "2025-11-01 14:00"
     float rawTideHeight;             // Tide height in feet (MLLW datum)
-    uint16_t scaledRunTime;          // Base motor run time (0-9000 ms)
-    uint16_t finalRunTime;           // After motor offset applied (0-9000 ms)
+    uint16_t scaledRunTime;          // Target position (ms of travel at nominal speed, 0-9000)
+    uint16_t finalRunTime;           // Target clamped to the configured max run time
 };
 
 /**
- * Complete 24-hour tide dataset
+ * Complete two-day tide dataset
  * Contains all hourly data plus metadata
  */
 struct TideDataset {
-    HourlyTideData hours[24];        // 24 hourly entries
+    HourlyTideData hours[TIDE_DATASET_HOURS]; // Hourly entries from local midnight (24+ = tomorrow)
     char stationID[10];              // NOAA station ID
     char stationName[64];            // Station name (from NOAA response)
     time_t fetchTime;                // Unix timestamp of fetch
+    time_t startTime;                // Unix time of hours[0] (local midnight of the first day)
     bool isValid;                    // Data validity flag
-    uint8_t recordCount;             // Number of valid records (should be 24)
+    uint8_t recordCount;             // Number of valid records (should be TIDE_DATASET_HOURS)
     char errorMessage[128];          // Last error message (if fetch failed)
 };
 
+/**
+ * 6-minute tide prediction series
+ * Used by continuous tracking to interpolate the level at any time
+ */
+struct TideSeries {
+    uint32_t times[TIDE_SERIES_MAX_SAMPLES];   // Unix time of each sample (ascending)
+    float heights[TIDE_SERIES_MAX_SAMPLES];    // Tide height in feet (MLLW datum)
+    uint16_t count;                  // Number of valid samples
+    char stationID[10];              // NOAA station ID
+    char date[9];                    // Local date of the first sample (YYYYMMDD)
+    time_t fetchTime;                // Unix timestamp of fetch
+    bool isValid;                    // Data validity flag
+};
+
 /**
  * Tide Data Manager
  * Manages in-memory storage and access to tide data
+ *
+ * The current dataset belongs to the motion task, which may hold a pointer
+ * to it for a whole tide sequence. Other tasks publish new data into a
+ * pending buffer; the motion task applies it at the start of a pass, so it
+ * never changes under a running sequence. Other tasks read the dataset
+ * through copyDataset(), which retries if it was replaced mid-copy.
  */
 class TideDataManager {
 public:
@@ -63,26 +87,52 @@ public:
 
     /**
      * Get data for specific hour
+     * index: Hours since the dataset's first midnight (0 - TIDE_DATASET_HOURS-1)
      * Returns nullptr if invalid hour or no data
      */
-    static HourlyTideData* getHourData(uint8_t hour);
+    static HourlyTideData* getHourData(uint8_t index);
+
+    /**
+     * Get the index in hours[] of the current hour
+     * Returns TIDE_WINDOW_INVALID if the data does not cover it
+     */
+    static uint8_t getCurrentHourIndex(const TideDataset* data);
 
     /**
-     * Get entire dataset (read-only access)
+     * Get the target position for showing one hour of data
+     * In ms of travel at nominal speed, the same for every motor;
+     * MotorSpeedModel turns it into each motor's run time.
+     */
+    static uint16_t getMotorRunTime(const TideDataset* data, uint8_t index);
+
+    /**
+     * Get entire dataset (read-only access; motion task)
      */
     static const TideDataset* getCurrentDataset();
 
     /**
-     * Get mutable dataset pointer (for updates)
+     * Get mutable dataset pointer (motion task only)
      */
     static TideDataset* getMutableDataset();
 
     /**
-     * Set new tide data
-     * Copies data into internal storage
+     * Publish new tide data (any task)
+     * Copied into the pending buffer; a later publish replaces it.
      */
     static void setData(const TideDataset* newData);
 
+    /**
+     * Make published data current (call from the motion task between operations)
+     * @return true if new data was applied
+     */
+    static bool applyPending();
+
+    /**
+     * Copy the current dataset from a task other than the motion task
+     * @param copy Receives the dataset (consistent even while it is being replaced)
+     */
+    static void copyDataset(TideDataset& copy);
+
     /**
      * Get age of current data in seconds
      * Returns 0 if no valid data
@@ -107,6 +157,11 @@ public:
 
 private:
     static TideDataset currentData;
+    static TideDataset pendingData;
+    static bool pendingReady;                   // Guarded by pendingMux
+    static portMUX_TYPE pendingMux;
+    static std::atomic<uint32_t> dataSequence;  // Odd while currentData is being replaced
+    static char lastError[128];
 };
 
 #endif // TIDE_DATA_H
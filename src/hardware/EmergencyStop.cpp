@@ -0,0 +1,152 @@
+/**
+ * Emergency Stop Implementation
+ */
+
+#include "EmergencyStop.h"
+#include "MotorController.h"
+#include "../core/StateManager.h"
+#include "../utils/Clock.h"
+#include "../utils/Logger.h"
+#include <esp_timer.h>
+
+// Static member initialization
+TaskHandle_t EmergencyStop::task = nullptr;
+portMUX_TYPE EmergencyStop::mux = portMUX_INITIALIZER_UNLOCKED;
+bool EmergencyStop::triggerPending = false;
+uint64_t EmergencyStop::triggerUs = 0;
+EStopSource EmergencyStop::pendingSource = ESTOP_SOURCE_SERIAL;
+volatile bool EmergencyStop::reportPending = false;
+EStopSource EmergencyStop::lastSource = ESTOP_SOURCE_SERIAL;
+uint32_t EmergencyStop::lastLatencyUs = 0;
+uint32_t EmergencyStop::stopCount = 0;
+LatencyHistogram EmergencyStop::latency;
+
+bool EmergencyStop::begin() {
+    Logger::info(CAT_SYSTEM, "Initializing emergency stop...");
+
+    if (task == nullptr &&
+        xTaskCreatePinnedToCore(taskMain, "estop", 3072, nullptr,
+                                ESTOP_TASK_PRIORITY, &task, ESTOP_TASK_CORE) != pdPASS) {
+        task = nullptr;
+        Logger::error(CAT_SYSTEM, "Failed to start emergency stop task - stops run inline");
+        return false;
+    }
+
+#if ESTOP_BUTTON_PIN >= 0
+    ::pinMode(ESTOP_BUTTON_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(ESTOP_BUTTON_PIN), onButton, FALLING);
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Emergency stop button on GPIO %d", ESTOP_BUTTON_PIN);
+#endif
+
+    return true;
+}
+
+void EmergencyStop::trigger(EStopSource source) {
+    portENTER_CRITICAL(&mux);
+    if (!triggerPending) {
+        triggerPending = true;
+        triggerUs = Clock::nowMicros();
+        pendingSource = source;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    if (task != nullptr) {
+        xTaskNotifyGive(task);
+    } else {
+        halt();
+    }
+}
+
+void IRAM_ATTR EmergencyStop::onButton() {
+    BaseType_t woken = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&mux);
+    if (!triggerPending) {
+        triggerPending = true;
+        triggerUs = (uint64_t)esp_timer_get_time();
+        pendingSource = ESTOP_SOURCE_BUTTON;
+    }
+    portEXIT_CRITICAL_ISR(&mux);
+
+    vTaskNotifyGiveFromISR(task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void EmergencyStop::taskMain(void* arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        halt();
+    }
+}
+
+void EmergencyStop::halt() {
+    MotorController::haltAllOutputs();
+    uint64_t doneUs = Clock::nowMicros();
+
+    uint64_t startUs;
+    EStopSource source;
+    portENTER_CRITICAL(&mux);
+    startUs = triggerUs;
+    source = pendingSource;
+    triggerPending = false;
+    portEXIT_CRITICAL(&mux);
+
+    lastLatencyUs = (doneUs > startUs) ? (uint32_t)(doneUs - startUs) : 0;
+    lastSource = source;
+    latency.record(lastLatencyUs);
+    stopCount++;
+    reportPending = true;
+}
+
+void EmergencyStop::service() {
+    if (!reportPending) {
+        return;
+    }
+    reportPending = false;
+
+    Logger::logf(LOG_WARNING, CAT_SYSTEM, "Emergency stop (%s): all motors off in %lu us",
+                 getSourceName(lastSource), (unsigned long)lastLatencyUs);
+
+    // Re-assert the stop and do the move bookkeeping the fast path skipped
+    MotorController::emergencyStopAll();
+
+    if (StateManager::getState() != STATE_EMERGENCY_STOP) {
+        StateManager::enterEmergencyStop();
+    }
+}
+
+const LatencyHistogram& EmergencyStop::getLatencyHistogram() {
+    return latency;
+}
+
+uint32_t EmergencyStop::getLastLatencyUs() {
+    return lastLatencyUs;
+}
+
+EStopSource EmergencyStop::getLastSource() {
+    return lastSource;
+}
+
+uint32_t EmergencyStop::getStopCount() {
+    return stopCount;
+}
+
+const char* EmergencyStop::getSourceName(EStopSource source) {
+    switch (source) {
+        case ESTOP_SOURCE_BUTTON: return "button";
+        case ESTOP_SOURCE_WEB:    return "web";
+        case ESTOP_SOURCE_SERIAL: return "serial";
+        default:                  return "unknown";
+    }
+}
+
+void EmergencyStop::printStats() {
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Emergency stop: %s, %lu stops since boot",
+                 task != nullptr ? "task" : "inline", (unsigned long)stopCount);
+
+    if (stopCount > 0) {
+        Logger::logf(LOG_INFO, CAT_SYSTEM, "  Last: %s, %lu us trigger to last write",
+                     getSourceName(lastSource), (unsigned long)lastLatencyUs);
+        latency.print(CAT_SYSTEM, "Trigger-to-stop latency");
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * Emergency Stop
+ *
+ * Low-latency stop path. A trigger (optional physical button interrupt,
+ * web or serial command) wakes a task at the highest priority, which
+ * latches the stop and writes all-zero images to the motor boards with
+ * no logging. Logging, move bookkeeping and the state change follow from
+ * service() on the motion task. Trigger-to-last-write latency is recorded in a
+ * histogram.
+ */
+
+#ifndef EMERGENCY_STOP_H
+#define EMERGENCY_STOP_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+#include "../utils/LatencyHistogram.h"
+
+// What triggered an emergency stop
+enum EStopSource {
+    ESTOP_SOURCE_BUTTON,    // Physical stop button (GPIO interrupt)
+    ESTOP_SOURCE_WEB,       // POST /api/emergency-stop
+    ESTOP_SOURCE_SERIAL,    // Serial S command
+    ESTOP_SOURCE_COUNT
+};
+
+class EmergencyStop {
+public:
+    /**
+     * Start the stop task and attach the button interrupt (if configured)
+     * Requires MotorController to be initialized first.
+     * @return true if the stop task is running
+     */
+    static bool begin();
+
+    /**
+     * Stop all motors now (any task; returns once the stop task has run
+     * when called from a lower-priority task on its core)
+     */
+    static void trigger(EStopSource source);
+
+    /**
+     * Log and finish a stop taken by the fast path (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Histogram of trigger-to-last-write latency
+     */
+    static const LatencyHistogram& getLatencyHistogram();
+
+    /**
+     * Latency of the most recent stop in microseconds
+     */
+    static uint32_t getLastLatencyUs();
+
+    /**
+     * Source of the most recent stop
+     */
+    static EStopSource getLastSource();
+
+    /**
+     * Number of stops taken since boot
+     */
+    static uint32_t getStopCount();
+
+    /**
+     * Name of a trigger source
+     */
+    static const char* getSourceName(EStopSource source);
+
+    /**
+     * Print stop count and latency histogram
+     */
+    static void printStats();
+
+private:
+    static TaskHandle_t task;
+    static portMUX_TYPE mux;
+    static bool triggerPending;
+    static uint64_t triggerUs;
+    static EStopSource pendingSource;
+    static volatile bool reportPending;
+    static EStopSource lastSource;
+    static uint32_t lastLatencyUs;
+    static uint32_t stopCount;
+    static LatencyHistogram latency;
+
+    /**
+     * Button ISR - record the time and wake the stop task
+     */
+    static void IRAM_ATTR onButton();
+
+    /**
+     * Stop task: waits for a trigger and runs halt()
+     */
+    static void taskMain(void* arg);
+
+    /**
+     * Write the stop and record its latency
+     */
+    static void halt();
+};
+
+#endif // EMERGENCY_STOP_H
@@ -3,6 +3,36 @@
  */
 
 #include "GPIOExpander.h"
+#include "I2CManager.h"
+#include "../utils/Clock.h"
+#include <Wire.h>
+
+#ifdef TIDECLOCK_SIM
+#include "../sim/PlantSimulator.h"
+#endif
+
+// MCP23017 register addresses (IOCON.BANK = 0, A/B registers interleaved)
+#define MCP_REG_IODIRA   0x00
+#define MCP_REG_GPINTENA 0x04
+#define MCP_REG_INTCONA  0x08
+#define MCP_REG_IOCON    0x0A
+#define MCP_REG_GPPUA    0x0C
+#define MCP_REG_INTFA    0x0E
+#define MCP_REG_GPIOA    0x12
+#define MCP_REG_OLATA    0x14
+
+#define MCP_CONFIG_BYTES 14     // IODIRA through GPPUB
+
+#define MCP_IOCON_MIRROR 0x40   // INTA/INTB both signal changes on either port
+
+#define PORT_A_BIT 0x01
+#define PORT_B_BIT 0x02
+#define PORT_BOTH  (PORT_A_BIT | PORT_B_BIT)
+
+// Wire error codes (see I2CManager::getErrorString)
+#define I2C_ERROR_NACK_ADDRESS 2
+#define I2C_ERROR_NACK_DATA    3
+#define I2C_ERROR_TIMEOUT      5
 
 // Static member initialization
 Adafruit_MCP23X17 GPIOExpander::motorBoard0;
@@ -11,75 +41,82 @@ Adafruit_MCP23X17 GPIOExpander::motorBoard2;
 Adafruit_MCP23X17 GPIOExpander::switchBoard0;
 Adafruit_MCP23X17 GPIOExpander::switchBoard1;
 bool GPIOExpander::initialized = false;
+ExpanderShadow GPIOExpander::shadows[NUM_EXPANDER_BOARDS];
+GPIOExpander::BusCounters GPIOExpander::busStats;
+ExpanderHealth GPIOExpander::health[NUM_EXPANDER_BOARDS];
+bool GPIOExpander::restoring = false;
+uint64_t GPIOExpander::lastHealthCheck = 0;
+uint64_t GPIOExpander::lastRestoreAttempt[NUM_EXPANDER_BOARDS] = {0};
+uint8_t GPIOExpander::nextHealthCheck = 0;
 
 bool GPIOExpander::begin() {
     Logger::info(CAT_I2C, "Initializing MCP23017 GPIO expanders...");
 
     bool success = true;
 
+    // Shadows start from the MCP23017 power-on defaults: all inputs, no pull-ups, latches low
+    for (uint8_t i = 0; i < NUM_EXPANDER_BOARDS; i++) {
+        shadows[i].olat = 0x0000;
+        shadows[i].iodir = 0xFFFF;
+        shadows[i].gppu = 0x0000;
+        shadows[i].gpinten = 0x0000;
+        shadows[i].iocon = 0x00;
+        shadows[i].dirtyOlat = 0;
+        shadows[i].dirtyIodir = 0;
+        shadows[i].dirtyGppu = 0;
+        health[i] = {0, 0, 0, 0, 0, false, false};
+    }
+
     // Initialize Motor Board 0 (0x20)
     Logger::debug(CAT_I2C, "Initializing Motor Board 0 (0x20)...");
-    if (!motorBoard0.begin_I2C(MCP_MOTOR_0)) {
+    if (!attachBoard(motorBoard0, MCP_MOTOR_0)) {
         Logger::error(CAT_I2C, "Failed to initialize Motor Board 0 at 0x20");
         success = false;
     } else {
-        // Configure all pins as outputs
-        for (uint8_t pin = 0; pin < 16; pin++) {
-            motorBoard0.pinMode(pin, OUTPUT);
-            motorBoard0.digitalWrite(pin, LOW);  // Start with motors off
-        }
+        // Configure all pins as outputs, starting with motors off
+        configureBoard(MCP_MOTOR_0, 0x0000, 0x0000);
         Logger::info(CAT_I2C, "Motor Board 0 initialized (Motors 0-7)");
     }
 
     // Initialize Motor Board 1 (0x21)
     Logger::debug(CAT_I2C, "Initializing Motor Board 1 (0x21)...");
-    if (!motorBoard1.begin_I2C(MCP_MOTOR_1)) {
+    if (!attachBoard(motorBoard1, MCP_MOTOR_1)) {
         Logger::error(CAT_I2C, "Failed to initialize Motor Board 1 at 0x21");
         success = false;
     } else {
-        for (uint8_t pin = 0; pin < 16; pin++) {
-            motorBoard1.pinMode(pin, OUTPUT);
-            motorBoard1.digitalWrite(pin, LOW);
-        }
+        configureBoard(MCP_MOTOR_1, 0x0000, 0x0000);
         Logger::info(CAT_I2C, "Motor Board 1 initialized (Motors 8-15)");
     }
 
     // Initialize Motor Board 2 (0x22)
     Logger::debug(CAT_I2C, "Initializing Motor Board 2 (0x22)...");
-    if (!motorBoard2.begin_I2C(MCP_MOTOR_2)) {
+    if (!attachBoard(motorBoard2, MCP_MOTOR_2)) {
         Logger::error(CAT_I2C, "Failed to initialize Motor Board 2 at 0x22");
         success = false;
     } else {
-        for (uint8_t pin = 0; pin < 16; pin++) {
-            motorBoard2.pinMode(pin, OUTPUT);
-            motorBoard2.digitalWrite(pin, LOW);
-        }
+        configureBoard(MCP_MOTOR_2, 0x0000, 0x0000);
         Logger::info(CAT_I2C, "Motor Board 2 initialized (Motors 16-23)");
     }
 
     // Initialize Switch Board 0 (0x23)
     Logger::debug(CAT_I2C, "Initializing Switch Board 0 (0x23)...");
-    if (!switchBoard0.begin_I2C(MCP_SWITCH_0)) {
+    if (!attachBoard(switchBoard0, MCP_SWITCH_0)) {
         Logger::error(CAT_I2C, "Failed to initialize Switch Board 0 at 0x23");
         success = false;
     } else {
         // Configure all pins as inputs with pull-ups
-        for (uint8_t pin = 0; pin < 16; pin++) {
-            switchBoard0.pinMode(pin, INPUT_PULLUP);
-        }
+        configureBoard(MCP_SWITCH_0, 0xFFFF, 0xFFFF);
         Logger::info(CAT_I2C, "Switch Board 0 initialized (Switches 0-15)");
     }
 
     // Initialize Switch Board 1 (0x24)
     Logger::debug(CAT_I2C, "Initializing Switch Board 1 (0x24)...");
-    if (!switchBoard1.begin_I2C(MCP_SWITCH_1)) {
+    if (!attachBoard(switchBoard1, MCP_SWITCH_1)) {
         Logger::error(CAT_I2C, "Failed to initialize Switch Board 1 at 0x24");
         success = false;
     } else {
-        // Only configure pins 0-7 (8 switches on this board) (I edited this like from 'pin < 8' to 'pin < 16' to initialize all pins)
-        for (uint8_t pin = 0; pin < 16; pin++) {
-            switchBoard1.pinMode(pin, INPUT_PULLUP);
-        }
+        // Configure all 16 pins as inputs with pull-ups
+        configureBoard(MCP_SWITCH_1, 0xFFFF, 0xFFFF);
         Logger::info(CAT_I2C, "Switch Board 1 initialized (Switches 16-23)");
     }
 
@@ -93,6 +130,14 @@ bool GPIOExpander::begin() {
     return success;
 }
 
+bool GPIOExpander::attachBoard(Adafruit_MCP23X17& board, uint8_t address) {
+#ifdef TIDECLOCK_SIM
+    return PlantSimulator::isPresent(address);
+#else
+    return board.begin_I2C(address);
+#endif
+}
+
 Adafruit_MCP23X17* GPIOExpander::getBoardByAddress(uint8_t address) {
     switch (address) {
         case MCP_MOTOR_0:  return &motorBoard0;
@@ -106,30 +151,45 @@ Adafruit_MCP23X17* GPIOExpander::getBoardByAddress(uint8_t address) {
     }
 }
 
+uint8_t GPIOExpander::getBoardIndex(uint8_t address) {
+    if (address < MCP_MOTOR_0 || address >= MCP_MOTOR_0 + NUM_EXPANDER_BOARDS) {
+        Logger::logf(LOG_ERROR, CAT_I2C, "Invalid MCP address: 0x%02X", address);
+        return 0xFF;
+    }
+    return address - MCP_MOTOR_0;
+}
+
 bool GPIOExpander::digitalWrite(uint8_t address, uint8_t pin, uint8_t value) {
     if (!initialized) {
         Logger::error(CAT_I2C, "GPIO expanders not initialized");
         return false;
     }
 
-    Adafruit_MCP23X17* board = getBoardByAddress(address);
-    if (board == nullptr) {
+    uint8_t index = getBoardIndex(address);
+    if (index == 0xFF || pin > 15) {
         return false;
     }
 
-    // Retry logic for I2C operations
-    for (uint8_t attempt = 0; attempt < I2C_RETRY_ATTEMPTS; attempt++) {
-        board->digitalWrite(pin, value);
+    // Unbuffered path: read OLAT + write GPIO
+    busStats.baselineTransactions += 2;
 
-        // The Adafruit library doesn't return error status, so we assume success
-        // unless we catch an exception or see bus issues
-        Logger::logf(LOG_VERBOSE, CAT_I2C, "Write: 0x%02X pin %d = %s",
-                     address, pin, value ? "HIGH" : "LOW");
+    ExpanderShadow& shadow = shadows[index];
+    uint16_t bit = 1U << pin;
+    uint16_t olat = value ? (shadow.olat | bit) : (shadow.olat & ~bit);
+
+    if (olat == shadow.olat) {
+        // Latch already holds this value (pending or written) - nothing to send
+        busStats.coalescedWrites++;
         return true;
     }
 
-    Logger::logf(LOG_ERROR, CAT_I2C, "Failed to write pin after %d attempts", I2C_RETRY_ATTEMPTS);
-    return false;
+    shadow.olat = olat;
+    shadow.dirtyOlat |= (pin < 8) ? PORT_A_BIT : PORT_B_BIT;
+
+    Logger::logf(LOG_VERBOSE, CAT_I2C, "Write: 0x%02X pin %d = %s",
+                 address, pin, value ? "HIGH" : "LOW");
+
+    return flushBoard(index);
 }
 
 bool GPIOExpander::digitalRead(uint8_t address, uint8_t pin, uint8_t& value) {
@@ -138,20 +198,20 @@ bool GPIOExpander::digitalRead(uint8_t address, uint8_t pin, uint8_t& value) {
         return false;
     }
 
-    Adafruit_MCP23X17* board = getBoardByAddress(address);
-    if (board == nullptr) {
+    if (getBoardIndex(address) == 0xFF || pin > 15) {
         return false;
     }
 
-    for (uint8_t attempt = 0; attempt < I2C_RETRY_ATTEMPTS; attempt++) {
-        value = board->digitalRead(pin);
-        Logger::logf(LOG_VERBOSE, CAT_I2C, "Read: 0x%02X pin %d = %s",
-                     address, pin, value ? "HIGH" : "LOW");
-        return true;
+    uint8_t port;
+    busStats.baselineTransactions++;
+    if (!readRegisters(address, MCP_REG_GPIOA + (pin >> 3), &port, 1)) {
+        return false;
     }
 
-    Logger::logf(LOG_ERROR, CAT_I2C, "Failed to read pin after %d attempts", I2C_RETRY_ATTEMPTS);
-    return false;
+    value = (port >> (pin & 0x07)) & 0x01;
+    Logger::logf(LOG_VERBOSE, CAT_I2C, "Read: 0x%02X pin %d = %s",
+                 address, pin, value ? "HIGH" : "LOW");
+    return true;
 }
 
 bool GPIOExpander::writePort(uint8_t address, uint8_t port, uint8_t value) {
@@ -160,23 +220,31 @@ bool GPIOExpander::writePort(uint8_t address, uint8_t port, uint8_t value) {
         return false;
     }
 
-    Adafruit_MCP23X17* board = getBoardByAddress(address);
-    if (board == nullptr) {
+    uint8_t index = getBoardIndex(address);
+    if (index == 0xFF) {
         return false;
     }
 
-    if (port == 0) {
-        board->writeGPIOA(value);
-    } else if (port == 1) {
-        board->writeGPIOB(value);
-    } else {
+    if (port > 1) {
         Logger::logf(LOG_ERROR, CAT_I2C, "Invalid port: %d (must be 0 or 1)", port);
         return false;
     }
 
+    busStats.baselineTransactions++;
+
+    ExpanderShadow& shadow = shadows[index];
+    if (port == 0) {
+        shadow.olat = (shadow.olat & 0xFF00) | value;
+        shadow.dirtyOlat |= PORT_A_BIT;
+    } else {
+        shadow.olat = (shadow.olat & 0x00FF) | ((uint16_t)value << 8);
+        shadow.dirtyOlat |= PORT_B_BIT;
+    }
+
     Logger::logf(LOG_VERBOSE, CAT_I2C, "WritePort: 0x%02X port %d = 0x%02X",
                  address, port, value);
-    return true;
+
+    return flushBoard(index);
 }
 
 bool GPIOExpander::readPort(uint8_t address, uint8_t port, uint8_t& value) {
@@ -185,42 +253,561 @@ bool GPIOExpander::readPort(uint8_t address, uint8_t port, uint8_t& value) {
         return false;
     }
 
-    Adafruit_MCP23X17* board = getBoardByAddress(address);
-    if (board == nullptr) {
+    if (getBoardIndex(address) == 0xFF) {
         return false;
     }
 
-    if (port == 0) {
-        value = board->readGPIOA();
-    } else if (port == 1) {
-        value = board->readGPIOB();
-    } else {
+    if (port > 1) {
         Logger::logf(LOG_ERROR, CAT_I2C, "Invalid port: %d (must be 0 or 1)", port);
         return false;
     }
 
+    busStats.baselineTransactions++;
+    if (!readRegisters(address, MCP_REG_GPIOA + port, &value, 1)) {
+        return false;
+    }
+
     Logger::logf(LOG_VERBOSE, CAT_I2C, "ReadPort: 0x%02X port %d = 0x%02X",
                  address, port, value);
     return true;
 }
 
+bool GPIOExpander::writeGPIOAB(uint8_t address, uint16_t value) {
+    if (!initialized) {
+        Logger::error(CAT_I2C, "GPIO expanders not initialized");
+        return false;
+    }
+
+    uint8_t index = getBoardIndex(address);
+    if (index == 0xFF) {
+        return false;
+    }
+
+    busStats.baselineTransactions++;
+
+    // Explicit full-board writes are sent even if the shadow already matches,
+    // so callers such as emergency stop can always force a known output state
+    shadows[index].olat = value;
+    shadows[index].dirtyOlat = PORT_BOTH;
+
+    Logger::logf(LOG_VERBOSE, CAT_I2C, "WriteGPIOAB: 0x%02X = 0x%04X", address, value);
+
+    return flushBoard(index);
+}
+
+bool GPIOExpander::writeOutputsNow(uint8_t address, uint16_t value) {
+    uint8_t index = getBoardIndex(address);
+    if (index == 0xFF) {
+        return false;
+    }
+
+    // Wait briefly for a transaction in progress, then write anyway - the
+    // stop must not queue behind a task stuck on the bus
+    bool locked = I2CManager::tryLockBus(ESTOP_LOCK_TIMEOUT_MS);
+
+    shadows[index].olat = value;
+
+    uint8_t data[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+    bool success = false;
+    for (uint8_t attempt = 0; attempt < I2C_RETRY_ATTEMPTS && !success; attempt++) {
+        busStats.transactions++;
+
+        uint8_t error = busWrite(address, MCP_REG_OLATA, data, 2);
+        if (error == 0) {
+            recordSuccess(index);
+            success = true;
+        } else {
+            busStats.errors++;
+            recordFailure(index, error);
+        }
+    }
+
+    // Retried by the end-of-pass flush() if every attempt failed
+    shadows[index].dirtyOlat = success ? 0 : PORT_BOTH;
+
+    if (locked) {
+        I2CManager::unlockBus();
+    }
+    return success;
+}
+
+bool GPIOExpander::readGPIOAB(uint8_t address, uint16_t& value) {
+    if (!initialized) {
+        Logger::error(CAT_I2C, "GPIO expanders not initialized");
+        return false;
+    }
+
+    if (getBoardIndex(address) == 0xFF) {
+        return false;
+    }
+
+    uint8_t data[2];
+    busStats.baselineTransactions++;
+    if (!readRegisters(address, MCP_REG_GPIOA, data, 2)) {
+        return false;
+    }
+    value = data[0] | ((uint16_t)data[1] << 8);
+
+    Logger::logf(LOG_VERBOSE, CAT_I2C, "ReadGPIOAB: 0x%02X = 0x%04X", address, value);
+    return true;
+}
+
+bool GPIOExpander::configureInterrupts(uint8_t address, uint16_t enableMask) {
+    if (!initialized) {
+        Logger::error(CAT_I2C, "GPIO expanders not initialized");
+        return false;
+    }
+
+    uint8_t index = getBoardIndex(address);
+    if (index == 0xFF) {
+        return false;
+    }
+
+    ExpanderShadow& shadow = shadows[index];
+    shadow.iocon = MCP_IOCON_MIRROR;
+    shadow.gpinten = enableMask;
+
+    // IOCON first (mirror, active-low push-pull), then INTCON = 0 (any change), then GPINTEN
+    const uint8_t intcon[2] = {0x00, 0x00};
+    const uint8_t gpinten[2] = {(uint8_t)(enableMask & 0xFF), (uint8_t)(enableMask >> 8)};
+
+    bool success = writeRegisters(address, MCP_REG_IOCON, &shadow.iocon, 1) &&
+                   writeRegisters(address, MCP_REG_INTCONA, intcon, 2) &&
+                   writeRegisters(address, MCP_REG_GPINTENA, gpinten, 2);
+
+    // Clear anything latched before interrupts were enabled
+    uint16_t flags, captured;
+    success = success && readInterruptCapture(address, flags, captured);
+
+    Logger::logf(success ? LOG_INFO : LOG_ERROR, CAT_I2C, "Interrupt-on-change 0x%02X: mask 0x%04X %s",
+                 address, enableMask, success ? "enabled" : "FAILED");
+    return success;
+}
+
+bool GPIOExpander::readInterruptCapture(uint8_t address, uint16_t& flags, uint16_t& captured) {
+    // INTFA, INTFB, INTCAPA, INTCAPB are consecutive
+    uint8_t data[4];
+    if (!readRegisters(address, MCP_REG_INTFA, data, sizeof(data))) {
+        return false;
+    }
+
+    flags = data[0] | ((uint16_t)data[1] << 8);
+    captured = data[2] | ((uint16_t)data[3] << 8);
+    return true;
+}
+
 bool GPIOExpander::pinMode(uint8_t address, uint8_t pin, uint8_t mode) {
     if (!initialized) {
         Logger::error(CAT_I2C, "GPIO expanders not initialized");
         return false;
     }
 
-    Adafruit_MCP23X17* board = getBoardByAddress(address);
-    if (board == nullptr) {
+    uint8_t index = getBoardIndex(address);
+    if (index == 0xFF || pin > 15) {
         return false;
     }
 
-    board->pinMode(pin, mode);
+    // Unbuffered path: read-modify-write of both IODIR and GPPU
+    busStats.baselineTransactions += 4;
+
+    ExpanderShadow& shadow = shadows[index];
+    uint16_t bit = 1U << pin;
+    uint8_t portBit = (pin < 8) ? PORT_A_BIT : PORT_B_BIT;
+
+    uint16_t iodir = (mode == OUTPUT) ? (shadow.iodir & ~bit) : (shadow.iodir | bit);
+    uint16_t gppu = (mode == INPUT_PULLUP) ? (shadow.gppu | bit) : (shadow.gppu & ~bit);
+
+    if (iodir != shadow.iodir) {
+        shadow.iodir = iodir;
+        shadow.dirtyIodir |= portBit;
+    }
+    if (gppu != shadow.gppu) {
+        shadow.gppu = gppu;
+        shadow.dirtyGppu |= portBit;
+    }
+
     Logger::logf(LOG_DEBUG, CAT_I2C, "PinMode: 0x%02X pin %d set to %s",
                  address, pin,
                  mode == OUTPUT ? "OUTPUT" :
                  mode == INPUT ? "INPUT" : "INPUT_PULLUP");
+
+    return flushBoard(index);
+}
+
+bool GPIOExpander::configureBoard(uint8_t address, uint16_t iodir, uint16_t gppu) {
+    ExpanderShadow& shadow = shadows[address - MCP_MOTOR_0];
+
+    shadow.olat = 0x0000;
+    shadow.iodir = iodir;
+    shadow.gppu = gppu;
+    shadow.dirtyOlat = PORT_BOTH;
+    shadow.dirtyIodir = PORT_BOTH;
+    shadow.dirtyGppu = PORT_BOTH;
+
+    // Unbuffered path: pinMode (4) + digitalWrite (2) for outputs, pinMode only for inputs
+    busStats.baselineTransactions += (iodir == 0x0000) ? 16 * 6 : 16 * 4;
+
+    return flushBoard(address - MCP_MOTOR_0);
+}
+
+bool GPIOExpander::flushBoard(uint8_t boardIndex) {
+    ExpanderShadow& shadow = shadows[boardIndex];
+    uint8_t address = MCP_MOTOR_0 + boardIndex;
+
+    if ((shadow.dirtyOlat | shadow.dirtyIodir | shadow.dirtyGppu) == 0) {
+        return true;
+    }
+
+    // Latches first so newly enabled outputs come up at the intended level
+    bool success = true;
+    success &= writeRegisterPair(address, MCP_REG_OLATA, shadow.olat, shadow.dirtyOlat);
+    success &= writeRegisterPair(address, MCP_REG_GPPUA, shadow.gppu, shadow.dirtyGppu);
+    success &= writeRegisterPair(address, MCP_REG_IODIRA, shadow.iodir, shadow.dirtyIodir);
+
+    busStats.flushes++;
+    return success;
+}
+
+bool GPIOExpander::writeRegisterPair(uint8_t address, uint8_t regA, uint16_t value, uint8_t& dirty) {
+    uint8_t data[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+    bool ok;
+
+    if (dirty == PORT_BOTH) {
+        // Sequential addressing: register A then register B in one transaction
+        ok = writeRegisters(address, regA, data, 2);
+    } else if (dirty == PORT_A_BIT) {
+        ok = writeRegisters(address, regA, &data[0], 1);
+    } else if (dirty == PORT_B_BIT) {
+        ok = writeRegisters(address, regA + 1, &data[1], 1);
+    } else {
+        return true;
+    }
+
+    if (ok) {
+        dirty = 0;
+    }
+    return ok;
+}
+
+bool GPIOExpander::writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length) {
+    uint8_t index = address - MCP_MOTOR_0;
+    uint8_t error = 0;
+
+    I2CManager::lockBus();
+    for (uint8_t attempt = 0; attempt < I2C_RETRY_ATTEMPTS; attempt++) {
+        error = busWrite(address, reg, data, length);
+        busStats.transactions++;
+
+        if (error == 0) {
+            recordSuccess(index);
+            I2CManager::unlockBus();
+            return true;
+        }
+        busStats.errors++;
+        recordFailure(index, error);
+
+        if (attempt + 1 < I2C_RETRY_ATTEMPTS) {
+            recoverFromFailure(index, error);
+        }
+    }
+    I2CManager::unlockBus();
+
+    Logger::logf(LOG_ERROR, CAT_I2C, "Failed to write 0x%02X reg 0x%02X after %d attempts (error %d)",
+                 address, reg, I2C_RETRY_ATTEMPTS, error);
+    return false;
+}
+
+bool GPIOExpander::readRegisters(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    uint8_t index = address - MCP_MOTOR_0;
+    uint8_t error = 0;
+
+    I2CManager::lockBus();
+    for (uint8_t attempt = 0; attempt < I2C_RETRY_ATTEMPTS; attempt++) {
+        error = busRead(address, reg, data, length);
+        busStats.transactions++;
+
+        if (error == 0) {
+            recordSuccess(index);
+            I2CManager::unlockBus();
+            return true;
+        }
+        busStats.errors++;
+        recordFailure(index, error);
+
+        if (attempt + 1 < I2C_RETRY_ATTEMPTS) {
+            recoverFromFailure(index, error);
+        }
+    }
+    I2CManager::unlockBus();
+
+    Logger::logf(LOG_ERROR, CAT_I2C, "Failed to read 0x%02X reg 0x%02X after %d attempts (error %d)",
+                 address, reg, I2C_RETRY_ATTEMPTS, error);
+    return false;
+}
+
+void GPIOExpander::recordFailure(uint8_t boardIndex, uint8_t error) {
+    ExpanderHealth& board = health[boardIndex];
+
+    if (error == I2C_ERROR_NACK_ADDRESS || error == I2C_ERROR_NACK_DATA) {
+        board.nacks++;
+    } else if (error == I2C_ERROR_TIMEOUT) {
+        board.timeouts++;
+    } else {
+        board.otherErrors++;
+    }
+
+    if (board.consecutiveFailures < 0xFF) {
+        board.consecutiveFailures++;
+    }
+
+    // Every retry failed: the board is gone until the supervisor restores it
+    if (board.consecutiveFailures >= I2C_RETRY_ATTEMPTS && !board.offline) {
+        board.offline = true;
+        board.needsRestore = true;
+        Logger::logf(LOG_ERROR, CAT_I2C, "Board 0x%02X stopped responding (%s) - will restore when it returns",
+                     MCP_MOTOR_0 + boardIndex, I2CManager::getErrorString(error));
+    }
+}
+
+void GPIOExpander::recordSuccess(uint8_t boardIndex) {
+    health[boardIndex].consecutiveFailures = 0;
+}
+
+void GPIOExpander::recoverFromFailure(uint8_t boardIndex, uint8_t error) {
+#if I2C_RECOVERY_ENABLED
+    // Restore writes go through the same retry loop - never recurse
+    if (restoring) {
+        return;
+    }
+
+    // One NACK is usually noise; a timeout or a repeat points at a stuck
+    // bus or a board that browned out and came back at power-on defaults
+    if (error != I2C_ERROR_TIMEOUT && health[boardIndex].consecutiveFailures < 2) {
+        return;
+    }
+
+    busStats.busRecoveries++;
+    I2CManager::recoverBus();
+
+    health[boardIndex].needsRestore = true;
+    restoreBoardIndex(boardIndex);
+#endif
+}
+
+bool GPIOExpander::restoreBoard(uint8_t address) {
+    uint8_t index = getBoardIndex(address);
+    if (!initialized || index == 0xFF) {
+        return false;
+    }
+
+    I2CManager::lockBus();
+    bool success = restoreBoardIndex(index);
+    I2CManager::unlockBus();
+    return success;
+}
+
+bool GPIOExpander::restoreBoardIndex(uint8_t boardIndex) {
+    ExpanderShadow& shadow = shadows[boardIndex];
+    uint8_t address = MCP_MOTOR_0 + boardIndex;
+
+    I2CManager::lockBus();
+    restoring = true;
+
+    // IOCON first, then latches before directions as in a normal flush
+    bool success = writeRegisters(address, MCP_REG_IOCON, &shadow.iocon, 1);
+    if (success) {
+        shadow.dirtyOlat = PORT_BOTH;
+        shadow.dirtyGppu = PORT_BOTH;
+        shadow.dirtyIodir = PORT_BOTH;
+        success = flushBoard(boardIndex);
+    }
+    if (success && shadow.gpinten != 0) {
+        const uint8_t intcon[2] = {0x00, 0x00};
+        const uint8_t gpinten[2] = {(uint8_t)(shadow.gpinten & 0xFF), (uint8_t)(shadow.gpinten >> 8)};
+        success = writeRegisters(address, MCP_REG_INTCONA, intcon, 2) &&
+                  writeRegisters(address, MCP_REG_GPINTENA, gpinten, 2);
+    }
+
+    restoring = false;
+
+    ExpanderHealth& board = health[boardIndex];
+    if (success) {
+        board.restores++;
+        board.needsRestore = false;
+        board.offline = false;
+        board.consecutiveFailures = 0;
+        Logger::logf(LOG_WARNING, CAT_I2C, "Board 0x%02X restored from cached registers", address);
+    }
+    I2CManager::unlockBus();
+
+    return success;
+}
+
+bool GPIOExpander::verifyBoard(uint8_t boardIndex) {
+    ExpanderShadow& shadow = shadows[boardIndex];
+    uint8_t address = MCP_MOTOR_0 + boardIndex;
+    uint8_t data[MCP_CONFIG_BYTES];
+
+    if (!readRegisters(address, MCP_REG_IODIRA, data, MCP_CONFIG_BYTES)) {
+        return false;
+    }
+
+#ifdef TIDECLOCK_SIM
+    // The simulated plant does not model configuration registers
     return true;
+#else
+    // Registers with a write still pending are not expected to match yet
+    uint16_t iodir = data[0] | ((uint16_t)data[1] << 8);
+    uint16_t gpinten = data[4] | ((uint16_t)data[5] << 8);
+    uint16_t gppu = data[12] | ((uint16_t)data[13] << 8);
+    uint8_t iocon = data[MCP_REG_IOCON];
+
+    bool matches = (shadow.dirtyIodir != 0 || iodir == shadow.iodir) &&
+                   (shadow.dirtyGppu != 0 || gppu == shadow.gppu) &&
+                   gpinten == shadow.gpinten &&
+                   iocon == shadow.iocon;
+
+    if (!matches) {
+        Logger::logf(LOG_WARNING, CAT_I2C, "Board 0x%02X lost its configuration (IODIR 0x%04X, expected 0x%04X)",
+                     address, iodir, shadow.iodir);
+    }
+    return matches;
+#endif
+}
+
+void GPIOExpander::service() {
+#if I2C_RECOVERY_ENABLED
+    if (!initialized) {
+        return;
+    }
+
+    uint64_t now = Clock::nowMillis();
+
+    // Boards waiting for a restore are retried on their own, faster cadence
+    for (uint8_t i = 0; i < NUM_EXPANDER_BOARDS; i++) {
+        if (health[i].needsRestore && now - lastRestoreAttempt[i] >= I2C_OFFLINE_RETRY_MS) {
+            lastRestoreAttempt[i] = now;
+            restoreBoard(MCP_MOTOR_0 + i);
+        }
+    }
+
+    if (now - lastHealthCheck < I2C_HEALTH_CHECK_INTERVAL_MS) {
+        return;
+    }
+    lastHealthCheck = now;
+
+    uint8_t index = nextHealthCheck;
+    nextHealthCheck = (nextHealthCheck + 1) % NUM_EXPANDER_BOARDS;
+
+    if (health[index].needsRestore) {
+        return;
+    }
+
+    I2CManager::lockBus();
+    if (!verifyBoard(index)) {
+        health[index].needsRestore = true;
+        lastRestoreAttempt[index] = now;
+        restoreBoardIndex(index);
+    }
+    I2CManager::unlockBus();
+#endif
+}
+
+const ExpanderHealth& GPIOExpander::getHealth(uint8_t boardIndex) {
+    return health[boardIndex < NUM_EXPANDER_BOARDS ? boardIndex : 0];
+}
+
+uint8_t GPIOExpander::busWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length) {
+#ifdef TIDECLOCK_SIM
+    return PlantSimulator::busWrite(address, reg, data, length) ? 0 : 2;
+#else
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    Wire.write(data, length);
+    return Wire.endTransmission();
+#endif
+}
+
+uint8_t GPIOExpander::busRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+#ifdef TIDECLOCK_SIM
+    return PlantSimulator::busRead(address, reg, data, length) ? 0 : 2;
+#else
+    // Repeated start between the register pointer write and the read
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    uint8_t error = Wire.endTransmission(false);
+    if (error != 0) {
+        return error;
+    }
+
+    if (Wire.requestFrom(address, length) != length) {
+        return 4;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = Wire.read();
+    }
+    return 0;
+#endif
+}
+
+bool GPIOExpander::flush() {
+    bool success = true;
+
+    for (uint8_t i = 0; i < NUM_EXPANDER_BOARDS; i++) {
+        if (!flushBoard(i)) {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+GPIOBusStats GPIOExpander::getBusStats() {
+    GPIOBusStats stats;
+    stats.transactions = busStats.transactions.load();
+    stats.baselineTransactions = busStats.baselineTransactions.load();
+    stats.coalescedWrites = busStats.coalescedWrites.load();
+    stats.flushes = busStats.flushes.load();
+    stats.errors = busStats.errors.load();
+    stats.busRecoveries = busStats.busRecoveries.load();
+    return stats;
+}
+
+void GPIOExpander::resetBusStats() {
+    busStats.transactions = 0;
+    busStats.baselineTransactions = 0;
+    busStats.coalescedWrites = 0;
+    busStats.flushes = 0;
+    busStats.errors = 0;
+    busStats.busRecoveries = 0;
+}
+
+void GPIOExpander::printBusStats() {
+    GPIOBusStats stats = getBusStats();
+    uint32_t saved = 0;
+    if (stats.baselineTransactions > stats.transactions) {
+        saved = stats.baselineTransactions - stats.transactions;
+    }
+
+    Logger::separator();
+    Logger::info(CAT_I2C, "EXPANDER BUS STATISTICS");
+    Logger::separator();
+    Logger::logf(LOG_INFO, CAT_I2C, "  Transactions issued:   %lu", (unsigned long)stats.transactions);
+    Logger::logf(LOG_INFO, CAT_I2C, "  Unbuffered equivalent: %lu", (unsigned long)stats.baselineTransactions);
+    Logger::logf(LOG_INFO, CAT_I2C, "  Transactions saved:    %lu", (unsigned long)saved);
+    Logger::logf(LOG_INFO, CAT_I2C, "  Coalesced writes:      %lu", (unsigned long)stats.coalescedWrites);
+    Logger::logf(LOG_INFO, CAT_I2C, "  Flushes:               %lu", (unsigned long)stats.flushes);
+    Logger::logf(LOG_INFO, CAT_I2C, "  Errors:                %lu", (unsigned long)stats.errors);
+    Logger::logf(LOG_INFO, CAT_I2C, "  Bus recoveries:        %lu", (unsigned long)stats.busRecoveries);
+    for (uint8_t i = 0; i < NUM_EXPANDER_BOARDS; i++) {
+        const ExpanderHealth& board = health[i];
+        Logger::logf(LOG_INFO, CAT_I2C, "  Board 0x%02X: %s - %lu NACK, %lu timeout, %lu other, %lu restores",
+                     MCP_MOTOR_0 + i,
+                     board.offline ? "OFFLINE" : (board.needsRestore ? "restore pending" : "ok"),
+                     (unsigned long)board.nacks, (unsigned long)board.timeouts,
+                     (unsigned long)board.otherErrors, (unsigned long)board.restores);
+    }
+    Logger::separator();
 }
 
 bool GPIOExpander::healthCheck() {
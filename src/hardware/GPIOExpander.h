@@ -3,6 +3,10 @@
  *
  * Manages all MCP23017 GPIO expander boards with error handling and retry logic.
  * Provides high-level interface for pin operations on all 5 boards.
+ *
+ * A bus supervisor counts NACKs and timeouts per board. A stuck bus is
+ * cleared with SCL pulses and a Wire restart, and a board that reset is
+ * brought back by re-writing its cached registers.
  */
 
 #ifndef GPIO_EXPANDER_H
@@ -10,9 +14,52 @@
 
 #include <Arduino.h>
 #include <Adafruit_MCP23X17.h>
+#include <atomic>
 #include "../config.h"
 #include "../utils/Logger.h"
 
+#define NUM_EXPANDER_BOARDS (NUM_MOTOR_BOARDS + NUM_SWITCH_BOARDS)
+
+/**
+ * RAM shadow of one board's configuration and output registers
+ * Bit N = pin N (Port A = bits 0-7, Port B = bits 8-15)
+ */
+struct ExpanderShadow {
+    uint16_t olat;          // Output latch
+    uint16_t iodir;         // Direction (1 = input)
+    uint16_t gppu;          // Pull-up enable
+    uint16_t gpinten;       // Interrupt-on-change enable
+    uint8_t iocon;          // Configuration (shared by both ports)
+    uint8_t dirtyOlat;      // Ports awaiting write (bit 0 = A, bit 1 = B)
+    uint8_t dirtyIodir;
+    uint8_t dirtyGppu;
+};
+
+/**
+ * I2C bus usage counters for the expander boards
+ */
+struct GPIOBusStats {
+    uint32_t transactions;          // Transactions actually issued
+    uint32_t baselineTransactions;  // Transactions the unbuffered read-modify-write path would issue
+    uint32_t coalescedWrites;       // Writes merged into another transaction or skipped as no-ops
+    uint32_t flushes;               // Flushes that wrote at least one register
+    uint32_t errors;                // Failed transactions
+    uint32_t busRecoveries;         // Stuck-bus clears (SCL pulses + Wire restart)
+};
+
+/**
+ * Bus health of one expander board, kept by the bus supervisor
+ */
+struct ExpanderHealth {
+    uint32_t nacks;                 // Address or data not acknowledged
+    uint32_t timeouts;              // Bus timeouts
+    uint32_t otherErrors;           // Short reads and other bus errors
+    uint32_t restores;              // Times the cached registers were re-applied
+    uint8_t consecutiveFailures;    // Failed transactions since the last success
+    bool offline;                   // Every retry failed; the supervisor keeps trying
+    bool needsRestore;              // Registers may be back at power-on defaults
+};
+
 class GPIOExpander {
 public:
     /**
@@ -57,6 +104,54 @@ public:
      */
     static bool readPort(uint8_t address, uint8_t port, uint8_t& value);
 
+    /**
+     * Write all 16 pins at once (Port A = low byte, Port B = high byte)
+     * Single I2C transaction - no read-modify-write. Always written,
+     * even if the shadow already matches.
+     * @param address I2C address of the MCP23017
+     * @param value 16-bit output image to write
+     * @return true if successful, false on error
+     */
+    static bool writeGPIOAB(uint8_t address, uint16_t value);
+
+    /**
+     * Write a board's output latches in one transaction, without logging
+     * (emergency stop path - bypasses the shadow dirty check, and waits at
+     * most ESTOP_LOCK_TIMEOUT_MS for the bus lock before writing anyway)
+     * @param address MCP23017 I2C address
+     * @param value 16-bit output value
+     * @return true if successful
+     */
+    static bool writeOutputsNow(uint8_t address, uint16_t value);
+
+    /**
+     * Read all 16 pins at once (Port A = low byte, Port B = high byte)
+     * @param address I2C address of the MCP23017
+     * @param value Reference to store the 16-bit result
+     * @return true if successful, false on error
+     */
+    static bool readGPIOAB(uint8_t address, uint16_t& value);
+
+    /**
+     * Enable interrupt-on-change for a set of pins (compare against previous value)
+     * INTA and INTB are mirrored so either pin signals a change on any port,
+     * driven active-low. Any pending interrupt is cleared.
+     * @param address I2C address of the MCP23017
+     * @param enableMask Bit N set = interrupt on pin N
+     * @return true if successful, false on error
+     */
+    static bool configureInterrupts(uint8_t address, uint16_t enableMask);
+
+    /**
+     * Read which pins caused an interrupt and their captured values
+     * Single I2C transaction (INTF and INTCAP); reading INTCAP releases INT.
+     * @param address I2C address of the MCP23017
+     * @param flags Receives INTF (bit N set = pin N changed)
+     * @param captured Receives INTCAP (pin values at the time of the interrupt)
+     * @return true if successful, false on error
+     */
+    static bool readInterruptCapture(uint8_t address, uint16_t& flags, uint16_t& captured);
+
     /**
      * Set pin mode for a specific pin
      * @param address I2C address of the MCP23017
@@ -66,6 +161,49 @@ public:
      */
     static bool pinMode(uint8_t address, uint8_t pin, uint8_t mode);
 
+    /**
+     * Write all dirty shadow registers to the boards
+     * Called automatically at the end of every motion pass to retry writes
+     * that failed (e.g. an emergency-stop write to a board that was offline).
+     * @return true if every pending write succeeded
+     */
+    static bool flush();
+
+    /**
+     * Get a snapshot of the I2C transaction counters
+     */
+    static GPIOBusStats getBusStats();
+
+    /**
+     * Reset I2C transaction counters
+     */
+    static void resetBusStats();
+
+    /**
+     * Print I2C transaction counters and savings to serial
+     */
+    static void printBusStats();
+
+    /**
+     * Bus-health supervisor: restore boards that dropped off the bus or lost
+     * their configuration, and check one board's registers against the cache
+     * every I2C_HEALTH_CHECK_INTERVAL_MS (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Re-apply a board's cached register state (IOCON, latches, pull-ups,
+     * directions and interrupt enables)
+     * @return true if every register was written
+     */
+    static bool restoreBoard(uint8_t address);
+
+    /**
+     * Get the bus health of a board
+     * @param boardIndex 0-4 (motor boards, then switch boards)
+     */
+    static const ExpanderHealth& getHealth(uint8_t boardIndex);
+
     /**
      * Check if all boards are initialized and responding
      * @return true if all boards OK, false otherwise
@@ -88,16 +226,105 @@ private:
 
     static bool initialized;
 
+    static ExpanderShadow shadows[NUM_EXPANDER_BOARDS];
+
+    // Bus counters (atomic: updated from the motion, network, sampler and e-stop tasks)
+    struct BusCounters {
+        std::atomic<uint32_t> transactions{0};
+        std::atomic<uint32_t> baselineTransactions{0};
+        std::atomic<uint32_t> coalescedWrites{0};
+        std::atomic<uint32_t> flushes{0};
+        std::atomic<uint32_t> errors{0};
+        std::atomic<uint32_t> busRecoveries{0};
+    };
+    static BusCounters busStats;
+
+    // Bus supervisor state (guarded by the I2CManager bus lock)
+    static ExpanderHealth health[NUM_EXPANDER_BOARDS];
+    static bool restoring;
+    static uint64_t lastHealthCheck;
+    static uint64_t lastRestoreAttempt[NUM_EXPANDER_BOARDS];
+    static uint8_t nextHealthCheck;
+
+    /**
+     * Probe a board at startup (Adafruit driver on hardware, plant in TIDECLOCK_SIM builds)
+     */
+    static bool attachBoard(Adafruit_MCP23X17& board, uint8_t address);
+
     /**
      * Get MCP instance pointer by address
      */
     static Adafruit_MCP23X17* getBoardByAddress(uint8_t address);
 
     /**
-     * Retry an operation with exponential backoff
+     * Get shadow index (0-4) for a board address, or 0xFF if invalid
+     */
+    static uint8_t getBoardIndex(uint8_t address);
+
+    /**
+     * Write dirty registers of one board
+     */
+    static bool flushBoard(uint8_t boardIndex);
+
+    /**
+     * Write one register pair (A/B) - both ports in one transaction if both are dirty
+     * @param dirty Port bits to write (bit 0 = A, bit 1 = B), cleared on success
+     */
+    static bool writeRegisterPair(uint8_t address, uint8_t regA, uint16_t value, uint8_t& dirty);
+
+    /**
+     * Write consecutive registers in a single I2C transaction with retry
+     */
+    static bool writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length);
+
+    /**
+     * Read consecutive registers in a single I2C transaction with retry
+     */
+    static bool readRegisters(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+    /**
+     * One register write transaction on the bus (or the simulated plant)
+     * @return Wire error code (0 = success)
+     */
+    static uint8_t busWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length);
+
+    /**
+     * One register read transaction on the bus (or the simulated plant)
+     * @return Wire error code (0 = success)
+     */
+    static uint8_t busRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+    /**
+     * Count a failed transaction against its board
+     */
+    static void recordFailure(uint8_t boardIndex, uint8_t error);
+
+    /**
+     * Count a successful transaction against its board
+     */
+    static void recordSuccess(uint8_t boardIndex);
+
+    /**
+     * Between retries: clear the bus and restore the board when the
+     * failure looks like a stuck bus or a board reset rather than noise
+     */
+    static void recoverFromFailure(uint8_t boardIndex, uint8_t error);
+
+    /**
+     * Re-apply one board's cached registers
+     */
+    static bool restoreBoardIndex(uint8_t boardIndex);
+
+    /**
+     * Read a board's configuration registers and compare them with the cache
+     * @return false if the board did not respond or has lost its configuration
+     */
+    static bool verifyBoard(uint8_t boardIndex);
+
+    /**
+     * Set a board's direction and pull-ups with all latches low, and write it
      */
-    template<typename Func>
-    static bool retryOperation(const char* opName, Func operation);
+    static bool configureBoard(uint8_t address, uint16_t iodir, uint16_t gppu);
 };
 
 #endif // GPIO_EXPANDER_H
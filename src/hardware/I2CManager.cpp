@@ -4,7 +4,12 @@
 
 #include "I2CManager.h"
 
+#ifdef TIDECLOCK_SIM
+#include "../sim/PlantSimulator.h"
+#endif
+
 bool I2CManager::initialized = false;
+SemaphoreHandle_t I2CManager::busMutex = nullptr;
 
 // Array of required MCP23017 I2C addresses
 const uint8_t I2CManager::REQUIRED_ADDRESSES[5] = {
@@ -18,6 +23,17 @@ const uint8_t I2CManager::REQUIRED_ADDRESSES[5] = {
 bool I2CManager::begin() {
     Logger::info(CAT_I2C, "Initializing I2C bus...");
 
+    if (busMutex == nullptr) {
+        busMutex = xSemaphoreCreateRecursiveMutex();
+    }
+
+#ifdef TIDECLOCK_SIM
+    // Expander boards are replaced by the simulated plant
+    PlantSimulator::begin();
+    initialized = true;
+    Logger::warning(CAT_I2C, "I2C bus simulated (TIDECLOCK_SIM) - no hardware is driven");
+    return true;
+#else
     // Initialize Wire library with custom pins
     Wire.begin(I2C_SDA, I2C_SCL);
 
@@ -34,6 +50,7 @@ bool I2CManager::begin() {
 
     Logger::info(CAT_I2C, "I2C bus initialized successfully");
     return true;
+#endif
 }
 
 uint8_t I2CManager::scanBus(bool printResults) {
@@ -50,8 +67,7 @@ uint8_t I2CManager::scanBus(bool printResults) {
     uint8_t error;
 
     for (uint8_t address = 1; address < 127; address++) {
-        Wire.beginTransmission(address);
-        error = Wire.endTransmission();
+        error = probe(address);
 
         if (error == 0) {
             devicesFound++;
@@ -79,8 +95,7 @@ bool I2CManager::isDevicePresent(uint8_t address) {
         return false;
     }
 
-    Wire.beginTransmission(address);
-    uint8_t error = Wire.endTransmission();
+    uint8_t error = probe(address);
 
     if (error == 0) {
         Logger::logf(LOG_DEBUG, CAT_I2C, "Device 0x%02X present", address);
@@ -167,3 +182,72 @@ const char* I2CManager::getErrorString(uint8_t error) {
         default: return "Unknown error";
     }
 }
+
+bool I2CManager::recoverBus() {
+#ifdef TIDECLOCK_SIM
+    return true;
+#else
+    lockBus();
+    Wire.end();
+
+    // A slave stopped mid-byte holds SDA low until it has clocked out the byte
+    pinMode(I2C_SDA, INPUT_PULLUP);
+    pinMode(I2C_SCL, OUTPUT_OPEN_DRAIN);
+    digitalWrite(I2C_SCL, HIGH);
+    delayMicroseconds(5);
+
+    for (uint8_t pulse = 0; pulse < I2C_RECOVERY_SCL_PULSES && digitalRead(I2C_SDA) == LOW; pulse++) {
+        digitalWrite(I2C_SCL, LOW);
+        delayMicroseconds(5);
+        digitalWrite(I2C_SCL, HIGH);
+        delayMicroseconds(5);
+    }
+
+    // STOP condition: SDA rises while SCL is high
+    pinMode(I2C_SDA, OUTPUT_OPEN_DRAIN);
+    digitalWrite(I2C_SDA, LOW);
+    delayMicroseconds(5);
+    digitalWrite(I2C_SDA, HIGH);
+    delayMicroseconds(5);
+
+    pinMode(I2C_SDA, INPUT_PULLUP);
+    bool released = digitalRead(I2C_SDA) == HIGH;
+
+    Wire.begin(I2C_SDA, I2C_SCL);
+    Wire.setClock(I2C_FREQ);
+    unlockBus();
+
+    Logger::logf(released ? LOG_WARNING : LOG_ERROR, CAT_I2C, "I2C bus recovery: SDA %s",
+                 released ? "released" : "still held low");
+    return released;
+#endif
+}
+
+void I2CManager::lockBus() {
+    if (busMutex != nullptr) {
+        xSemaphoreTakeRecursive(busMutex, portMAX_DELAY);
+    }
+}
+
+bool I2CManager::tryLockBus(uint32_t timeoutMs) {
+    return busMutex == nullptr ||
+           xSemaphoreTakeRecursive(busMutex, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+void I2CManager::unlockBus() {
+    if (busMutex != nullptr) {
+        xSemaphoreGiveRecursive(busMutex);
+    }
+}
+
+uint8_t I2CManager::probe(uint8_t address) {
+#ifdef TIDECLOCK_SIM
+    return PlantSimulator::isPresent(address) ? 0 : 2;
+#else
+    lockBus();
+    Wire.beginTransmission(address);
+    uint8_t error = Wire.endTransmission();
+    unlockBus();
+    return error;
+#endif
+}
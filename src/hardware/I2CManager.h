@@ -10,6 +10,8 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include "../config.h"
 #include "../utils/Logger.h"
 
@@ -53,9 +55,38 @@ public:
      */
     static const char* getErrorString(uint8_t error);
 
+    /**
+     * Free a stuck bus: clock SCL until a slave holding SDA low lets go,
+     * send a STOP, then restart the Wire driver
+     * @return true if SDA is released afterwards
+     */
+    static bool recoverBus();
+
+    /**
+     * Take the bus for a sequence of transactions (recursive; every task
+     * that touches Wire goes through this lock)
+     */
+    static void lockBus();
+
+    /**
+     * Take the bus, giving up after a timeout
+     * @param timeoutMs Longest wait for another task's transaction
+     * @return true if the lock was taken (release it with unlockBus())
+     */
+    static bool tryLockBus(uint32_t timeoutMs);
+
+    static void unlockBus();
+
 private:
     static bool initialized;
     static const uint8_t REQUIRED_ADDRESSES[5];
+    static SemaphoreHandle_t busMutex;
+
+    /**
+     * Address a device with no data (or ask the simulated plant)
+     * @return Wire error code (0 = device acknowledged)
+     */
+    static uint8_t probe(uint8_t address);
 };
 
 #endif // I2C_MANAGER_H
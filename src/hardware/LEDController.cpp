@@ -5,6 +5,7 @@
 #include "LEDController.h"
 #include "../core/ConfigManager.h"
 #include "../utils/Logger.h"
+#include "../utils/Clock.h"
 #include "../network/TimeManager.h"
 
 // Static member initialization
@@ -20,14 +21,14 @@ uint8_t LEDController::colorIndex = 6;  // Cyan default
 uint8_t LEDController::startHour = LED_DEFAULT_START_HOUR;
 uint8_t LEDController::endHour = LED_DEFAULT_END_HOUR;
 
-unsigned long LEDController::lastUpdate = 0;
+uint64_t LEDController::lastUpdate = 0;
 
 TestPattern LEDController::currentTestPattern = TEST_RGB_CHASE;
-unsigned long LEDController::lastPatternChange = 0;
+uint64_t LEDController::lastPatternChange = 0;
 uint16_t LEDController::testAnimationState = 0;
 
 uint8_t LEDController::currentBrightness = 0;
-unsigned long LEDController::fadeStartTime = 0;
+uint64_t LEDController::fadeStartTime = 0;
 bool LEDController::fading = false;
 
 bool LEDController::begin() {
@@ -117,7 +118,7 @@ void LEDController::update() {
     }
 
     // Frame rate limiting (~33 FPS)
-    unsigned long now = millis();
+    uint64_t now = Clock::nowMillis();
     if (now - lastUpdate < LED_UPDATE_INTERVAL_MS) {
         return;
     }
@@ -128,7 +129,7 @@ void LEDController::update() {
 
     // Handle fading
     if (fading) {
-        unsigned long fadeElapsed = now - fadeStartTime;
+        uint32_t fadeElapsed = (uint32_t)(now - fadeStartTime);
         if (fadeElapsed >= LED_FADE_DURATION_MS) {
             // Fade complete
             currentBrightness = shouldBeOn ? brightness : 0;
@@ -267,7 +268,7 @@ void LEDController::renderStaticColor() {
 }
 
 void LEDController::renderTestPattern() {
-    unsigned long now = millis();
+    uint64_t now = Clock::nowMillis();
 
     // Change test pattern every 5 seconds
     if (now - lastPatternChange >= LED_TEST_PATTERN_INTERVAL_MS) {
@@ -351,7 +352,7 @@ void LEDController::renderSegmentTest() {
 void LEDController::fadeToTarget(uint8_t targetBrightness) {
     // This is handled in update() function via fading flag
     fading = true;
-    fadeStartTime = millis();
+    fadeStartTime = Clock::nowMillis();
 }
 
 void LEDController::clearStrip() {
@@ -58,7 +58,7 @@ public:
     static bool reinit(uint8_t pin, uint16_t count);
 
     /**
-     * Update LED display (call from main loop)
+     * Update LED display (call from the motion task)
      * Handles time-based control and rendering
      */
     static void update();
@@ -124,11 +124,11 @@ private:
     static uint8_t endHour;
 
     // Frame rate control
-    static unsigned long lastUpdate;
+    static uint64_t lastUpdate;
 
     // Test pattern state
     static TestPattern currentTestPattern;
-    static unsigned long lastPatternChange;
+    static uint64_t lastPatternChange;
     static uint16_t testAnimationState;
 
     // Rendering functions
@@ -140,7 +140,7 @@ private:
 
     // Fade control
     static uint8_t currentBrightness;
-    static unsigned long fadeStartTime;
+    static uint64_t fadeStartTime;
     static bool fading;
 
     // Helper functions
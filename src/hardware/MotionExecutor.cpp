@@ -0,0 +1,401 @@
+/**
+ * Motion Executor Implementation
+ */
+
+#include "MotionExecutor.h"
+#include "MotionJobQueue.h"
+#include "../core/StateManager.h"
+#include "../core/TaskManager.h"
+#include "../utils/Clock.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_timer.h>
+
+// One-shot stop timer per motor (created in begin())
+static esp_timer_handle_t stopTimers[NUM_MOTORS] = {nullptr};
+#endif
+
+// Static member initialization
+TimedMove MotionExecutor::moves[NUM_MOTORS];
+uint8_t MotionExecutor::activeCount = 0;
+bool MotionExecutor::timerStopEnabled = false;
+uint32_t MotionExecutor::timerLeadUs = 0;
+LatencyHistogram MotionExecutor::jitterHistogram;
+
+void MotionExecutor::begin() {
+    Logger::info(CAT_MOTOR, "Initializing Motion Executor...");
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        moves[i].active = false;
+        moves[i].direction = MOTOR_STOP;
+        moves[i].commandedMs = 0;
+        moves[i].startUs = 0;
+        moves[i].stopUs = 0;
+        moves[i].fireAtUs = 0;
+        moves[i].timerArmed = false;
+        moves[i].timerFired = false;
+        moves[i].actualUs = 0;
+        moves[i].cancelled = false;
+    }
+    activeCount = 0;
+    timerLeadUs = 0;
+    jitterHistogram.reset();
+
+    timerStopEnabled = false;
+#ifdef ESP_PLATFORM
+    bool timersReady = true;
+    for (uint8_t i = 0; i < NUM_MOTORS && timersReady; i++) {
+        if (stopTimers[i] != nullptr) {
+            continue;
+        }
+
+        esp_timer_create_args_t args = {};
+        args.callback = &MotionExecutor::onStopTimer;
+        args.arg = (void*)(uintptr_t)i;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "motor_stop";
+
+        if (esp_timer_create(&args, &stopTimers[i]) != ESP_OK) {
+            Logger::logf(LOG_ERROR, CAT_MOTOR, "Failed to create stop timer for motor %d", i);
+            timersReady = false;
+        }
+    }
+    timerStopEnabled = timersReady && MOTION_TIMER_STOP_ENABLED;
+#endif
+
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Motion Executor ready (%s stop)",
+                 timerStopEnabled ? "timer" : "loop");
+}
+
+bool MotionExecutor::startMove(uint8_t motorIndex, MotorDirection direction, uint16_t durationMs) {
+    if (motorIndex >= NUM_MOTORS) {
+        Logger::logf(LOG_ERROR, CAT_MOTOR, "Invalid motor index: %d (must be 0-%d)",
+                     motorIndex, NUM_MOTORS - 1);
+        return false;
+    }
+
+    if (direction != MOTOR_FORWARD && direction != MOTOR_REVERSE) {
+        Logger::logf(LOG_ERROR, CAT_MOTOR, "Invalid move direction: %d", direction);
+        return false;
+    }
+
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Running motor %d %s for %d ms",
+                 motorIndex, MotorController::getDirectionString(direction), durationMs);
+
+    TimedMove& move = moves[motorIndex];
+
+    // Hold the output lock so a pending stop callback cannot land between
+    // the start write and the new deadline being recorded
+    MotorController::lockOutputs();
+
+    disarmStopTimer(motorIndex);
+
+    if (!MotorController::setMotorDirection(motorIndex, direction)) {
+        // Any move already running falls back to its loop deadline
+        MotorController::unlockOutputs();
+        return false;
+    }
+
+    uint64_t now = Clock::nowMicros();
+    if (move.active) {
+        // Credit the replaced move's travel to the position estimate
+        uint64_t runUs = move.timerFired ? move.actualUs : now - move.startUs;
+        MotorController::recordTravel(motorIndex, move.direction, (uint32_t)((runUs + 500) / 1000));
+    } else {
+        activeCount++;
+    }
+
+    move.active = true;
+    move.direction = direction;
+    move.commandedMs = durationMs;
+    move.startUs = now;
+    move.stopUs = now + (uint64_t)durationMs * 1000;
+    move.timerFired = false;
+    move.cancelled = false;
+    // Stop timers run on real time; virtual-time runs stop from tick()
+    move.timerArmed = timerStopEnabled && !Clock::isVirtual() && armStopTimer(motorIndex);
+
+    MotorController::unlockOutputs();
+
+    return true;
+}
+
+bool MotionExecutor::armStopTimer(uint8_t motorIndex) {
+#ifdef ESP_PLATFORM
+    TimedMove& move = moves[motorIndex];
+
+    // Fire early by the learned stop-write overhead so the stop lands on time
+    uint64_t commandedUs = (uint64_t)move.commandedMs * 1000;
+    uint64_t leadUs = timerLeadUs < commandedUs ? timerLeadUs : 0;
+    move.fireAtUs = move.startUs + commandedUs - leadUs;
+
+    uint64_t now = Clock::nowMicros();
+    uint64_t delayUs = move.fireAtUs > now ? move.fireAtUs - now : 1;
+    move.fireAtUs = now + delayUs;
+
+    if (esp_timer_start_once(stopTimers[motorIndex], delayUs) != ESP_OK) {
+        Logger::logf(LOG_WARNING, CAT_MOTOR, "Stop timer unavailable for motor %d, using loop stop",
+                     motorIndex);
+        return false;
+    }
+    return true;
+#else
+    (void)motorIndex;
+    return false;
+#endif
+}
+
+void MotionExecutor::disarmStopTimer(uint8_t motorIndex) {
+#ifdef ESP_PLATFORM
+    if (moves[motorIndex].timerArmed && stopTimers[motorIndex] != nullptr) {
+        esp_timer_stop(stopTimers[motorIndex]);
+    }
+#endif
+    moves[motorIndex].timerArmed = false;
+}
+
+void MotionExecutor::onStopTimer(void* arg) {
+    uint8_t motorIndex = (uint8_t)(uintptr_t)arg;
+    TimedMove& move = moves[motorIndex];
+
+    // Runs in the esp_timer task: no logging here, just the stop write
+    MotorController::lockOutputs();
+
+    // A callback dispatched just before the move was replaced or cancelled
+    // finds either an inactive slot or a deadline still in the future
+    // A failed write leaves the move running; tick() stops it after the grace period
+    if (move.active && move.timerArmed && !move.timerFired &&
+        Clock::nowMicros() >= move.fireAtUs) {
+        MotorController::stageMotorDirection(motorIndex, MOTOR_STOP);
+        if (MotorController::commitMotorOutputs()) {
+            move.actualUs = (uint32_t)(Clock::nowMicros() - move.startUs);
+            move.timerFired = true;
+        }
+    }
+
+    MotorController::unlockOutputs();
+}
+
+void MotionExecutor::tick() {
+    if (activeCount == 0) {
+        return;
+    }
+
+    uint32_t expired = 0;
+    uint32_t late = 0;
+    uint32_t finished = 0;
+
+    MotorController::lockOutputs();
+
+    uint64_t now = Clock::nowMicros();
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        TimedMove& move = moves[i];
+        if (!move.active) {
+            continue;
+        }
+
+        if (move.timerFired) {
+            finished |= (1UL << i);
+        } else if (!move.timerArmed && now >= move.stopUs) {
+            expired |= (1UL << i);
+        } else if (move.timerArmed && now >= move.stopUs + (uint64_t)MOTION_TIMER_GRACE_MS * 1000) {
+            // Timer never fired or its stop write failed; stop it here and
+            // keep the late stop out of the lead estimate
+            disarmStopTimer(i);
+            expired |= (1UL << i);
+            late |= (1UL << i);
+        }
+    }
+
+    if (expired != 0) {
+        // Stop every expired motor with at most one write per motor board
+        MotorController::setMotorDirections(expired, MOTOR_STOP);
+
+        uint64_t stoppedUs = Clock::nowMicros();
+        for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+            if (expired & (1UL << i)) {
+                moves[i].actualUs = (uint32_t)(stoppedUs - moves[i].startUs);
+            }
+        }
+        finished |= expired;
+    }
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (finished & (1UL << i)) {
+            moves[i].active = false;
+            activeCount--;
+        }
+    }
+
+    MotorController::unlockOutputs();
+
+    // Bookkeeping and logging happen outside the lock
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (late & (1UL << i)) {
+            Logger::logf(LOG_WARNING, CAT_MOTOR, "Motor %d stop timer missed its deadline, stopped by motion task", i);
+        }
+        if (finished & (1UL << i)) {
+            completeMove(i);
+        }
+    }
+
+    // Manual test moves hold the TESTING state until every motor has stopped
+    // and no motion job still has moves to start
+    if (activeCount == 0 && StateManager::getState() == STATE_TESTING &&
+        !MotionJobQueue::isBusy()) {
+        StateManager::setState(STATE_READY);
+    }
+}
+
+void MotionExecutor::completeMove(uint8_t motorIndex) {
+    TimedMove& move = moves[motorIndex];
+
+    uint32_t commandedUs = (uint32_t)move.commandedMs * 1000;
+    uint32_t errorUs = move.actualUs > commandedUs ? move.actualUs - commandedUs
+                                                   : commandedUs - move.actualUs;
+    jitterHistogram.record(errorUs);
+    MotorController::recordTravel(motorIndex, move.direction, (move.actualUs + 500) / 1000);
+
+    if (move.timerArmed) {
+        // Learn callback dispatch + stop write time as a running average (1/8 weight)
+        uint64_t stoppedAt = move.startUs + move.actualUs;
+        uint32_t overheadUs = stoppedAt > move.fireAtUs ? (uint32_t)(stoppedAt - move.fireAtUs) : 0;
+        timerLeadUs = (timerLeadUs * 7 + overheadUs) / 8;
+        if (timerLeadUs > MOTION_TIMER_LEAD_MAX_US) {
+            timerLeadUs = MOTION_TIMER_LEAD_MAX_US;
+        }
+        move.timerArmed = false;
+    }
+
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Motor %d %s run complete (%u ms commanded, %lu us actual)",
+                 motorIndex, move.direction == MOTOR_FORWARD ? "forward" : "reverse",
+                 move.commandedMs, (unsigned long)move.actualUs);
+}
+
+bool MotionExecutor::cancelMove(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return false;
+    }
+
+    TimedMove& move = moves[motorIndex];
+    bool wasActive = false;
+    uint64_t elapsedUs = 0;
+
+    MotorController::lockOutputs();
+    disarmStopTimer(motorIndex);
+    if (move.active) {
+        move.active = false;
+        move.cancelled = true;
+        activeCount--;
+        wasActive = true;
+    }
+    bool success = MotorController::stopMotor(motorIndex);
+    if (wasActive) {
+        // Partial travel still moves the position estimate
+        elapsedUs = move.timerFired ? move.actualUs : Clock::nowMicros() - move.startUs;
+        MotorController::recordTravel(motorIndex, move.direction, (uint32_t)((elapsedUs + 500) / 1000));
+    }
+    MotorController::unlockOutputs();
+
+    if (wasActive) {
+        Logger::logf(LOG_INFO, CAT_MOTOR, "Motor %d move cancelled after %lu ms",
+                     motorIndex, (unsigned long)(elapsedUs / 1000));
+    }
+
+    return success;
+}
+
+void MotionExecutor::cancelAll() {
+    MotorController::lockOutputs();
+    uint64_t now = Clock::nowMicros();
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        disarmStopTimer(i);
+        if (moves[i].active) {
+            moves[i].active = false;
+            moves[i].cancelled = true;
+
+            // A timer-stopped move has its exact on-time; otherwise it runs until now
+            uint64_t runUs = moves[i].timerFired ? moves[i].actualUs : now - moves[i].startUs;
+            MotorController::recordTravel(i, moves[i].direction, (uint32_t)((runUs + 500) / 1000));
+        }
+    }
+    activeCount = 0;
+    MotorController::unlockOutputs();
+}
+
+bool MotionExecutor::isMoving(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return false;
+    }
+    return moves[motorIndex].active;
+}
+
+bool MotionExecutor::wasCancelled(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return false;
+    }
+    return moves[motorIndex].cancelled;
+}
+
+uint8_t MotionExecutor::getActiveCount() {
+    return activeCount;
+}
+
+bool MotionExecutor::isIdle() {
+    return activeCount == 0;
+}
+
+bool MotionExecutor::waitForMotor(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return false;
+    }
+
+    while (moves[motorIndex].active) {
+        tick();
+        TaskManager::waitInOperation(1);
+    }
+
+    return !moves[motorIndex].cancelled;
+}
+
+void MotionExecutor::setTimerStopEnabled(bool enabled) {
+#ifdef ESP_PLATFORM
+    timerStopEnabled = enabled && stopTimers[0] != nullptr;
+#else
+    timerStopEnabled = false;
+#endif
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Timed moves now use %s stop",
+                 timerStopEnabled ? "timer" : "loop");
+}
+
+bool MotionExecutor::isTimerStopEnabled() {
+    return timerStopEnabled;
+}
+
+bool MotionExecutor::getLastMoveTiming(uint8_t motorIndex, uint16_t& commandedMs, uint32_t& actualUs) {
+    if (motorIndex >= NUM_MOTORS || moves[motorIndex].active || moves[motorIndex].actualUs == 0) {
+        return false;
+    }
+
+    commandedMs = moves[motorIndex].commandedMs;
+    actualUs = moves[motorIndex].actualUs;
+    return true;
+}
+
+const LatencyHistogram& MotionExecutor::getJitterHistogram() {
+    return jitterHistogram;
+}
+
+uint32_t MotionExecutor::getTimerLeadUs() {
+    return timerLeadUs;
+}
+
+void MotionExecutor::resetTimingStats() {
+    jitterHistogram.reset();
+}
+
+void MotionExecutor::printTimingStats() {
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Stop mode: %s, timer lead: %lu us",
+                 timerStopEnabled ? "timer" : "loop", (unsigned long)timerLeadUs);
+    jitterHistogram.print(CAT_MOTOR, "Run-time error");
+}
@@ -0,0 +1,169 @@
+/**
+ * Motion Executor
+ *
+ * Deadline-based executor for timed motor moves. A move starts the motor,
+ * records its stop deadline and returns immediately; tick() (called every
+ * motion pass) stops each motor once its deadline has passed. The web server,
+ * LED animation and emergency stop keep running while motors move.
+ *
+ * In timer-stop mode each move also arms a one-shot esp_timer, and the
+ * stop is written from the timer callback rather than waiting for the next
+ * motion pass. Every move's commanded vs. measured on-time is recorded in
+ * a jitter histogram.
+ */
+
+#ifndef MOTION_EXECUTOR_H
+#define MOTION_EXECUTOR_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../utils/Logger.h"
+#include "../utils/LatencyHistogram.h"
+#include "MotorController.h"
+
+/**
+ * A timed move in progress on one motor
+ */
+struct TimedMove {
+    bool active;                // Motor is running under executor control
+    MotorDirection direction;   // MOTOR_FORWARD or MOTOR_REVERSE
+    uint16_t commandedMs;       // Requested run time
+    uint64_t startUs;           // Clock time when the start write completed
+    uint64_t stopUs;            // Deadline at which to stop the motor
+    uint64_t fireAtUs;          // Earliest time the stop timer can fire
+    bool timerArmed;            // Stop is scheduled on the hardware timer
+    volatile bool timerFired;   // Timer callback has stopped the motor
+    uint32_t actualUs;          // Measured on-time of the last finished move
+    bool cancelled;             // Last move was stopped before its deadline
+};
+
+class MotionExecutor {
+public:
+    /**
+     * Initialize executor (requires MotorController to be initialized first)
+     */
+    static void begin();
+
+    /**
+     * Start a timed move and return immediately
+     * Any move already running on the motor is replaced.
+     * @param motorIndex Motor number (0-23)
+     * @param direction MOTOR_FORWARD or MOTOR_REVERSE
+     * @param durationMs Time to run in milliseconds
+     * @return true if the motor was started
+     */
+    static bool startMove(uint8_t motorIndex, MotorDirection direction, uint16_t durationMs);
+
+    /**
+     * Stop motors whose deadline has passed (call from the motion task)
+     */
+    static void tick();
+
+    /**
+     * Stop a motor early and discard its move
+     * @return true if the motor was stopped
+     */
+    static bool cancelMove(uint8_t motorIndex);
+
+    /**
+     * Discard all moves without writing to the motors
+     * (used by emergency stop, which forces the outputs low itself)
+     */
+    static void cancelAll();
+
+    /**
+     * Check if a motor has a move in progress
+     */
+    static bool isMoving(uint8_t motorIndex);
+
+    /**
+     * Check if a motor's last move was stopped before its deadline
+     */
+    static bool wasCancelled(uint8_t motorIndex);
+
+    /**
+     * Number of motors currently running under executor control
+     */
+    static uint8_t getActiveCount();
+
+    /**
+     * Check if no moves are in progress
+     */
+    static bool isIdle();
+
+    /**
+     * Block until a motor's move has finished, ticking the executor
+     * @return true if the move completed, false if it was cancelled
+     */
+    static bool waitForMotor(uint8_t motorIndex);
+
+    /**
+     * Select timer-stop (esp_timer callback) or loop-stop (tick()) mode
+     * Only affects moves started afterwards.
+     */
+    static void setTimerStopEnabled(bool enabled);
+
+    /**
+     * Check if moves are stopped from the hardware timer
+     */
+    static bool isTimerStopEnabled();
+
+    /**
+     * Get a motor's last completed move timing
+     * @param commandedMs Receives the requested run time
+     * @param actualUs Receives the measured on-time (start write to stop write)
+     * @return false if the motor has not completed a move yet
+     */
+    static bool getLastMoveTiming(uint8_t motorIndex, uint16_t& commandedMs, uint32_t& actualUs);
+
+    /**
+     * Histogram of |actual - commanded| on-time for completed moves
+     */
+    static const LatencyHistogram& getJitterHistogram();
+
+    /**
+     * Current stop-write compensation subtracted from each timer delay
+     */
+    static uint32_t getTimerLeadUs();
+
+    /**
+     * Clear the jitter histogram
+     */
+    static void resetTimingStats();
+
+    /**
+     * Print timing mode, compensation and jitter histogram
+     */
+    static void printTimingStats();
+
+private:
+    static TimedMove moves[NUM_MOTORS];
+    static uint8_t activeCount;
+    static bool timerStopEnabled;
+    static uint32_t timerLeadUs;
+    static LatencyHistogram jitterHistogram;
+
+    /**
+     * Release a motor's slot once it has been stopped at the end of its move
+     */
+    static void completeMove(uint8_t motorIndex);
+
+    /**
+     * Arm the stop timer for a move just started
+     * @return true if the timer is armed
+     */
+    static bool armStopTimer(uint8_t motorIndex);
+
+    /**
+     * Disarm a motor's stop timer (no-op if not running)
+     */
+    static void disarmStopTimer(uint8_t motorIndex);
+
+    /**
+     * esp_timer callback: stop the motor and record its on-time
+     * @param arg Motor index
+     */
+    static void onStopTimer(void* arg);
+};
+
+#endif // MOTION_EXECUTOR_H
@@ -0,0 +1,377 @@
+/**
+ * Motion Job Queue Implementation
+ */
+
+#include "MotionJobQueue.h"
+#include "MotionExecutor.h"
+#include "../utils/Clock.h"
+#include "../core/StateManager.h"
+#include "../utils/Logger.h"
+
+// Static member initialization
+MotionJob MotionJobQueue::jobs[MOTION_JOB_SLOTS];
+MotionJobQueue::StagedJob MotionJobQueue::staged[MOTION_JOB_STAGING_SLOTS];
+std::atomic<bool> MotionJobQueue::stagedBusy[MOTION_JOB_STAGING_SLOTS] = {};
+std::atomic<uint16_t> MotionJobQueue::nextId(1);
+int8_t MotionJobQueue::runningSlot = -1;
+portMUX_TYPE MotionJobQueue::publishMux = portMUX_INITIALIZER_UNLOCKED;
+
+void MotionJobQueue::begin() {
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        jobs[s].id = 0;
+        jobs[s].state = JOB_EMPTY;
+        jobs[s].moveCount = 0;
+        jobs[s].finishedCount = 0;
+        jobs[s].startedAt = 0;
+        jobs[s].finishedAt = 0;
+    }
+    for (uint8_t s = 0; s < MOTION_JOB_STAGING_SLOTS; s++) {
+        stagedBusy[s].store(false, std::memory_order_relaxed);
+    }
+    nextId.store(1, std::memory_order_relaxed);
+    runningSlot = -1;
+}
+
+uint16_t MotionJobQueue::submit(const JobMove* moves, uint8_t count) {
+    if (!movesValid(moves, count)) {
+        return 0;
+    }
+    return queueJob(allocateId(), moves, count);
+}
+
+int8_t MotionJobQueue::stage(const JobMove* moves, uint8_t count, uint16_t& jobId) {
+    if (!movesValid(moves, count)) {
+        return -1;
+    }
+
+    for (uint8_t s = 0; s < MOTION_JOB_STAGING_SLOTS; s++) {
+        bool expected = false;
+        if (!stagedBusy[s].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            continue;
+        }
+
+        // Published to the motion task by the command queue push
+        StagedJob& job = staged[s];
+        job.id = allocateId();
+        job.moveCount = count;
+        for (uint8_t i = 0; i < count; i++) {
+            job.moves[i] = moves[i];
+        }
+        jobId = job.id;
+        return s;
+    }
+
+    Logger::warning(CAT_TEST, "Motion job staging full");
+    return -1;
+}
+
+uint16_t MotionJobQueue::submitStaged(uint8_t slot) {
+    if (slot >= MOTION_JOB_STAGING_SLOTS || !stagedBusy[slot].load(std::memory_order_acquire)) {
+        return 0;
+    }
+
+    const StagedJob& job = staged[slot];
+    uint16_t id = queueJob(job.id, job.moves, job.moveCount);
+    discardStaged(slot);
+    return id;
+}
+
+void MotionJobQueue::discardStaged(uint8_t slot) {
+    if (slot < MOTION_JOB_STAGING_SLOTS) {
+        stagedBusy[slot].store(false, std::memory_order_release);
+    }
+}
+
+bool MotionJobQueue::movesValid(const JobMove* moves, uint8_t count) {
+    if (count == 0 || count > MOTION_JOB_MAX_MOVES) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (moves[i].motor >= NUM_MOTORS ||
+            (moves[i].direction != MOTOR_FORWARD && moves[i].direction != MOTOR_REVERSE) ||
+            moves[i].durationMs > MAX_RUN_TIME_MS ||
+            moves[i].offsetMs > MOTION_JOB_MAX_OFFSET_MS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint16_t MotionJobQueue::allocateId() {
+    // IDs wrap but never reuse 0, which marks "no job"
+    uint16_t id = nextId.load(std::memory_order_relaxed);
+    uint16_t next;
+    do {
+        next = (id == 0xFFFF) ? 1 : id + 1;
+    } while (!nextId.compare_exchange_weak(id, next, std::memory_order_relaxed));
+    return id;
+}
+
+uint16_t MotionJobQueue::queueJob(uint16_t id, const JobMove* moves, uint8_t count) {
+    int8_t slot = findFreeSlot();
+    if (slot < 0) {
+        Logger::warning(CAT_TEST, "Motion job queue full");
+        return 0;
+    }
+
+    MotionJob& job = jobs[slot];
+    job.id = id;
+    job.moveCount = count;
+    job.finishedCount = 0;
+    job.startedAt = 0;
+    job.finishedAt = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        job.moves[i] = moves[i];
+        job.moves[i].state = MOVE_PENDING;
+    }
+
+    // Publish last: web status queries only read a slot's moves once it is queued
+    portENTER_CRITICAL(&publishMux);
+    job.state = JOB_QUEUED;
+    portEXIT_CRITICAL(&publishMux);
+
+    Logger::logf(LOG_INFO, CAT_TEST, "Motion job %u queued (%d moves)", job.id, count);
+    return job.id;
+}
+
+void MotionJobQueue::service() {
+    if (!isBusy()) {
+        return;
+    }
+
+    // Emergency stop discards every job - the outputs are already forced low
+    if (MotorController::isEmergencyStopped()) {
+        for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+            MotionJob& job = jobs[s];
+            if (job.state != JOB_QUEUED && job.state != JOB_RUNNING) {
+                continue;
+            }
+            for (uint8_t i = 0; i < job.moveCount; i++) {
+                if (job.moves[i].state == MOVE_PENDING) {
+                    job.moves[i].state = MOVE_SKIPPED;
+                } else if (job.moves[i].state == MOVE_RUNNING) {
+                    job.moves[i].state = MOVE_DONE;
+                }
+            }
+            job.finishedCount = job.moveCount;
+            job.state = JOB_CANCELLED;
+            job.finishedAt = Clock::nowMillis();
+            Logger::logf(LOG_WARNING, CAT_TEST, "Motion job %u cancelled by emergency stop", job.id);
+        }
+        runningSlot = -1;
+        return;
+    }
+
+    if (runningSlot < 0) {
+        startNextJob();
+        if (runningSlot < 0) {
+            return;
+        }
+    }
+
+    MotionJob& job = jobs[runningSlot];
+    uint64_t elapsed = Clock::nowMillis() - job.startedAt;
+
+    // Retire finished moves before starting new ones, so a later move on
+    // the same motor never hides the end of an earlier one
+    for (uint8_t i = 0; i < job.moveCount; i++) {
+        JobMove& move = job.moves[i];
+        if (move.state == MOVE_RUNNING && !MotionExecutor::isMoving(move.motor)) {
+            move.state = MOVE_DONE;
+            job.finishedCount++;
+        }
+    }
+
+    for (uint8_t i = 0; i < job.moveCount; i++) {
+        JobMove& move = job.moves[i];
+        if (move.state != MOVE_PENDING || elapsed < move.offsetMs ||
+            MotionExecutor::isMoving(move.motor)) {
+            continue;
+        }
+
+        if (MotionExecutor::startMove(move.motor, move.direction, move.durationMs)) {
+            move.state = MOVE_RUNNING;
+        } else {
+            Logger::logf(LOG_ERROR, CAT_TEST, "Motion job %u: motor %d failed to start",
+                         job.id, move.motor);
+            move.state = MOVE_FAILED;
+            job.finishedCount++;
+        }
+    }
+
+    if (job.finishedCount >= job.moveCount) {
+        finishJob(job, JOB_COMPLETE);
+    }
+}
+
+bool MotionJobQueue::cancel(uint16_t jobId) {
+    if (jobId == 0) {
+        return false;
+    }
+
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        MotionJob& job = jobs[s];
+        if (job.id != jobId) {
+            continue;
+        }
+        if (job.state != JOB_QUEUED && job.state != JOB_RUNNING) {
+            return false;
+        }
+
+        for (uint8_t i = 0; i < job.moveCount; i++) {
+            JobMove& move = job.moves[i];
+            if (move.state == MOVE_PENDING) {
+                move.state = MOVE_SKIPPED;
+            } else if (move.state == MOVE_RUNNING) {
+                MotionExecutor::cancelMove(move.motor);
+                move.state = MOVE_DONE;
+            }
+        }
+        job.finishedCount = job.moveCount;
+
+        Logger::logf(LOG_INFO, CAT_TEST, "Motion job %u cancelled", job.id);
+        finishJob(job, JOB_CANCELLED);
+        return true;
+    }
+
+    return false;
+}
+
+const MotionJob* MotionJobQueue::getJob(uint16_t jobId) {
+    if (jobId == 0) {
+        return nullptr;
+    }
+
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        if (jobs[s].id == jobId) {
+            return &jobs[s];
+        }
+    }
+    return nullptr;
+}
+
+const MotionJob& MotionJobQueue::getSlot(uint8_t slot) {
+    if (slot >= MOTION_JOB_SLOTS) {
+        slot = 0;
+    }
+    return jobs[slot];
+}
+
+bool MotionJobQueue::isBusy() {
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        if (jobs[s].state == JOB_QUEUED || jobs[s].state == JOB_RUNNING) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* MotionJobQueue::getStateName(MotionJobState state) {
+    switch (state) {
+        case JOB_EMPTY:     return "empty";
+        case JOB_QUEUED:    return "queued";
+        case JOB_RUNNING:   return "running";
+        case JOB_COMPLETE:  return "complete";
+        case JOB_CANCELLED: return "cancelled";
+        default:            return "unknown";
+    }
+}
+
+const char* MotionJobQueue::getMoveStateName(JobMoveState state) {
+    switch (state) {
+        case MOVE_PENDING:  return "pending";
+        case MOVE_RUNNING:  return "running";
+        case MOVE_DONE:     return "done";
+        case MOVE_FAILED:   return "failed";
+        case MOVE_SKIPPED:  return "skipped";
+        default:            return "unknown";
+    }
+}
+
+void MotionJobQueue::printJobs() {
+    Logger::info(CAT_TEST, "Motion jobs:");
+
+    bool any = false;
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        const MotionJob& job = jobs[s];
+        if (job.state == JOB_EMPTY) {
+            continue;
+        }
+        any = true;
+        Logger::logf(LOG_INFO, CAT_TEST, "  Job %5u: %-9s %2d/%2d moves finished",
+                     job.id, getStateName(job.state), job.finishedCount, job.moveCount);
+    }
+
+    if (!any) {
+        Logger::info(CAT_TEST, "  (none)");
+    }
+}
+
+int8_t MotionJobQueue::findFreeSlot() {
+    int8_t oldest = -1;
+
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        if (jobs[s].state == JOB_EMPTY) {
+            return s;
+        }
+        if (jobs[s].state == JOB_QUEUED || jobs[s].state == JOB_RUNNING) {
+            continue;
+        }
+        if (oldest < 0 || jobs[s].finishedAt < jobs[oldest].finishedAt) {
+            oldest = s;
+        }
+    }
+
+    return oldest;
+}
+
+void MotionJobQueue::startNextJob() {
+    // Jobs share the TESTING state; wait while anything else owns the motors
+    SystemState state = StateManager::getState();
+    if (state != STATE_READY && state != STATE_TESTING) {
+        return;
+    }
+
+    int8_t next = -1;
+    for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+        if (jobs[s].state != JOB_QUEUED) {
+            continue;
+        }
+        // Lowest ID first, allowing for wrap-around
+        if (next < 0 || (int16_t)(jobs[s].id - jobs[next].id) < 0) {
+            next = s;
+        }
+    }
+
+    if (next < 0) {
+        return;
+    }
+
+    MotionJob& job = jobs[next];
+    job.state = JOB_RUNNING;
+    job.startedAt = Clock::nowMillis();
+    runningSlot = next;
+
+    StateManager::setState(STATE_TESTING);
+    Logger::logf(LOG_INFO, CAT_TEST, "Motion job %u started", job.id);
+}
+
+void MotionJobQueue::finishJob(MotionJob& job, MotionJobState state) {
+    job.state = state;
+    job.finishedAt = Clock::nowMillis();
+
+    if (runningSlot >= 0 && &jobs[runningSlot] == &job) {
+        runningSlot = -1;
+    }
+
+    if (state == JOB_COMPLETE) {
+        Logger::logf(LOG_INFO, CAT_TEST, "Motion job %u complete in %lu ms",
+                     job.id, (unsigned long)(job.finishedAt - job.startedAt));
+    }
+
+    // Hand the motors back once nothing else is queued or moving
+    if (!isBusy() && MotionExecutor::isIdle() && StateManager::getState() == STATE_TESTING) {
+        StateManager::setState(STATE_READY);
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * Motion Job Queue
+ *
+ * Batches of timed moves submitted in one request. Each move names a
+ * motor, direction, run time and an optional start offset from the start
+ * of the job. Jobs run one at a time in submission order; service()
+ * (called every motion pass) starts each move once its offset has passed and
+ * its motor is idle, and hands it to MotionExecutor. Finished jobs stay
+ * in their slot so their result can be queried until the slot is reused.
+ *
+ * Only the motion task queues jobs. Other tasks stage a job and post
+ * MOTION_COMMAND_SUBMIT_JOB with the staging slot; the job ID is reserved
+ * when it is staged so the caller can report it straight away.
+ */
+
+#ifndef MOTION_JOB_QUEUE_H
+#define MOTION_JOB_QUEUE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <atomic>
+#include "../config.h"
+#include "MotorController.h"
+
+// Lifecycle of a job
+enum MotionJobState {
+    JOB_EMPTY,      // Slot unused
+    JOB_QUEUED,     // Waiting for earlier jobs to finish
+    JOB_RUNNING,    // Moves being started / in progress
+    JOB_COMPLETE,   // Every move has finished or failed to start
+    JOB_CANCELLED   // Cancelled by request or emergency stop
+};
+
+// Lifecycle of one move within a job
+enum JobMoveState {
+    MOVE_PENDING,   // Waiting for its offset or for the motor to be free
+    MOVE_RUNNING,   // Handed to MotionExecutor
+    MOVE_DONE,      // Motor stopped at the end of the move
+    MOVE_FAILED,    // Motor could not be started
+    MOVE_SKIPPED    // Job cancelled before the move started
+};
+
+/**
+ * One move within a job
+ */
+struct JobMove {
+    uint8_t motor;              // Motor number (0-23)
+    MotorDirection direction;   // MOTOR_FORWARD or MOTOR_REVERSE
+    uint16_t durationMs;        // Run time
+    uint16_t offsetMs;          // Start offset from the start of the job
+    JobMoveState state;
+};
+
+/**
+ * A submitted batch of moves
+ */
+struct MotionJob {
+    uint16_t id;                // 0 = slot empty
+    MotionJobState state;
+    uint8_t moveCount;
+    uint8_t finishedCount;      // Moves done, failed or skipped
+    uint64_t startedAt;         // Clock::nowMillis() when the job started running
+    uint64_t finishedAt;        // Clock::nowMillis() when the job completed or was cancelled
+    JobMove moves[MOTION_JOB_MAX_MOVES];
+};
+
+class MotionJobQueue {
+public:
+    /**
+     * Initialize queue with all slots empty
+     */
+    static void begin();
+
+    /**
+     * Queue a job (motion task only)
+     * @param moves Moves to run (copied)
+     * @param count Number of moves (1 - MOTION_JOB_MAX_MOVES)
+     * @return Job ID, or 0 if the queue is full or the moves are invalid
+     */
+    static uint16_t submit(const JobMove* moves, uint8_t count);
+
+    /**
+     * Stage a job for the motion task to queue (any task)
+     * @param moves Moves to run (copied)
+     * @param count Number of moves (1 - MOTION_JOB_MAX_MOVES)
+     * @param jobId Set to the ID the job gets when it is queued
+     * @return Staging slot to post with MOTION_COMMAND_SUBMIT_JOB, or -1 if
+     *         the moves are invalid or every staging slot is taken
+     */
+    static int8_t stage(const JobMove* moves, uint8_t count, uint16_t& jobId);
+
+    /**
+     * Queue a staged job and free its staging slot (motion task only)
+     * @return Job ID, or 0 if the queue is full
+     */
+    static uint16_t submitStaged(uint8_t slot);
+
+    /**
+     * Free a staging slot without queueing its job
+     */
+    static void discardStaged(uint8_t slot);
+
+    /**
+     * Start due moves and track completion (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Cancel a queued or running job, stopping its running motors
+     * @return true if the job was found and was not already finished
+     */
+    static bool cancel(uint16_t jobId);
+
+    /**
+     * Get a job by ID
+     * @return nullptr if the job is unknown or its slot has been reused
+     */
+    static const MotionJob* getJob(uint16_t jobId);
+
+    /**
+     * Get a slot by index (0 - MOTION_JOB_SLOTS-1), for listing
+     */
+    static const MotionJob& getSlot(uint8_t slot);
+
+    /**
+     * Check if any job is queued or running
+     */
+    static bool isBusy();
+
+    /**
+     * Name of a job state
+     */
+    static const char* getStateName(MotionJobState state);
+
+    /**
+     * Name of a move state
+     */
+    static const char* getMoveStateName(JobMoveState state);
+
+    /**
+     * Print all jobs
+     */
+    static void printJobs();
+
+private:
+    /**
+     * A job waiting in a staging slot
+     */
+    struct StagedJob {
+        uint16_t id;
+        uint8_t moveCount;
+        JobMove moves[MOTION_JOB_MAX_MOVES];
+    };
+
+    static MotionJob jobs[MOTION_JOB_SLOTS];
+    static StagedJob staged[MOTION_JOB_STAGING_SLOTS];
+    static std::atomic<bool> stagedBusy[MOTION_JOB_STAGING_SLOTS];
+    static std::atomic<uint16_t> nextId;
+    static int8_t runningSlot;
+    static portMUX_TYPE publishMux;     // Orders a queued slot's contents before its state
+
+    /**
+     * Check every move's motor, direction, run time and offset
+     */
+    static bool movesValid(const JobMove* moves, uint8_t count);
+
+    /**
+     * Take the next job ID (never 0)
+     */
+    static uint16_t allocateId();
+
+    /**
+     * Queue a job under an ID that has already been taken
+     */
+    static uint16_t queueJob(uint16_t id, const JobMove* moves, uint8_t count);
+
+    /**
+     * Find a slot for a new job (empty, else the oldest finished one)
+     * @return Slot index, or -1 if every slot is queued or running
+     */
+    static int8_t findFreeSlot();
+
+    /**
+     * Pick the queued job with the lowest ID and start it
+     */
+    static void startNextJob();
+
+    /**
+     * Mark a job finished and release the TESTING state if idle
+     */
+    static void finishJob(MotionJob& job, MotionJobState state);
+};
+
+#endif // MOTION_JOB_QUEUE_H
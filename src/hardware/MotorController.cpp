@@ -3,11 +3,27 @@
  */
 
 #include "MotorController.h"
+#include "MotionExecutor.h"
+#include "TideSequencePlanner.h"
+#include "MotorSpeedModel.h"
+#include "MotorTelemetry.h"
+#include "StopLatencyMonitor.h"
+#include "PinTopology.h"
+#include "../utils/Clock.h"
 #include "../data/TideData.h"
 #include "../core/StateManager.h"
+#include "../core/RehomeScheduler.h"
+#include "../core/RollingWindow.h"
+#include "../core/TaskManager.h"
 
 bool MotorController::initialized = false;
-bool MotorController::emergencyStop = false;
+volatile bool MotorController::emergencyStop = false;
+HomingJob MotorController::homingJobs[NUM_MOTORS];
+uint16_t MotorController::outputImage[NUM_MOTOR_BOARDS] = {0};
+bool MotorController::outputDirty[NUM_MOTOR_BOARDS] = {false};
+SemaphoreHandle_t MotorController::outputMutex = nullptr;
+int32_t MotorController::positionMs[NUM_MOTORS] = {0};
+bool MotorController::positionKnown[NUM_MOTORS] = {false};
 
 bool MotorController::begin() {
     Logger::info(CAT_MOTOR, "Initializing Motor Controller...");
@@ -15,6 +31,10 @@ bool MotorController::begin() {
     // Motor boards should already be initialized by GPIOExpander
     // We just ensure all motors are stopped
 
+    if (outputMutex == nullptr) {
+        outputMutex = xSemaphoreCreateRecursiveMutex();
+    }
+
     emergencyStopAll();
     clearEmergencyStop();  // Clear the flag after stopping
 
@@ -33,29 +53,85 @@ bool MotorController::isValidIndex(uint8_t motorIndex) {
     return true;
 }
 
-bool MotorController::setMotorPins(uint8_t motorIndex, uint8_t in1, uint8_t in2) {
-    if (!initialized || !isValidIndex(motorIndex)) {
-        return false;
+void MotorController::stageMotorPins(uint8_t motorIndex, uint8_t in1, uint8_t in2) {
+    uint8_t board = PinTopology::MOTORS.board[motorIndex];
+    uint16_t in1Mask = PinTopology::MOTORS.in1Mask[motorIndex];
+    uint16_t in2Mask = PinTopology::MOTORS.in2Mask[motorIndex];
+
+    uint16_t image = outputImage[board] & ~(in1Mask | in2Mask);
+    if (in1) image |= in1Mask;
+    if (in2) image |= in2Mask;
+
+    if (image != outputImage[board]) {
+        outputImage[board] = image;
+        outputDirty[board] = true;
     }
+}
 
-    // Get the pin mapping for this motor
-    MotorPinMap pinMap = MOTOR_PIN_MAP[motorIndex];
+bool MotorController::commitBoard(uint8_t boardIndex) {
+    uint8_t address = PinTopology::MOTOR_BOARD_ADDRESS[boardIndex];
 
-    // Set IN1 pin
-    if (!GPIOExpander::digitalWrite(pinMap.mcpAddress, pinMap.in1Pin, in1)) {
-        Logger::logf(LOG_ERROR, CAT_MOTOR, "Failed to set IN1 for motor %d", motorIndex);
-        return false;
+    // A writer that passed its emergency stop check before the stop latched
+    // must not switch a motor back on after the stop has been written
+    if (emergencyStop) {
+        outputImage[boardIndex] = 0;
     }
 
-    // Set IN2 pin
-    if (!GPIOExpander::digitalWrite(pinMap.mcpAddress, pinMap.in2Pin, in2)) {
-        Logger::logf(LOG_ERROR, CAT_MOTOR, "Failed to set IN2 for motor %d", motorIndex);
+    if (!GPIOExpander::writeGPIOAB(address, outputImage[boardIndex])) {
+        Logger::logf(LOG_ERROR, CAT_MOTOR, "Failed to write motor board 0x%02X", address);
         return false;
     }
 
+    outputDirty[boardIndex] = false;
     return true;
 }
 
+bool MotorController::commitMotorOutputs() {
+    bool success = true;
+
+    lockOutputs();
+    for (uint8_t board = 0; board < NUM_MOTOR_BOARDS; board++) {
+        if (outputDirty[board] && !commitBoard(board)) {
+            success = false;
+        }
+    }
+    unlockOutputs();
+
+    return success;
+}
+
+void MotorController::lockOutputs() {
+    if (outputMutex != nullptr) {
+        xSemaphoreTakeRecursive(outputMutex, portMAX_DELAY);
+    }
+}
+
+void MotorController::unlockOutputs() {
+    if (outputMutex != nullptr) {
+        xSemaphoreGiveRecursive(outputMutex);
+    }
+}
+
+bool MotorController::setMotorPins(uint8_t motorIndex, uint8_t in1, uint8_t in2) {
+    if (!initialized || !isValidIndex(motorIndex)) {
+        return false;
+    }
+
+    // Update IN1/IN2 in the board image and write the whole board at once
+    lockOutputs();
+    stageMotorPins(motorIndex, in1, in2);
+
+    uint8_t board = PinTopology::MOTORS.board[motorIndex];
+    bool success = !outputDirty[board] || commitBoard(board);
+    unlockOutputs();
+
+    if (!success) {
+        Logger::logf(LOG_ERROR, CAT_MOTOR, "Failed to set pins for motor %d", motorIndex);
+    }
+
+    return success;
+}
+
 bool MotorController::setMotorDirection(uint8_t motorIndex, MotorDirection direction) {
     if (emergencyStop) {
         Logger::warning(CAT_MOTOR, "Cannot control motor: Emergency stop active");
@@ -96,38 +172,62 @@ bool MotorController::setMotorDirection(uint8_t motorIndex, MotorDirection direc
     return setMotorPins(motorIndex, in1, in2);
 }
 
-bool MotorController::runMotorForward(uint8_t motorIndex, uint16_t durationMs) {
-    Logger::logf(LOG_INFO, CAT_MOTOR, "Running motor %d FORWARD for %d ms", motorIndex, durationMs);
-
-    if (!setMotorDirection(motorIndex, MOTOR_FORWARD)) {
+bool MotorController::stageMotorDirection(uint8_t motorIndex, MotorDirection direction) {
+    if (!isValidIndex(motorIndex)) {
         return false;
     }
 
-    delay(durationMs);
+    switch (direction) {
+        case MOTOR_STOP:    stageMotorPins(motorIndex, LOW, LOW);  return true;
+        case MOTOR_FORWARD: stageMotorPins(motorIndex, HIGH, LOW); return true;
+        case MOTOR_REVERSE: stageMotorPins(motorIndex, LOW, HIGH); return true;
+        default:
+            Logger::logf(LOG_ERROR, CAT_MOTOR, "Invalid direction: %d", direction);
+            return false;
+    }
+}
 
-    if (!stopMotor(motorIndex)) {
+bool MotorController::setMotorDirections(uint32_t motorMask, MotorDirection direction) {
+    if (emergencyStop) {
+        Logger::warning(CAT_MOTOR, "Cannot control motors: Emergency stop active");
         return false;
     }
 
-    Logger::logf(LOG_INFO, CAT_MOTOR, "Motor %d forward run complete", motorIndex);
-    return true;
-}
+    if (!initialized) {
+        return false;
+    }
 
-bool MotorController::runMotorReverse(uint8_t motorIndex, uint16_t durationMs) {
-    Logger::logf(LOG_INFO, CAT_MOTOR, "Running motor %d REVERSE for %d ms", motorIndex, durationMs);
+    lockOutputs();
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if ((motorMask & (1UL << i)) && !stageMotorDirection(i, direction)) {
+            unlockOutputs();
+            return false;
+        }
+    }
 
-    if (!setMotorDirection(motorIndex, MOTOR_REVERSE)) {
+    bool success = commitMotorOutputs();
+    unlockOutputs();
+
+    Logger::logf(LOG_DEBUG, CAT_MOTOR, "Motors 0x%06lX: %s",
+                 (unsigned long)motorMask, getDirectionString(direction));
+
+    return success;
+}
+
+bool MotorController::runMotorForward(uint8_t motorIndex, uint16_t durationMs) {
+    if (!MotionExecutor::startMove(motorIndex, MOTOR_FORWARD, durationMs)) {
         return false;
     }
 
-    delay(durationMs);
+    return MotionExecutor::waitForMotor(motorIndex);
+}
 
-    if (!stopMotor(motorIndex)) {
+bool MotorController::runMotorReverse(uint8_t motorIndex, uint16_t durationMs) {
+    if (!MotionExecutor::startMove(motorIndex, MOTOR_REVERSE, durationMs)) {
         return false;
     }
 
-    Logger::logf(LOG_INFO, CAT_MOTOR, "Motor %d reverse run complete", motorIndex);
-    return true;
+    return MotionExecutor::waitForMotor(motorIndex);
 }
 
 bool MotorController::stopMotor(uint8_t motorIndex) {
@@ -136,15 +236,44 @@ bool MotorController::stopMotor(uint8_t motorIndex) {
 }
 
 void MotorController::emergencyStopAll() {
+    // Outputs first; logging and bookkeeping wait until every board is off
+    haltAllOutputs();
+
+    // Discard pending timed moves - outputs are already forced low
+    MotionExecutor::cancelAll();
+
     Logger::warning(CAT_MOTOR, "*** EMERGENCY STOP ACTIVATED ***");
+    Logger::info(CAT_MOTOR, "All motors stopped");
+}
+
+bool MotorController::haltAllOutputs() {
+    // Latch first so no other writer can start a motor from here on
     emergencyStop = true;
 
-    // Force all motors to stop immediately
-    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
-        setMotorPins(i, LOW, LOW);
+    bool locked = (outputMutex == nullptr) ||
+                  xSemaphoreTakeRecursive(outputMutex, pdMS_TO_TICKS(ESTOP_LOCK_TIMEOUT_MS)) == pdTRUE;
+
+    bool success = writeAllOff();
+
+    if (!locked) {
+        // Another task is mid-write and its write may land after ours;
+        // stop again as soon as it lets go of the outputs
+        lockOutputs();
+        success = writeAllOff();
     }
+    unlockOutputs();
 
-    Logger::info(CAT_MOTOR, "All motors stopped");
+    return success;
+}
+
+bool MotorController::writeAllOff() {
+    bool success = true;
+    for (uint8_t board = 0; board < NUM_MOTOR_BOARDS; board++) {
+        outputImage[board] = 0;
+        outputDirty[board] = false;
+        success &= GPIOExpander::writeOutputsNow(PinTopology::MOTOR_BOARD_ADDRESS[board], 0);
+    }
+    return success;
 }
 
 bool MotorController::isEmergencyStopped() {
@@ -156,118 +285,114 @@ void MotorController::clearEmergencyStop() {
     Logger::info(CAT_MOTOR, "Emergency stop cleared - operations resumed");
 }
 
-bool MotorController::releaseFromSwitch(uint8_t motorIndex) {
-    // Check if switch is already triggered
-    if (SwitchReader::isSwitchTriggered(motorIndex)) {
-        Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d switch already triggered, releasing...", motorIndex);
-
-        // Run forward briefly to release
-        if (!setMotorDirection(motorIndex, MOTOR_FORWARD)) {
-            return false;
-        }
+int32_t MotorController::getPosition(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return 0;
+    }
+    return positionMs[motorIndex];
+}
 
-        delay(SWITCH_RELEASE_INITIAL_MS);
+bool MotorController::isPositionKnown(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return false;
+    }
+    return positionKnown[motorIndex];
+}
 
-        if (!stopMotor(motorIndex)) {
-            return false;
-        }
+void MotorController::recordTravel(uint8_t motorIndex, MotorDirection direction, uint32_t runMs) {
+    if (motorIndex >= NUM_MOTORS) {
+        return;
+    }
 
-        // Verify switch is now released
-        delay(50);  // Brief stabilization delay
-        if (SwitchReader::isSwitchTriggered(motorIndex)) {
-            Logger::logf(LOG_WARNING, CAT_HOMING, "Motor %d switch still triggered after release attempt", motorIndex);
-            return false;
+    int32_t travel = MotorSpeedModel::runTimeToTravel(motorIndex, direction, runMs);
+    RehomeScheduler::recordMove(motorIndex, direction, travel);
+    MotorTelemetry::recordMove(motorIndex, direction, runMs);
+
+    if (direction == MOTOR_FORWARD) {
+        positionMs[motorIndex] += travel;
+    } else if (direction == MOTOR_REVERSE) {
+        // Home is the lower mechanical limit - the estimate cannot go below it
+        positionMs[motorIndex] -= travel;
+        if (positionMs[motorIndex] < 0) {
+            positionMs[motorIndex] = 0;
         }
-
-        Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d switch released successfully", motorIndex);
     }
-
-    return true;
 }
 
-HomingResult MotorController::homeSingleMotor(uint8_t motorIndex) {
-    if (emergencyStop) {
-        Logger::warning(CAT_HOMING, "Cannot home: Emergency stop active");
-        return HOMING_CANCELLED;
-    }
-
-    if (!initialized || !isValidIndex(motorIndex)) {
-        return HOMING_MOTOR_ERROR;
+void MotorController::invalidatePosition(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        return;
     }
+    positionKnown[motorIndex] = false;
+    positionMs[motorIndex] = 0;
+}
 
-    Logger::separator();
-    Logger::logf(LOG_INFO, CAT_HOMING, "Starting homing sequence for motor %d", motorIndex);
+bool MotorController::planMoveToPosition(uint8_t motorIndex, uint16_t targetMs,
+                                         MotorDirection& direction, uint16_t& durationMs) {
+    direction = MOTOR_STOP;
+    durationMs = 0;
 
-    // Step 1: Release switch if already triggered
-    if (!releaseFromSwitch(motorIndex)) {
-        Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to release from switch", motorIndex);
-        return HOMING_SWITCH_ERROR;
+    if (!isValidIndex(motorIndex)) {
+        return false;
     }
 
-    // Step 2: Run motor in reverse until switch triggers
-    Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Running reverse to find limit switch...", motorIndex);
+    // Unhomed motors plan from the same estimate recordTravel() keeps, so
+    // repeated and partial moves converge instead of re-running from 0
+    int32_t delta = (int32_t)targetMs - positionMs[motorIndex];
 
-    if (!setMotorDirection(motorIndex, MOTOR_REVERSE)) {
-        Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to start reverse", motorIndex);
-        return HOMING_MOTOR_ERROR;
+    if (delta >= POSITION_DEADBAND_MS) {
+        direction = MOTOR_FORWARD;
+    } else if (-delta >= POSITION_DEADBAND_MS) {
+        direction = MOTOR_REVERSE;
+        delta = -delta;
+    } else {
+        return true;
     }
 
-    // Step 3: Poll switch with timeout
-    unsigned long startTime = millis();
-    bool switchTriggered = false;
+    uint32_t runMs = MotorSpeedModel::travelToRunTime(motorIndex, direction, delta);
+    durationMs = (runMs > 0xFFFF) ? 0xFFFF : runMs;
 
-    while ((millis() - startTime) < HOMING_TIMEOUT_MS) {
-        // Check for emergency stop
-        if (emergencyStop) {
-            stopMotor(motorIndex);
-            Logger::logf(LOG_WARNING, CAT_HOMING, "Motor %d: Homing cancelled by emergency stop", motorIndex);
-            return HOMING_CANCELLED;
-        }
+    return true;
+}
 
-        // Check switch state
-        if (SwitchReader::isSwitchTriggered(motorIndex)) {
-            switchTriggered = true;
-            Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Limit switch triggered after %lu ms",
-                         motorIndex, millis() - startTime);
-            break;
-        }
+bool MotorController::moveToPosition(uint8_t motorIndex, uint16_t targetMs) {
+    MotorDirection direction;
+    uint16_t durationMs;
 
-        delay(SWITCH_POLL_INTERVAL_MS);
+    if (!planMoveToPosition(motorIndex, targetMs, direction, durationMs)) {
+        return false;
     }
 
-    // Stop motor immediately
-    stopMotor(motorIndex);
-
-    // Step 4: Check if we timed out
-    if (!switchTriggered) {
-        Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: TIMEOUT after %d ms - switch not triggered",
-                     motorIndex, HOMING_TIMEOUT_MS);
-        return HOMING_TIMEOUT;
+    if (durationMs == 0) {
+        Logger::logf(LOG_DEBUG, CAT_MOTOR, "Motor %d already at %u ms", motorIndex, targetMs);
+        return true;
     }
 
-    // Step 5: Back away from switch
-    Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Backing away from switch...", motorIndex);
+    return MotionExecutor::startMove(motorIndex, direction, durationMs);
+}
+
+HomingResult MotorController::homeSingleMotor(uint8_t motorIndex, bool fitSpeeds) {
+    if (emergencyStop) {
+        Logger::warning(CAT_HOMING, "Cannot home: Emergency stop active");
+        return HOMING_CANCELLED;
+    }
 
-    if (!setMotorDirection(motorIndex, MOTOR_FORWARD)) {
-        Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to back away", motorIndex);
+    if (!initialized || !isValidIndex(motorIndex)) {
         return HOMING_MOTOR_ERROR;
     }
 
-    delay(SWITCH_RELEASE_TIME_MS);
+    Logger::separator();
+    Logger::logf(LOG_INFO, CAT_HOMING, "Starting homing sequence for motor %d", motorIndex);
 
-    stopMotor(motorIndex);
+    // Run the homing state machine for just this motor
+    runHomingJobs(1UL << motorIndex, 1, fitSpeeds);
 
-    // Step 6: Verify switch is released
-    delay(50);  // Brief stabilization
-    if (SwitchReader::isSwitchTriggered(motorIndex)) {
-        Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Switch still triggered after backing away", motorIndex);
-        return HOMING_SWITCH_ERROR;
+    HomingResult result = homingJobs[motorIndex].result;
+    if (result == HOMING_SUCCESS) {
+        Logger::separator();
     }
 
-    Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: HOMING COMPLETE", motorIndex);
-    Logger::separator();
-
-    return HOMING_SUCCESS;
+    return result;
 }
 
 uint8_t MotorController::homeAllMotors() {
@@ -277,7 +402,7 @@ uint8_t MotorController::homeAllMotors() {
     Logger::separator();
 
     uint8_t successCount = 0;
-    unsigned long totalStartTime = millis();
+    uint64_t totalStartTime = Clock::nowMillis();
 
     for (uint8_t i = 0; i < NUM_MOTORS; i++) {
         if (emergencyStop) {
@@ -285,7 +410,8 @@ uint8_t MotorController::homeAllMotors() {
             break;
         }
 
-        HomingResult result = homeSingleMotor(i);
+        // Release samples from every motor are fitted together at the end
+        HomingResult result = homeSingleMotor(i, false);
 
         if (result == HOMING_SUCCESS) {
             successCount++;
@@ -296,23 +422,389 @@ uint8_t MotorController::homeAllMotors() {
 
         // Pause between motors (except after last motor)
         if (i < NUM_MOTORS - 1) {
-            delay(PAUSE_BETWEEN_MOTORS_MS);
+            TaskManager::waitInOperation(PAUSE_BETWEEN_MOTORS_MS);
         }
     }
 
-    unsigned long totalTime = millis() - totalStartTime;
+    uint32_t totalTime = (uint32_t)(Clock::nowMillis() - totalStartTime);
+
+    MotorSpeedModel::fitForwardSpeeds();
+    MotorSpeedModel::saveIfChanged();
 
     Logger::separator();
     Logger::info(CAT_HOMING, "=== HOMING SEQUENCE COMPLETE ===");
     Logger::logf(LOG_INFO, CAT_HOMING, "Results: %d/%d motors homed successfully", successCount, NUM_MOTORS);
-    Logger::logf(LOG_INFO, CAT_HOMING, "Total time: %lu seconds", totalTime / 1000);
+    Logger::logf(LOG_INFO, CAT_HOMING, "Total time: %lu seconds", (unsigned long)(totalTime / 1000));
     Logger::separator();
 
     return successCount;
 }
 
-bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
-    // Validate inputs
+uint8_t MotorController::homeMotorsConcurrent(uint32_t motorMask, uint8_t maxConcurrent,
+                                              HomingResult* results) {
+    if (emergencyStop) {
+        Logger::warning(CAT_HOMING, "Cannot home: Emergency stop active");
+        return 0;
+    }
+
+    if (!initialized) {
+        return 0;
+    }
+
+    if (maxConcurrent == 0) {
+        maxConcurrent = 1;
+    }
+
+    uint8_t requested = 0;
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (motorMask & (1UL << i)) requested++;
+    }
+
+    Logger::separator();
+    Logger::info(CAT_HOMING, "=== STARTING CONCURRENT HOMING SEQUENCE ===");
+    Logger::logf(LOG_INFO, CAT_HOMING, "Homing %d motors, up to %d at a time...",
+                 requested, maxConcurrent);
+    Logger::separator();
+
+    uint64_t totalStartTime = Clock::nowMillis();
+    uint8_t successCount = runHomingJobs(motorMask, maxConcurrent);
+    uint32_t totalTime = (uint32_t)(Clock::nowMillis() - totalStartTime);
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (!(motorMask & (1UL << i))) {
+            continue;
+        }
+
+        HomingResult result = homingJobs[i].result;
+        if (results != nullptr) {
+            results[i] = result;
+        }
+
+        if (result != HOMING_SUCCESS) {
+            Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d homing failed: %s",
+                         i, getHomingResultString(result));
+        }
+    }
+
+    Logger::separator();
+    Logger::info(CAT_HOMING, "=== CONCURRENT HOMING COMPLETE ===");
+    Logger::logf(LOG_INFO, CAT_HOMING, "Results: %d/%d motors homed successfully", successCount, requested);
+    Logger::logf(LOG_INFO, CAT_HOMING, "Total time: %lu ms", (unsigned long)totalTime);
+    Logger::separator();
+
+    return successCount;
+}
+
+uint8_t MotorController::homeAllMotorsConcurrent(uint8_t maxConcurrent, HomingResult* results) {
+    uint32_t allMotors = (1UL << NUM_MOTORS) - 1;
+    return homeMotorsConcurrent(allMotors, maxConcurrent, results);
+}
+
+uint8_t MotorController::runHomingJobs(uint32_t motorMask, uint8_t maxConcurrent, bool fitSpeeds) {
+    uint8_t pendingCount = 0;
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (motorMask & (1UL << i)) {
+            homingJobs[i].phase = HOMING_PHASE_PENDING;
+            homingJobs[i].result = HOMING_CANCELLED;
+            homingJobs[i].phaseStart = 0;
+            homingJobs[i].startedAt = 0;
+            homingJobs[i].startPositionMs = -1;
+            homingJobs[i].releaseMs = 0;
+            pendingCount++;
+        }
+    }
+
+    uint8_t activeCount = 0;
+    uint8_t successCount = 0;
+
+    while (pendingCount > 0 || activeCount > 0) {
+        uint64_t now = Clock::nowMillis();
+
+        // Jobs read the sampler's debounced state; without it, one bulk read per pass
+        SwitchReader::sampleIfNoSampler();
+
+        // Fill free slots with pending motors (lowest index first)
+        for (uint8_t i = 0; i < NUM_MOTORS && pendingCount > 0 && activeCount < maxConcurrent; i++) {
+            if ((motorMask & (1UL << i)) && homingJobs[i].phase == HOMING_PHASE_PENDING) {
+                pendingCount--;
+                activeCount++;
+                startHomingJob(i, now);
+            }
+        }
+
+        // Advance every active job by one step
+        for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+            if (!(motorMask & (1UL << i))) {
+                continue;
+            }
+
+            HomingJob& job = homingJobs[i];
+            if (job.phase == HOMING_PHASE_PENDING || job.phase == HOMING_PHASE_DONE) {
+                continue;
+            }
+
+            if (emergencyStop) {
+                // Emergency stop already forced all outputs low
+                Logger::logf(LOG_WARNING, CAT_HOMING, "Motor %d: Homing cancelled by emergency stop", i);
+                finishHomingJob(i, HOMING_CANCELLED);
+            } else {
+                stepHomingJob(i, now);
+            }
+
+            if (job.phase == HOMING_PHASE_DONE) {
+                activeCount--;
+                if (job.result == HOMING_SUCCESS) {
+                    successCount++;
+                }
+            }
+        }
+
+        // Pending motors are cancelled as a group on emergency stop
+        if (emergencyStop && pendingCount > 0) {
+            Logger::warning(CAT_HOMING, "Homing sequence aborted by emergency stop");
+            for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+                if ((motorMask & (1UL << i)) && homingJobs[i].phase == HOMING_PHASE_PENDING) {
+                    finishHomingJob(i, HOMING_CANCELLED);
+                }
+            }
+            pendingCount = 0;
+        }
+
+        if (activeCount > 0) {
+            // Keep unrelated timed moves stopping on schedule while homing
+            MotionExecutor::tick();
+            TaskManager::waitInOperation(SWITCH_POLL_INTERVAL_MS);
+        }
+    }
+
+    // Fold this run's measurements into the speed model
+    if (fitSpeeds) {
+        MotorSpeedModel::fitForwardSpeeds();
+        MotorSpeedModel::saveIfChanged();
+    }
+
+    return successCount;
+}
+
+void MotorController::startHomingJob(uint8_t motorIndex, uint64_t now) {
+    HomingJob& job = homingJobs[motorIndex];
+    job.phaseStart = now;
+    job.startedAt = now;
+
+    // Homing takes over the motor from any timed move in progress
+    if (MotionExecutor::isMoving(motorIndex)) {
+        MotionExecutor::cancelMove(motorIndex);
+    }
+    // Remember where the motor was believed to be - the seek time measures it
+    job.startPositionMs = positionKnown[motorIndex] ? positionMs[motorIndex] : -1;
+    job.releaseMs = 0;
+    invalidatePosition(motorIndex);
+
+    // Step 1: Release switch if already triggered
+    if (SwitchReader::isTriggeredDebounced(motorIndex)) {
+        Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d switch already triggered, releasing...", motorIndex);
+        job.startPositionMs = -1;
+
+        if (!setMotorDirection(motorIndex, MOTOR_FORWARD)) {
+            Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to release from switch", motorIndex);
+            finishHomingJob(motorIndex, HOMING_SWITCH_ERROR);
+            return;
+        }
+
+        job.phase = HOMING_PHASE_RELEASE;
+        return;
+    }
+
+    // Step 2: Run motor in reverse until switch triggers
+    Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Running reverse to find limit switch...", motorIndex);
+
+    // Armed before starting so the interrupt path can stop the motor on contact
+    SwitchReader::armStopOnTrigger(motorIndex);
+    job.lastPoll = now;
+
+    if (!setMotorDirection(motorIndex, MOTOR_REVERSE)) {
+        Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to start reverse", motorIndex);
+        finishHomingJob(motorIndex, HOMING_MOTOR_ERROR);
+        return;
+    }
+
+    job.phase = HOMING_PHASE_SEEK;
+}
+
+void MotorController::stepHomingJob(uint8_t motorIndex, uint64_t now) {
+    HomingJob& job = homingJobs[motorIndex];
+    uint32_t elapsed = (uint32_t)(now - job.phaseStart);
+
+    switch (job.phase) {
+        case HOMING_PHASE_RELEASE:
+            if (elapsed >= SWITCH_RELEASE_INITIAL_MS) {
+                stopMotor(motorIndex);
+                MotorTelemetry::recordRun(motorIndex, MOTOR_FORWARD, elapsed);
+                job.phase = HOMING_PHASE_RELEASE_SETTLE;
+                job.phaseStart = now;
+            }
+            break;
+
+        case HOMING_PHASE_RELEASE_SETTLE:
+            // Verify switch is now released, waiting only while it has not settled open
+            if (SwitchReader::isTriggeredDebounced(motorIndex)) {
+                if (elapsed < SWITCH_SETTLE_TIME_MS) {
+                    break;
+                }
+                Logger::logf(LOG_WARNING, CAT_HOMING, "Motor %d switch still triggered after release attempt", motorIndex);
+                Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to release from switch", motorIndex);
+                finishHomingJob(motorIndex, HOMING_SWITCH_ERROR);
+                break;
+            }
+
+            Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d switch released successfully", motorIndex);
+            Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Running reverse to find limit switch...", motorIndex);
+
+            SwitchReader::armStopOnTrigger(motorIndex);
+            job.lastPoll = now;
+
+            if (!setMotorDirection(motorIndex, MOTOR_REVERSE)) {
+                Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to start reverse", motorIndex);
+                finishHomingJob(motorIndex, HOMING_MOTOR_ERROR);
+                break;
+            }
+
+            job.phase = HOMING_PHASE_SEEK;
+            job.phaseStart = now;
+            break;
+
+        case HOMING_PHASE_SEEK: {
+            // Step 3: Wait for the switch with timeout. With interrupts active the
+            // motor is already stopped on contact; polling is only a safety net.
+            bool triggered = false;
+            bool polled = false;
+            uint64_t observedUs = 0;
+            uint64_t stoppedUs = 0;
+
+            if (SwitchReader::interruptsActive() &&
+                SwitchReader::consumeTrigger(motorIndex, observedUs, stoppedUs)) {
+                triggered = true;
+            } else if (!SwitchReader::interruptsActive() ||
+                       now - job.lastPoll >= SWITCH_IRQ_FALLBACK_POLL_MS) {
+                job.lastPoll = now;
+                polled = true;
+                triggered = SwitchReader::isTriggeredDebounced(motorIndex);
+
+                // Contact began at the first sample of the debounced run
+                observedUs = SwitchReader::getEdgeTimeUs(motorIndex);
+                if (observedUs < job.phaseStart * 1000) {
+                    observedUs = Clock::nowMicros();
+                }
+            }
+
+            if (triggered) {
+                SwitchReader::disarmStopOnTrigger(motorIndex);
+                stopMotor(motorIndex);
+
+                if (polled) {
+                    stoppedUs = Clock::nowMicros();
+                }
+                StopLatencyMonitor::record(motorIndex, polled ? STOP_SOURCE_POLL : STOP_SOURCE_INTERRUPT,
+                                           observedUs, stoppedUs);
+
+                // Time to contact, measured from the interrupt when there was one
+                elapsed = (uint32_t)(observedUs / 1000 - job.phaseStart);
+                Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Limit switch triggered after %lu ms",
+                             motorIndex, (unsigned long)elapsed);
+                MotorTelemetry::recordRun(motorIndex, MOTOR_REVERSE, elapsed);
+
+                // Distance to the trigger point is the old estimate plus the last back-off
+                if (job.startPositionMs >= 0) {
+                    uint32_t backoffTravel = MotorSpeedModel::runTimeToTravel(
+                        motorIndex, MOTOR_FORWARD, SWITCH_RELEASE_TIME_MS);
+                    MotorSpeedModel::recordReverseSeek(motorIndex,
+                        job.startPositionMs + backoffTravel, elapsed);
+                }
+
+                // Step 5: Back away from switch
+                Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: Backing away from switch...", motorIndex);
+
+                if (!setMotorDirection(motorIndex, MOTOR_FORWARD)) {
+                    Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Failed to back away", motorIndex);
+                    finishHomingJob(motorIndex, HOMING_MOTOR_ERROR);
+                    break;
+                }
+
+                job.phase = HOMING_PHASE_BACKOFF;
+                job.phaseStart = now;
+            } else if (elapsed >= HOMING_TIMEOUT_MS) {
+                // Step 4: Timed out waiting for the switch
+                stopMotor(motorIndex);
+                MotorTelemetry::recordRun(motorIndex, MOTOR_REVERSE, elapsed);
+                Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: TIMEOUT after %d ms - switch not triggered",
+                             motorIndex, HOMING_TIMEOUT_MS);
+                finishHomingJob(motorIndex, HOMING_TIMEOUT);
+            }
+            break;
+        }
+
+        case HOMING_PHASE_BACKOFF:
+            // Time until the switch releases measures forward speed
+            if (job.releaseMs == 0 && elapsed > 0 && !SwitchReader::isTriggeredDebounced(motorIndex)) {
+                uint64_t releasedUs = SwitchReader::getEdgeTimeUs(motorIndex);
+                uint32_t releaseMs = (releasedUs > job.phaseStart * 1000)
+                    ? (uint32_t)(releasedUs / 1000 - job.phaseStart) : elapsed;
+                job.releaseMs = releaseMs > 0 ? releaseMs : 1;
+                MotorSpeedModel::recordBackoffRelease(motorIndex, job.releaseMs);
+            }
+
+            if (elapsed >= SWITCH_RELEASE_TIME_MS) {
+                stopMotor(motorIndex);
+                MotorTelemetry::recordRun(motorIndex, MOTOR_FORWARD, elapsed);
+                job.phase = HOMING_PHASE_VERIFY;
+                job.phaseStart = now;
+            }
+            break;
+
+        case HOMING_PHASE_VERIFY:
+            // Step 6: Verify switch is released, waiting only while it has not settled open
+            if (SwitchReader::isTriggeredDebounced(motorIndex)) {
+                if (elapsed < SWITCH_SETTLE_TIME_MS) {
+                    break;
+                }
+                Logger::logf(LOG_ERROR, CAT_HOMING, "Motor %d: Switch still triggered after backing away", motorIndex);
+                finishHomingJob(motorIndex, HOMING_SWITCH_ERROR);
+                break;
+            }
+
+            Logger::logf(LOG_INFO, CAT_HOMING, "Motor %d: HOMING COMPLETE", motorIndex);
+            finishHomingJob(motorIndex, HOMING_SUCCESS);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void MotorController::finishHomingJob(uint8_t motorIndex, HomingResult result) {
+    // Motors cancelled while still waiting for a slot never attempted to home
+    HomingJob& job = homingJobs[motorIndex];
+    if (job.phase != HOMING_PHASE_PENDING || result != HOMING_CANCELLED) {
+        MotorTelemetry::recordHoming(motorIndex, result,
+                                     (uint32_t)(Clock::nowMillis() - job.startedAt));
+    }
+
+    homingJobs[motorIndex].phase = HOMING_PHASE_DONE;
+    homingJobs[motorIndex].result = result;
+    SwitchReader::disarmStopOnTrigger(motorIndex);
+
+    // The backed-off rest position is the origin of the position model
+    if (result == HOMING_SUCCESS) {
+        positionMs[motorIndex] = 0;
+        positionKnown[motorIndex] = true;
+        RehomeScheduler::resetMotor(motorIndex);
+    } else {
+        invalidatePosition(motorIndex);
+    }
+}
+
+bool MotorController::validateTideData(TideDataset* tideData, uint8_t windowStart) {
     if (tideData == nullptr) {
         Logger::error(CAT_MOTOR, "Tide sequence: Null tide data provided");
         return false;
@@ -323,10 +815,15 @@ bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
         return false;
     }
 
-    if (tideData->recordCount != 24) {
+    if (tideData->recordCount != TIDE_DATASET_HOURS) {
         Logger::logf(LOG_ERROR, CAT_MOTOR,
-                    "Tide sequence: Incomplete data (%u/24 hours)",
-                    tideData->recordCount);
+                    "Tide sequence: Incomplete data (%u/%u hours)",
+                    tideData->recordCount, TIDE_DATASET_HOURS);
+        return false;
+    }
+
+    if (windowStart == TIDE_WINDOW_INVALID) {
+        Logger::error(CAT_MOTOR, "Tide sequence: Data does not cover the next 24 hours - fetch new data");
         return false;
     }
 
@@ -335,6 +832,28 @@ bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
         return false;
     }
 
+    uint8_t unknownCount = 0;
+    for (uint8_t motor = 0; motor < NUM_MOTORS; motor++) {
+        if (!positionKnown[motor]) {
+            unknownCount++;
+        }
+    }
+    if (unknownCount > 0) {
+        Logger::logf(LOG_WARNING, CAT_MOTOR,
+                    "Tide sequence: %u motors not homed - assuming they started at home",
+                    unknownCount);
+    }
+
+    return true;
+}
+
+bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
+    // Validate inputs
+    uint8_t windowStart = RollingWindow::getWindowStart(tideData);
+    if (!validateTideData(tideData, windowStart)) {
+        return false;
+    }
+
     // Log sequence start
     Logger::separator();
     if (dryRun) {
@@ -350,9 +869,9 @@ bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
     Logger::separator();
 
     uint8_t successCount = 0;
-    unsigned long totalStartTime = millis();
+    uint64_t totalStartTime = Clock::nowMillis();
 
-    // Run each motor sequentially (motor index = hour)
+    // Run each motor sequentially (motor index = hour from the window start)
     for (uint8_t motor = 0; motor < 24; motor++) {
         // Check for emergency stop
         if (emergencyStop) {
@@ -360,35 +879,51 @@ bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
             return false;
         }
 
-        HourlyTideData* hourData = &tideData->hours[motor];
-        uint16_t runTime = hourData->finalRunTime;
+        uint8_t index = windowStart + motor;
+        HourlyTideData* hourData = &tideData->hours[index];
+        uint16_t target = TideDataManager::getMotorRunTime(tideData, index);
+
+        // Move only by the difference between the estimated and target position
+        MotorDirection direction;
+        uint16_t runTime;
+        planMoveToPosition(motor, target, direction, runTime);
 
         Logger::logf(LOG_INFO, CAT_MOTOR,
-                    "Motor %02u | Hour %02u | Tide: %.2f ft | Run: %u ms",
-                    motor, hourData->hour, hourData->rawTideHeight, runTime);
+                    "Motor %02u | Hour %02u | Tide: %.2f ft | Target: %u ms | Move: %s %u ms",
+                    motor, hourData->hour, hourData->rawTideHeight,
+                    target, getDirectionString(direction), runTime);
 
         if (dryRun) {
             // Dry run - just log, don't move
             Logger::logf(LOG_INFO, CAT_MOTOR,
-                        "  [DRY RUN] Would run motor %u for %u ms", motor, runTime);
+                        "  [DRY RUN] Would run motor %u %s for %u ms",
+                        motor, getDirectionString(direction), runTime);
+            successCount++;
+            continue;
+        }
+
+        if (runTime == 0) {
+            // Already in position
+            successCount++;
+            continue;
+        }
+
+        bool ran = (direction == MOTOR_FORWARD) ? runMotorForward(motor, runTime)
+                                                : runMotorReverse(motor, runTime);
+        if (ran) {
             successCount++;
         } else {
-            // Actually run the motor
-            if (runMotorForward(motor, runTime)) {
-                successCount++;
-            } else {
-                Logger::logf(LOG_ERROR, CAT_MOTOR,
-                            "Motor %u failed to run", motor);
-            }
+            Logger::logf(LOG_ERROR, CAT_MOTOR,
+                        "Motor %u failed to run", motor);
         }
 
         // Pause between motors (except after last motor)
-        if (motor < 23 && !dryRun) {
-            delay(PAUSE_BETWEEN_MOTORS_MS);
+        if (motor < 23) {
+            TaskManager::waitInOperation(PAUSE_BETWEEN_MOTORS_MS);
         }
     }
 
-    unsigned long totalTime = millis() - totalStartTime;
+    uint32_t totalTime = (uint32_t)(Clock::nowMillis() - totalStartTime);
 
     Logger::separator();
     if (dryRun) {
@@ -399,12 +934,65 @@ bool MotorController::runTideSequence(TideDataset* tideData, bool dryRun) {
     Logger::logf(LOG_INFO, CAT_MOTOR,
                 "Results: %u/24 motors positioned successfully", successCount);
     Logger::logf(LOG_INFO, CAT_MOTOR,
-                "Total time: %lu seconds", totalTime / 1000);
+                "Total time: %lu seconds", (unsigned long)(totalTime / 1000));
     Logger::separator();
 
     return (successCount == 24);
 }
 
+bool MotorController::runTideSequencePlanned(TideDataset* tideData, uint8_t maxConcurrent, bool dryRun) {
+    uint8_t windowStart = RollingWindow::getWindowStart(tideData);
+    if (!validateTideData(tideData, windowStart)) {
+        return false;
+    }
+
+    Logger::separator();
+    if (dryRun) {
+        Logger::info(CAT_MOTOR, "=== CONCURRENT TIDE SEQUENCE DRY RUN ===");
+        Logger::info(CAT_MOTOR, "Motors will NOT move - preview only");
+    } else {
+        Logger::info(CAT_MOTOR, "=== STARTING CONCURRENT TIDE SEQUENCE ===");
+    }
+    Logger::logf(LOG_INFO, CAT_MOTOR,
+                "Station: %s | Fetch time: %s",
+                tideData->stationID,
+                ctime(&tideData->fetchTime));
+    Logger::separator();
+
+    // Motor index = hour from the window start; each motor moves only by its delta to the new target
+    TidePlan plan;
+    TideSequencePlanner::clearPlan(plan);
+    for (uint8_t motor = 0; motor < 24; motor++) {
+        MotorDirection direction;
+        uint16_t runTime;
+        uint16_t target = TideDataManager::getMotorRunTime(tideData, windowStart + motor);
+        planMoveToPosition(motor, target, direction, runTime);
+        TideSequencePlanner::addMove(plan, motor, direction, runTime);
+    }
+
+    TideSequencePlanner::buildPlan(plan, maxConcurrent);
+    TideSequencePlanner::logPlan(plan);
+
+    bool success = true;
+    if (!dryRun) {
+        success = TideSequencePlanner::executePlan(plan);
+    }
+
+    const TidePlanResult& result = TideSequencePlanner::getLastResult();
+
+    Logger::separator();
+    if (dryRun) {
+        Logger::info(CAT_MOTOR, "=== DRY RUN COMPLETE ===");
+    } else {
+        Logger::info(CAT_MOTOR, "=== CONCURRENT TIDE SEQUENCE COMPLETE ===");
+        Logger::logf(LOG_INFO, CAT_MOTOR,
+                    "Results: %u/%u moves completed", result.movesCompleted, result.moveCount);
+    }
+    Logger::separator();
+
+    return success;
+}
+
 const char* MotorController::getHomingResultString(HomingResult result) {
     switch (result) {
         case HOMING_SUCCESS:       return "SUCCESS";
@@ -9,6 +9,8 @@
 #define MOTOR_CONTROLLER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include "../config.h"
 #include "../utils/Logger.h"
 #include "GPIOExpander.h"
@@ -27,7 +29,32 @@ enum HomingResult {
     HOMING_TIMEOUT,         // Timeout waiting for switch
     HOMING_SWITCH_ERROR,    // Could not read switch
     HOMING_MOTOR_ERROR,     // Could not control motor
-    HOMING_CANCELLED        // Operation cancelled (e.g., emergency stop)
+    HOMING_CANCELLED,       // Operation cancelled (e.g., emergency stop)
+    HOMING_RESULT_COUNT     // Number of result codes (not a result)
+};
+
+// Per-motor phases of the non-blocking homing state machine
+enum HomingPhase {
+    HOMING_PHASE_PENDING,   // Waiting for a free concurrency slot
+    HOMING_PHASE_RELEASE,   // Running forward to release an already-triggered switch
+    HOMING_PHASE_RELEASE_SETTLE, // Stopped, waiting to verify the switch released
+    HOMING_PHASE_SEEK,      // Running reverse until the limit switch triggers
+    HOMING_PHASE_BACKOFF,   // Running forward to back away from the switch
+    HOMING_PHASE_VERIFY,    // Stopped, waiting to verify the switch released
+    HOMING_PHASE_DONE       // Finished - result is valid
+};
+
+/**
+ * State for one motor in the homing engine
+ */
+struct HomingJob {
+    HomingPhase phase;          // Current step of the homing sequence
+    HomingResult result;        // Final result (valid when phase == DONE)
+    uint64_t phaseStart;        // Clock::nowMillis() when the current phase began
+    uint64_t startedAt;         // Clock::nowMillis() when the job left PENDING
+    int32_t startPositionMs;    // Position estimate when homing began (-1 = unknown)
+    uint16_t releaseMs;         // Back-off time until the switch released (0 = not yet)
+    uint64_t lastPoll;          // Clock::nowMillis() of the last safety poll while seeking on interrupts
 };
 
 class MotorController {
@@ -47,7 +74,42 @@ public:
     static bool setMotorDirection(uint8_t motorIndex, MotorDirection direction);
 
     /**
-     * Run motor forward for specified duration
+     * Set the direction of several motors with one write per motor board
+     * @param motorMask Bit N set = apply direction to motor N
+     * @param direction MOTOR_STOP, MOTOR_FORWARD, or MOTOR_REVERSE
+     * @return true if all affected boards were written
+     */
+    static bool setMotorDirections(uint32_t motorMask, MotorDirection direction);
+
+    /**
+     * Update a motor's bits in its board output image without writing
+     * (call commitMotorOutputs() to apply staged changes; hold lockOutputs()
+     * across both when another task may also drive motors)
+     * @return true if the motor index and direction are valid
+     */
+    static bool stageMotorDirection(uint8_t motorIndex, MotorDirection direction);
+
+    /**
+     * Write every motor board with staged changes (one transaction per board)
+     * @return true if all writes succeeded
+     */
+    static bool commitMotorOutputs();
+
+    /**
+     * Take the output lock (recursive)
+     * Held around every output image change and motor-board write so the
+     * stop-timer callback and the motion task never interleave updates.
+     */
+    static void lockOutputs();
+
+    /**
+     * Release the output lock
+     */
+    static void unlockOutputs();
+
+    /**
+     * Run motor forward for specified duration (blocks until the move ends;
+     * use MotionExecutor::startMove() for a non-blocking move)
      * @param motorIndex Motor number (0-23)
      * @param durationMs Time to run in milliseconds
      * @return true if successful
@@ -55,7 +117,8 @@ public:
     static bool runMotorForward(uint8_t motorIndex, uint16_t durationMs);
 
     /**
-     * Run motor reverse for specified duration
+     * Run motor reverse for specified duration (blocks until the move ends;
+     * use MotionExecutor::startMove() for a non-blocking move)
      * @param motorIndex Motor number (0-23)
      * @param durationMs Time to run in milliseconds
      * @return true if successful
@@ -74,6 +137,14 @@ public:
      */
     static void emergencyStopAll();
 
+    /**
+     * Fast stop path: latch emergency stop and write all-zero images to the
+     * motor boards, with no logging or move bookkeeping
+     * (safe to call from the emergency stop task)
+     * @return true if every board was written
+     */
+    static bool haltAllOutputs();
+
     /**
      * Check if emergency stop is active
      */
@@ -84,12 +155,57 @@ public:
      */
     static void clearEmergencyStop();
 
+    /**
+     * Estimated motor position in ms of travel at nominal speed from home (0 = homed)
+     * Unhomed motors count from 0 at boot or invalidatePosition(), as if they
+     * started at home; isPositionKnown() tells the two apart.
+     */
+    static int32_t getPosition(uint8_t motorIndex);
+
+    /**
+     * Check if a motor has a position estimate (set by homing)
+     */
+    static bool isPositionKnown(uint8_t motorIndex);
+
+    /**
+     * Update a motor's position estimate after it has run
+     * (run time is converted to travel with the learned speed model)
+     * @param direction Direction the motor ran
+     * @param runMs Time the motor actually ran
+     */
+    static void recordTravel(uint8_t motorIndex, MotorDirection direction, uint32_t runMs);
+
+    /**
+     * Discard a motor's position estimate (homing restores it)
+     */
+    static void invalidatePosition(uint8_t motorIndex);
+
+    /**
+     * Work out the move from the estimated position to a target position
+     * Unhomed motors plan from getPosition() too. The run time comes from
+     * the learned speed model for the chosen direction.
+     * @param targetMs Target position in ms of travel at nominal speed
+     * @param direction Receives MOTOR_FORWARD, MOTOR_REVERSE or MOTOR_STOP
+     * @param durationMs Receives the run time (0 when within POSITION_DEADBAND_MS)
+     * @return false if the motor index is invalid
+     */
+    static bool planMoveToPosition(uint8_t motorIndex, uint16_t targetMs,
+                                   MotorDirection& direction, uint16_t& durationMs);
+
+    /**
+     * Start a timed move to a target position (non-blocking)
+     * @return true if the move started or the motor is already in position
+     */
+    static bool moveToPosition(uint8_t motorIndex, uint16_t targetMs);
+
     /**
      * Home a single motor using its limit switch
      * @param motorIndex Motor number (0-23)
+     * @param fitSpeeds Fold the run into the speed model (false when the
+     *                  caller fits once after a batch of single-motor runs)
      * @return HomingResult code indicating success or failure type
      */
-    static HomingResult homeSingleMotor(uint8_t motorIndex);
+    static HomingResult homeSingleMotor(uint8_t motorIndex, bool fitSpeeds = true);
 
     /**
      * Home all motors sequentially
@@ -97,14 +213,50 @@ public:
      */
     static uint8_t homeAllMotors();
 
+    /**
+     * Home a set of motors concurrently
+     * Each motor runs its own non-blocking homing state machine
+     * (release -> reverse -> switch hit -> back-off -> verify).
+     * @param motorMask Bit N set = home motor N
+     * @param maxConcurrent Maximum number of motors running at the same time
+     * @param results Optional array of NUM_MOTORS to receive per-motor results
+     *                (entries for motors not in the mask are left untouched)
+     * @return Number of motors successfully homed
+     */
+    static uint8_t homeMotorsConcurrent(uint32_t motorMask, uint8_t maxConcurrent,
+                                        HomingResult* results = nullptr);
+
+    /**
+     * Home all motors concurrently
+     * @param maxConcurrent Maximum number of motors running at the same time
+     * @param results Optional array of NUM_MOTORS to receive per-motor results
+     * @return Number of motors successfully homed
+     */
+    static uint8_t homeAllMotorsConcurrent(uint8_t maxConcurrent = HOMING_MAX_CONCURRENT,
+                                           HomingResult* results = nullptr);
+
     /**
      * Phase 3: Run all motors to tide-based positions
-     * @param tideData Pointer to TideDataset with 24 hours of position data
+     * Motor N shows hour N of the data, or the Nth hour from now when the
+     * rolling window is enabled.
+     * @param tideData Pointer to TideDataset with two days of position data
      * @param dryRun If true, log positions without moving motors
      * @return true if sequence completed successfully
      */
     static bool runTideSequence(struct TideDataset* tideData, bool dryRun = false);
 
+    /**
+     * Run all motors to tide-based positions concurrently
+     * Moves are packed into parallel lanes by TideSequencePlanner.
+     * @param tideData Pointer to TideDataset with two days of position data
+     * @param maxConcurrent Maximum motors running at once (further limited by current budget)
+     * @param dryRun If true, log the plan without moving motors
+     * @return true if every move completed
+     */
+    static bool runTideSequencePlanned(struct TideDataset* tideData,
+                                       uint8_t maxConcurrent = TIDE_MAX_CONCURRENT,
+                                       bool dryRun = false);
+
     /**
      * Get text description of homing result
      */
@@ -117,7 +269,16 @@ public:
 
 private:
     static bool initialized;
-    static bool emergencyStop;
+    static volatile bool emergencyStop;
+
+    // 16-bit output image per motor board (bit N = pin N) and pending-write flags
+    static uint16_t outputImage[NUM_MOTOR_BOARDS];
+    static bool outputDirty[NUM_MOTOR_BOARDS];
+    static SemaphoreHandle_t outputMutex;
+
+    // Position model: ms of travel at nominal speed from home, valid once homed
+    static int32_t positionMs[NUM_MOTORS];
+    static bool positionKnown[NUM_MOTORS];
 
     /**
      * Validate motor index
@@ -130,10 +291,52 @@ private:
     static bool setMotorPins(uint8_t motorIndex, uint8_t in1, uint8_t in2);
 
     /**
-     * Release motor from limit switch (if already triggered)
-     * @return true if successful or switch was already released
+     * Update both motor control bits in the board output image
+     */
+    static void stageMotorPins(uint8_t motorIndex, uint8_t in1, uint8_t in2);
+
+    /**
+     * Write one board's output image (always all-off while emergency stopped)
+     */
+    static bool commitBoard(uint8_t boardIndex);
+
+    /**
+     * Write all-zero images to every motor board without logging
+     */
+    static bool writeAllOff();
+
+    /**
+     * Check tide data and emergency stop before running a sequence
+     * @param windowStart Index in hours[] shown by motor 0 (RollingWindow::getWindowStart)
+     */
+    static bool validateTideData(struct TideDataset* tideData, uint8_t windowStart);
+
+    /**
+     * Homing engine state (one job per motor)
+     */
+    static HomingJob homingJobs[NUM_MOTORS];
+
+    /**
+     * Run homing jobs for all motors in the mask until every job is done
+     * @param fitSpeeds Fit and save the speed model from the run's measurements
+     * @return Number of motors successfully homed
+     */
+    static uint8_t runHomingJobs(uint32_t motorMask, uint8_t maxConcurrent, bool fitSpeeds = true);
+
+    /**
+     * Start the homing state machine for one motor
+     */
+    static void startHomingJob(uint8_t motorIndex, uint64_t now);
+
+    /**
+     * Advance the homing state machine for one motor (non-blocking)
+     */
+    static void stepHomingJob(uint8_t motorIndex, uint64_t now);
+
+    /**
+     * Mark a homing job as finished with the given result
      */
-    static bool releaseFromSwitch(uint8_t motorIndex);
+    static void finishHomingJob(uint8_t motorIndex, HomingResult result);
 };
 
 #endif // MOTOR_CONTROLLER_H
@@ -0,0 +1,207 @@
+/**
+ * Motor Speed Model Implementation
+ */
+
+#include "MotorSpeedModel.h"
+#include "../utils/Logger.h"
+#include <Preferences.h>
+
+// NVS namespace and keys
+static const char* SPEED_NAMESPACE = "motorspeed";
+static const char* SPEED_KEY_VERSION = "version";
+static const char* SPEED_KEY_DATA = "data";
+
+// Static member initialization
+MotorSpeedData MotorSpeedModel::speeds;
+MotorSpeedData MotorSpeedModel::saved;
+uint16_t MotorSpeedModel::releaseMs[NUM_MOTORS] = {0};
+
+void MotorSpeedModel::begin() {
+    uint8_t learned = 0;
+    bool loaded = false;
+
+    Preferences prefs;
+    if (prefs.begin(SPEED_NAMESPACE, true)) {
+        loaded = prefs.getUInt(SPEED_KEY_VERSION, 0) == SPEED_MODEL_VERSION &&
+                 prefs.getBytesLength(SPEED_KEY_DATA) == sizeof(speeds) &&
+                 prefs.getBytes(SPEED_KEY_DATA, &speeds, sizeof(speeds)) == sizeof(speeds);
+        prefs.end();
+    }
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (!loaded) {
+            speeds.forward[i] = MOTOR_SPEED_NOMINAL;
+            speeds.reverse[i] = MOTOR_SPEED_NOMINAL;
+        }
+
+        // Anything outside the accepted range is treated as unlearned
+        if (speeds.forward[i] < MOTOR_SPEED_MIN || speeds.forward[i] > MOTOR_SPEED_MAX) {
+            speeds.forward[i] = MOTOR_SPEED_NOMINAL;
+        }
+        if (speeds.reverse[i] < MOTOR_SPEED_MIN || speeds.reverse[i] > MOTOR_SPEED_MAX) {
+            speeds.reverse[i] = MOTOR_SPEED_NOMINAL;
+        }
+
+        if (speeds.forward[i] != MOTOR_SPEED_NOMINAL || speeds.reverse[i] != MOTOR_SPEED_NOMINAL) {
+            learned++;
+        }
+        releaseMs[i] = 0;
+    }
+    saved = speeds;
+
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Speed model loaded: %u/%u motors calibrated",
+                 learned, NUM_MOTORS);
+}
+
+uint16_t MotorSpeedModel::getSpeed(uint8_t motorIndex, MotorDirection direction) {
+    if (motorIndex >= NUM_MOTORS) {
+        return MOTOR_SPEED_NOMINAL;
+    }
+    return (direction == MOTOR_REVERSE) ? speeds.reverse[motorIndex] : speeds.forward[motorIndex];
+}
+
+uint32_t MotorSpeedModel::travelToRunTime(uint8_t motorIndex, MotorDirection direction, uint32_t travelMs) {
+    uint16_t speed = getSpeed(motorIndex, direction);
+    return (travelMs * MOTOR_SPEED_NOMINAL + speed / 2) / speed;
+}
+
+uint32_t MotorSpeedModel::runTimeToTravel(uint8_t motorIndex, MotorDirection direction, uint32_t runMs) {
+    uint16_t speed = getSpeed(motorIndex, direction);
+    return (runMs * speed + MOTOR_SPEED_NOMINAL / 2) / MOTOR_SPEED_NOMINAL;
+}
+
+void MotorSpeedModel::recordBackoffRelease(uint8_t motorIndex, uint32_t elapsedMs) {
+    if (motorIndex >= NUM_MOTORS || elapsedMs == 0) {
+        return;
+    }
+
+    releaseMs[motorIndex] = (elapsedMs > 0xFFFF) ? 0xFFFF : elapsedMs;
+    Logger::logf(LOG_DEBUG, CAT_HOMING, "Motor %d: switch released after %lu ms of back-off",
+                 motorIndex, (unsigned long)elapsedMs);
+}
+
+void MotorSpeedModel::recordReverseSeek(uint8_t motorIndex, uint32_t travelMs, uint32_t seekMs) {
+    if (motorIndex >= NUM_MOTORS || seekMs == 0 || travelMs < SPEED_FIT_MIN_TRAVEL_MS) {
+        return;
+    }
+
+    uint32_t sample = (travelMs * MOTOR_SPEED_NOMINAL) / seekMs;
+    uint16_t previous = speeds.reverse[motorIndex];
+    speeds.reverse[motorIndex] = blend(previous, sample);
+
+    Logger::logf(LOG_INFO, CAT_HOMING,
+                 "Motor %d: reverse seek %lu ms for %lu ms travel -> speed %u (was %u)",
+                 motorIndex, (unsigned long)seekMs, (unsigned long)travelMs,
+                 speeds.reverse[motorIndex], previous);
+}
+
+bool MotorSpeedModel::fitForwardSpeeds() {
+    // Collect release samples (insertion sort - at most 24 entries)
+    uint16_t sorted[NUM_MOTORS];
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (releaseMs[i] == 0) {
+            continue;
+        }
+
+        uint8_t j = count++;
+        while (j > 0 && sorted[j - 1] > releaseMs[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = releaseMs[i];
+    }
+
+    if (count < SPEED_FIT_MIN_MOTORS) {
+        return false;
+    }
+
+    // The switch release distance is the same for every motor, so a motor
+    // that releases faster than the median is running faster than typical
+    uint32_t median = (count % 2) ? sorted[count / 2]
+                                  : ((uint32_t)sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (releaseMs[i] == 0) {
+            continue;
+        }
+
+        uint32_t sample = (median * MOTOR_SPEED_NOMINAL) / releaseMs[i];
+        speeds.forward[i] = blend(speeds.forward[i], sample);
+
+        // Each sample is blended once; the next fit waits for fresh ones
+        releaseMs[i] = 0;
+    }
+
+    Logger::logf(LOG_INFO, CAT_HOMING, "Forward speed fit: %u motors, median release %lu ms",
+                 count, (unsigned long)median);
+    return true;
+}
+
+bool MotorSpeedModel::saveIfChanged() {
+    bool changed = false;
+
+    for (uint8_t i = 0; i < NUM_MOTORS && !changed; i++) {
+        int forwardDelta = (int)speeds.forward[i] - saved.forward[i];
+        int reverseDelta = (int)speeds.reverse[i] - saved.reverse[i];
+        changed = abs(forwardDelta) >= SPEED_SAVE_THRESHOLD ||
+                  abs(reverseDelta) >= SPEED_SAVE_THRESHOLD;
+    }
+
+    if (!changed) {
+        return false;
+    }
+
+    Logger::info(CAT_MOTOR, "Saving updated speed model");
+    return save();
+}
+
+bool MotorSpeedModel::reset() {
+    Logger::info(CAT_MOTOR, "Resetting speed model to nominal");
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        speeds.forward[i] = MOTOR_SPEED_NOMINAL;
+        speeds.reverse[i] = MOTOR_SPEED_NOMINAL;
+        releaseMs[i] = 0;
+    }
+    return save();
+}
+
+void MotorSpeedModel::printModel() {
+    Logger::info(CAT_MOTOR, "Motor speed model (permille of nominal):");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        Logger::logf(LOG_INFO, CAT_MOTOR, "  Motor %02d: fwd %4u  rev %4u  release %u ms",
+                     i, speeds.forward[i], speeds.reverse[i], releaseMs[i]);
+    }
+}
+
+uint16_t MotorSpeedModel::blend(uint16_t current, uint32_t sample) {
+    if (sample < MOTOR_SPEED_MIN) sample = MOTOR_SPEED_MIN;
+    if (sample > MOTOR_SPEED_MAX) sample = MOTOR_SPEED_MAX;
+
+    int32_t next = current + ((int32_t)sample - current) / SPEED_FIT_WEIGHT;
+    return (uint16_t)next;
+}
+
+bool MotorSpeedModel::save() {
+    Preferences prefs;
+    if (!prefs.begin(SPEED_NAMESPACE, false)) {
+        Logger::error(CAT_MOTOR, "Speed model: failed to open NVS");
+        return false;
+    }
+
+    bool success = prefs.putBytes(SPEED_KEY_DATA, &speeds, sizeof(speeds)) == sizeof(speeds);
+    if (success && prefs.getUInt(SPEED_KEY_VERSION, 0) != SPEED_MODEL_VERSION) {
+        success = prefs.putUInt(SPEED_KEY_VERSION, SPEED_MODEL_VERSION) > 0;
+    }
+    prefs.end();
+
+    if (!success) {
+        Logger::error(CAT_MOTOR, "Speed model: failed to save");
+        return false;
+    }
+
+    saved = speeds;
+    return true;
+}
@@ -0,0 +1,111 @@
+/**
+ * Motor Speed Model
+ *
+ * Learned forward and reverse speed for each motor, in permille of the
+ * nominal speed (1000 = 1 ms of position per ms of run time). Positions
+ * and tide targets are expressed at nominal speed; this model converts
+ * between them and actual run times in each direction.
+ *
+ * The fit is fed by homing: the forward back-off time until the switch
+ * releases is compared against the fleet median, and the reverse seek
+ * time to the switch is compared against the estimated distance.
+ * Results are written to NVS as one blob, apart from the EEPROM
+ * configuration so its layout (and every saved configuration) is unchanged.
+ */
+
+#ifndef MOTOR_SPEED_MODEL_H
+#define MOTOR_SPEED_MODEL_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "MotorController.h"
+
+#define SPEED_MODEL_VERSION 1
+
+/**
+ * Persisted fit (indexed by motor, permille of nominal)
+ */
+struct MotorSpeedData {
+    uint16_t forward[NUM_MOTORS];
+    uint16_t reverse[NUM_MOTORS];
+};
+
+class MotorSpeedModel {
+public:
+    /**
+     * Load the persisted fit (nominal speeds if none saved or the layout changed)
+     */
+    static void begin();
+
+    /**
+     * Get a motor's learned speed in one direction (permille of nominal)
+     */
+    static uint16_t getSpeed(uint8_t motorIndex, MotorDirection direction);
+
+    /**
+     * Run time needed to travel a distance
+     * @param travelMs Distance in ms of travel at nominal speed
+     * @return Run time in ms
+     */
+    static uint32_t travelToRunTime(uint8_t motorIndex, MotorDirection direction, uint32_t travelMs);
+
+    /**
+     * Distance covered by a run
+     * @param runMs Run time in ms
+     * @return Distance in ms of travel at nominal speed
+     */
+    static uint32_t runTimeToTravel(uint8_t motorIndex, MotorDirection direction, uint32_t runMs);
+
+    /**
+     * Record how long the forward back-off ran before the switch released
+     */
+    static void recordBackoffRelease(uint8_t motorIndex, uint32_t elapsedMs);
+
+    /**
+     * Record a reverse seek from a known distance and update the reverse speed
+     * @param travelMs Estimated distance to the switch trigger point
+     * @param seekMs Time the reverse seek ran before the switch triggered
+     */
+    static void recordReverseSeek(uint8_t motorIndex, uint32_t travelMs, uint32_t seekMs);
+
+    /**
+     * Update forward speeds from back-off release times vs. the fleet median
+     * The samples are consumed by a fit; too few are kept for the next one.
+     * @return true if a fit was made (enough motors have release samples)
+     */
+    static bool fitForwardSpeeds();
+
+    /**
+     * Persist the fit if any speed has moved SPEED_SAVE_THRESHOLD from the saved value
+     * @return true if the fit was saved
+     */
+    static bool saveIfChanged();
+
+    /**
+     * Return every motor to nominal speed, discard release samples and save
+     * @return true if the nominal fit was saved
+     */
+    static bool reset();
+
+    /**
+     * Print learned speeds
+     */
+    static void printModel();
+
+private:
+    static MotorSpeedData speeds;
+    static MotorSpeedData saved;                // Last fit written to NVS
+    static uint16_t releaseMs[NUM_MOTORS];      // Back-off release time not yet fitted (0 = no sample)
+
+    /**
+     * Move a speed 1/SPEED_FIT_WEIGHT of the way towards a sample, within limits
+     */
+    static uint16_t blend(uint16_t current, uint32_t sample);
+
+    /**
+     * Write the fit to NVS
+     */
+    static bool save();
+};
+
+#endif // MOTOR_SPEED_MODEL_H
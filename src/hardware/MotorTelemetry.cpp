@@ -0,0 +1,173 @@
+/**
+ * Motor Telemetry Implementation
+ */
+
+#include "MotorTelemetry.h"
+#include "../utils/Clock.h"
+#include "../utils/Logger.h"
+#include <Preferences.h>
+
+// NVS namespace and keys
+static const char* TELEMETRY_NAMESPACE = "motorstats";
+static const char* TELEMETRY_KEY_VERSION = "version";
+static const char* TELEMETRY_KEY_DATA = "data";
+
+// Static member initialization
+MotorTelemetryData MotorTelemetry::data;
+bool MotorTelemetry::dirty = false;
+bool MotorTelemetry::flushSoon = false;
+uint64_t MotorTelemetry::lastFlush = 0;
+
+void MotorTelemetry::begin() {
+    memset(&data, 0, sizeof(data));
+    dirty = false;
+    flushSoon = false;
+    lastFlush = Clock::nowMillis();
+
+    Preferences prefs;
+    if (!prefs.begin(TELEMETRY_NAMESPACE, true)) {
+        Logger::info(CAT_MOTOR, "Motor telemetry: no saved counters, starting from zero");
+        return;
+    }
+
+    bool loaded = prefs.getUInt(TELEMETRY_KEY_VERSION, 0) == TELEMETRY_VERSION &&
+                  prefs.getBytesLength(TELEMETRY_KEY_DATA) == sizeof(data) &&
+                  prefs.getBytes(TELEMETRY_KEY_DATA, &data, sizeof(data)) == sizeof(data);
+    prefs.end();
+
+    if (!loaded) {
+        memset(&data, 0, sizeof(data));
+        Logger::warning(CAT_MOTOR, "Motor telemetry: saved counters invalid, starting from zero");
+        return;
+    }
+
+    Logger::info(CAT_MOTOR, "Motor telemetry loaded");
+}
+
+void MotorTelemetry::service() {
+    if (!dirty) {
+        return;
+    }
+
+    // Homing results are rare and worth keeping; run time can wait
+    if (flushSoon || Clock::nowMillis() - lastFlush >= TELEMETRY_FLUSH_INTERVAL_MS) {
+        flush();
+    }
+}
+
+void MotorTelemetry::recordRun(uint8_t motorIndex, MotorDirection direction, uint32_t runMs) {
+    if (motorIndex >= NUM_MOTORS || runMs == 0) {
+        return;
+    }
+
+    if (direction == MOTOR_FORWARD) {
+        data.runMsForward[motorIndex] += runMs;
+    } else if (direction == MOTOR_REVERSE) {
+        data.runMsReverse[motorIndex] += runMs;
+    } else {
+        return;
+    }
+    dirty = true;
+}
+
+void MotorTelemetry::recordMove(uint8_t motorIndex, MotorDirection direction, uint32_t runMs) {
+    if (motorIndex >= NUM_MOTORS) {
+        return;
+    }
+
+    data.moveCount[motorIndex]++;
+    dirty = true;
+    recordRun(motorIndex, direction, runMs);
+}
+
+void MotorTelemetry::recordHoming(uint8_t motorIndex, HomingResult result, uint32_t durationMs) {
+    if (motorIndex >= NUM_MOTORS || result >= HOMING_RESULT_COUNT) {
+        return;
+    }
+
+    if (result == HOMING_SUCCESS) {
+        uint16_t duration = durationMs > 0xFFFF ? 0xFFFF : (uint16_t)durationMs;
+
+        if (data.homeCount[motorIndex] < 0xFFFF) {
+            data.homeCount[motorIndex]++;
+        }
+        data.lastHomeMs[motorIndex] = duration;
+
+        // First home seeds the average
+        if (data.avgHomeMs[motorIndex] == 0) {
+            data.avgHomeMs[motorIndex] = duration;
+        } else {
+            int32_t avg = data.avgHomeMs[motorIndex];
+            avg += ((int32_t)duration - avg) / TELEMETRY_HOMING_AVG_WEIGHT;
+            data.avgHomeMs[motorIndex] = (uint16_t)avg;
+        }
+    } else {
+        uint16_t& count = data.homeFailures[result - 1][motorIndex];
+        if (count < 0xFFFF) {
+            count++;
+        }
+    }
+
+    dirty = true;
+    flushSoon = true;
+}
+
+const MotorTelemetryData& MotorTelemetry::getData() {
+    return data;
+}
+
+uint16_t MotorTelemetry::getFailureCount(uint8_t motorIndex, HomingResult result) {
+    if (motorIndex >= NUM_MOTORS || result == HOMING_SUCCESS || result >= HOMING_RESULT_COUNT) {
+        return 0;
+    }
+    return data.homeFailures[result - 1][motorIndex];
+}
+
+bool MotorTelemetry::flush() {
+    if (!dirty) {
+        return true;
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(TELEMETRY_NAMESPACE, false)) {
+        Logger::error(CAT_MOTOR, "Motor telemetry: failed to open NVS");
+        return false;
+    }
+
+    bool success = prefs.putBytes(TELEMETRY_KEY_DATA, &data, sizeof(data)) == sizeof(data);
+    if (success && prefs.getUInt(TELEMETRY_KEY_VERSION, 0) != TELEMETRY_VERSION) {
+        success = prefs.putUInt(TELEMETRY_KEY_VERSION, TELEMETRY_VERSION) > 0;
+    }
+    prefs.end();
+
+    // Retry at the next interval rather than every loop pass
+    lastFlush = Clock::nowMillis();
+    flushSoon = false;
+
+    if (!success) {
+        Logger::error(CAT_MOTOR, "Motor telemetry: failed to save counters");
+        return false;
+    }
+
+    dirty = false;
+    Logger::debug(CAT_MOTOR, "Motor telemetry saved");
+    return true;
+}
+
+void MotorTelemetry::printStats() {
+    Logger::info(CAT_MOTOR, "Motor telemetry (run time in seconds, homing in ms):");
+    Logger::info(CAT_MOTOR, "  Motor   Fwd s   Rev s  Moves  Homes  Last  Avg   T/O  Sw  Mtr  Cxl");
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        Logger::logf(LOG_INFO, CAT_MOTOR, "  %02d   %7lu %7lu %6lu %6u %5u %5u %4u %3u %4u %4u",
+                     i,
+                     (unsigned long)(data.runMsForward[i] / 1000),
+                     (unsigned long)(data.runMsReverse[i] / 1000),
+                     (unsigned long)data.moveCount[i],
+                     data.homeCount[i], data.lastHomeMs[i], data.avgHomeMs[i],
+                     getFailureCount(i, HOMING_TIMEOUT),
+                     getFailureCount(i, HOMING_SWITCH_ERROR),
+                     getFailureCount(i, HOMING_MOTOR_ERROR),
+                     getFailureCount(i, HOMING_CANCELLED));
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * Motor Telemetry
+ *
+ * Lifetime operating counters for each motor: run time per direction,
+ * move count, homing count, last and rolling-average homing duration, and
+ * homing failures by result. Counters live in RAM as a fixed-size
+ * struct-of-arrays and are written to NVS as one blob, only when they have
+ * changed: after homing results, otherwise at most every
+ * TELEMETRY_FLUSH_INTERVAL_MS. A slowly rising homing time is the earliest
+ * sign of a failing gearmotor.
+ */
+
+#ifndef MOTOR_TELEMETRY_H
+#define MOTOR_TELEMETRY_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "MotorController.h"
+
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_FAILURE_KINDS (HOMING_RESULT_COUNT - 1)  // Every result but HOMING_SUCCESS
+
+/**
+ * Persisted counters (struct-of-arrays, indexed by motor)
+ */
+struct MotorTelemetryData {
+    uint32_t runMsForward[NUM_MOTORS];      // Cumulative forward run time
+    uint32_t runMsReverse[NUM_MOTORS];      // Cumulative reverse run time
+    uint32_t moveCount[NUM_MOTORS];         // Timed moves completed or cancelled
+    uint16_t homeCount[NUM_MOTORS];         // Successful homes
+    uint16_t lastHomeMs[NUM_MOTORS];        // Duration of the last successful home
+    uint16_t avgHomeMs[NUM_MOTORS];         // Rolling average successful home duration
+    uint16_t homeFailures[TELEMETRY_FAILURE_KINDS][NUM_MOTORS]; // By HomingResult - 1
+};
+
+class MotorTelemetry {
+public:
+    /**
+     * Load counters from NVS (zeroed if none saved or the layout changed)
+     */
+    static void begin();
+
+    /**
+     * Flush changed counters when due (call from the motion task)
+     */
+    static void service();
+
+    /**
+     * Add motor run time (homing phases and timed moves)
+     */
+    static void recordRun(uint8_t motorIndex, MotorDirection direction, uint32_t runMs);
+
+    /**
+     * Record a finished timed move and its run time
+     */
+    static void recordMove(uint8_t motorIndex, MotorDirection direction, uint32_t runMs);
+
+    /**
+     * Record a homing result
+     * @param durationMs Time from homing start to result (used on success)
+     */
+    static void recordHoming(uint8_t motorIndex, HomingResult result, uint32_t durationMs);
+
+    /**
+     * Get all counters (read-only)
+     */
+    static const MotorTelemetryData& getData();
+
+    /**
+     * Homing failures of one kind for a motor
+     */
+    static uint16_t getFailureCount(uint8_t motorIndex, HomingResult result);
+
+    /**
+     * Write counters to NVS now if they have changed
+     * @return true if nothing was pending or the write succeeded
+     */
+    static bool flush();
+
+    /**
+     * Print counters for every motor
+     */
+    static void printStats();
+
+private:
+    static MotorTelemetryData data;
+    static bool dirty;
+    static bool flushSoon;
+    static uint64_t lastFlush;
+};
+
+#endif // MOTOR_TELEMETRY_H
@@ -0,0 +1,213 @@
+/**
+ * TideClock Pin Topology
+ *
+ * Compile-time view of MOTOR_PIN_MAP and SWITCH_PIN_MAP. Board indices,
+ * per-motor IN1/IN2 bit masks, per-board output and input masks and the
+ * switch demux tables are all derived here once, and the static_asserts
+ * at the end reject a pin map with an unknown board address, a pin
+ * outside 0-15, or two signals sharing a pin. Hot paths index these
+ * tables directly instead of looking anything up at run time.
+ */
+
+#ifndef PIN_TOPOLOGY_H
+#define PIN_TOPOLOGY_H
+
+#include <Arduino.h>
+#include "../config.h"
+
+namespace PinTopology {
+
+inline constexpr uint8_t MOTOR_BOARD_ADDRESS[NUM_MOTOR_BOARDS] = {MCP_MOTOR_0, MCP_MOTOR_1, MCP_MOTOR_2};
+inline constexpr uint8_t SWITCH_BOARD_ADDRESS[NUM_SWITCH_BOARDS] = {MCP_SWITCH_0, MCP_SWITCH_1};
+inline constexpr uint8_t NO_BOARD = 0xFF;
+inline constexpr uint8_t NO_SWITCH = 0xFF;
+
+/**
+ * Motor board index (0-2) from its I2C address (NO_BOARD = not a motor board)
+ */
+constexpr uint8_t motorBoardIndex(uint8_t address) {
+    for (uint8_t board = 0; board < NUM_MOTOR_BOARDS; board++) {
+        if (MOTOR_BOARD_ADDRESS[board] == address) return board;
+    }
+    return NO_BOARD;
+}
+
+/**
+ * Switch board index (0-1) from its I2C address (NO_BOARD = not a switch board)
+ */
+constexpr uint8_t switchBoardIndex(uint8_t address) {
+    for (uint8_t board = 0; board < NUM_SWITCH_BOARDS; board++) {
+        if (SWITCH_BOARD_ADDRESS[board] == address) return board;
+    }
+    return NO_BOARD;
+}
+
+// ============================================================================
+// MOTOR OUTPUTS
+// ============================================================================
+
+struct MotorTopology {
+    uint8_t board[NUM_MOTORS];                  // Motor board index
+    uint16_t in1Mask[NUM_MOTORS];               // IN1 bit in the board's GPIOAB word
+    uint16_t in2Mask[NUM_MOTORS];               // IN2 bit in the board's GPIOAB word
+    uint16_t outputMask[NUM_MOTOR_BOARDS];      // Every IN1/IN2 bit driven on each board
+    uint32_t boardMotors[NUM_MOTOR_BOARDS];     // Motor bits (bit N = motor N) on each board
+};
+
+constexpr MotorTopology buildMotorTopology() {
+    MotorTopology topology = {};
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        uint8_t board = motorBoardIndex(MOTOR_PIN_MAP[i].mcpAddress);
+        if (board == NO_BOARD || MOTOR_PIN_MAP[i].in1Pin > 15 || MOTOR_PIN_MAP[i].in2Pin > 15) {
+            continue;  // Rejected by the static_asserts below
+        }
+
+        topology.board[i] = board;
+        topology.in1Mask[i] = (uint16_t)(1U << MOTOR_PIN_MAP[i].in1Pin);
+        topology.in2Mask[i] = (uint16_t)(1U << MOTOR_PIN_MAP[i].in2Pin);
+        topology.outputMask[board] |= topology.in1Mask[i] | topology.in2Mask[i];
+        topology.boardMotors[board] |= (1UL << i);
+    }
+    return topology;
+}
+
+inline constexpr MotorTopology MOTORS = buildMotorTopology();
+
+// ============================================================================
+// SWITCH INPUTS
+// ============================================================================
+
+struct SwitchTopology {
+    uint8_t board[NUM_MOTORS];                      // Switch board index
+    uint16_t pinMask[NUM_MOTORS];                   // Switch bit in the board's GPIOAB word
+    uint16_t inputMask[NUM_SWITCH_BOARDS];          // Every switch pin on each board
+    uint32_t boardSwitches[NUM_SWITCH_BOARDS];      // Switch bits (bit N = switch N) on each board
+    uint8_t pinToSwitch[NUM_SWITCH_BOARDS][16];     // Board pin -> switch (NO_SWITCH = unused)
+
+    // Switch-word bits for every value of every board port: demux[board][port][byte]
+    // has bit N set when switch N is wired to a pin set in that byte of the
+    // board's GPIOA (port 0) or GPIOB (port 1)
+    uint32_t demux[NUM_SWITCH_BOARDS][2][256];
+};
+
+constexpr SwitchTopology buildSwitchTopology() {
+    SwitchTopology topology = {};
+    for (uint8_t board = 0; board < NUM_SWITCH_BOARDS; board++) {
+        for (uint8_t pin = 0; pin < 16; pin++) {
+            topology.pinToSwitch[board][pin] = NO_SWITCH;
+        }
+    }
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        uint8_t board = switchBoardIndex(SWITCH_PIN_MAP[i].mcpAddress);
+        uint8_t pin = SWITCH_PIN_MAP[i].pin;
+        if (board == NO_BOARD || pin > 15) {
+            continue;  // Rejected by the static_asserts below
+        }
+
+        topology.board[i] = board;
+        topology.pinMask[i] = (uint16_t)(1U << pin);
+        topology.inputMask[board] |= topology.pinMask[i];
+        topology.boardSwitches[board] |= (1UL << i);
+        topology.pinToSwitch[board][pin] = i;
+
+        for (uint16_t value = 0; value < 256; value++) {
+            if (value & (1U << (pin & 7))) {
+                topology.demux[board][pin >> 3][value] |= (1UL << i);
+            }
+        }
+    }
+    return topology;
+}
+
+inline constexpr SwitchTopology SWITCHES = buildSwitchTopology();
+
+/**
+ * Switch word (bit N = switch N closed) from one board's GPIOAB value
+ * Switches pull their pin LOW when closed.
+ */
+inline uint32_t demuxClosed(uint8_t board, uint16_t gpio) {
+    uint16_t closed = ~gpio;
+    return SWITCHES.demux[board][0][closed & 0xFF] | SWITCHES.demux[board][1][closed >> 8];
+}
+
+// ============================================================================
+// CONSISTENCY CHECKS
+// ============================================================================
+
+constexpr bool motorBoardsValid() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (motorBoardIndex(MOTOR_PIN_MAP[i].mcpAddress) == NO_BOARD) return false;
+    }
+    return true;
+}
+
+constexpr bool motorPinsInRange() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (MOTOR_PIN_MAP[i].in1Pin > 15 || MOTOR_PIN_MAP[i].in2Pin > 15) return false;
+    }
+    return true;
+}
+
+constexpr bool motorPinsUnique() {
+    // Summed bit counts equal the mask's bit count only if no two pins overlap
+    uint8_t used[NUM_MOTOR_BOARDS] = {};
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (MOTOR_PIN_MAP[i].in1Pin == MOTOR_PIN_MAP[i].in2Pin) return false;
+        used[MOTORS.board[i]] += 2;
+    }
+    for (uint8_t board = 0; board < NUM_MOTOR_BOARDS; board++) {
+        uint8_t bits = 0;
+        for (uint8_t pin = 0; pin < 16; pin++) {
+            if (MOTORS.outputMask[board] & (1U << pin)) bits++;
+        }
+        if (bits != used[board]) return false;
+    }
+    return true;
+}
+
+constexpr bool switchBoardsValid() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (switchBoardIndex(SWITCH_PIN_MAP[i].mcpAddress) == NO_BOARD) return false;
+    }
+    return true;
+}
+
+constexpr bool switchPinsInRange() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (SWITCH_PIN_MAP[i].pin > 15) return false;
+    }
+    return true;
+}
+
+constexpr bool switchPinsUnique() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        const SwitchPinMap& pin = SWITCH_PIN_MAP[i];
+        if (SWITCHES.pinToSwitch[switchBoardIndex(pin.mcpAddress)][pin.pin] != i) return false;
+    }
+    return true;
+}
+
+constexpr bool boardAddressesDistinct() {
+    for (uint8_t m = 0; m < NUM_MOTOR_BOARDS; m++) {
+        if (switchBoardIndex(MOTOR_BOARD_ADDRESS[m]) != NO_BOARD) return false;
+        for (uint8_t other = m + 1; other < NUM_MOTOR_BOARDS; other++) {
+            if (MOTOR_BOARD_ADDRESS[m] == MOTOR_BOARD_ADDRESS[other]) return false;
+        }
+    }
+    return SWITCH_BOARD_ADDRESS[0] != SWITCH_BOARD_ADDRESS[1];
+}
+
+static_assert(NUM_MOTORS <= 32, "Motor and switch words are 32-bit masks");
+static_assert(NUM_SWITCH_BOARDS == 2, "SWITCH_BOARD_ADDRESS lists two switch boards");
+static_assert(boardAddressesDistinct(), "MCP board addresses must be distinct");
+static_assert(motorBoardsValid(), "MOTOR_PIN_MAP uses an address that is not a motor board");
+static_assert(motorPinsInRange(), "MOTOR_PIN_MAP pin outside 0-15");
+static_assert(motorPinsUnique(), "MOTOR_PIN_MAP drives a pin from more than one signal");
+static_assert(switchBoardsValid(), "SWITCH_PIN_MAP uses an address that is not a switch board");
+static_assert(switchPinsInRange(), "SWITCH_PIN_MAP pin outside 0-15");
+static_assert(switchPinsUnique(), "SWITCH_PIN_MAP wires two switches to one pin");
+
+} // namespace PinTopology
+
+#endif // PIN_TOPOLOGY_H
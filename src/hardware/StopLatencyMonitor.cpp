@@ -0,0 +1,76 @@
+/**
+ * Stop Latency Monitor Implementation
+ */
+
+#include "StopLatencyMonitor.h"
+#include "../utils/Logger.h"
+
+// Static member initialization
+LatencyHistogram StopLatencyMonitor::motorHistograms[NUM_MOTORS];
+LatencyHistogram StopLatencyMonitor::sourceHistograms[STOP_SOURCE_COUNT];
+
+void StopLatencyMonitor::record(uint8_t motorIndex, StopSource source, uint64_t observedUs, uint64_t stoppedUs) {
+    if (motorIndex >= NUM_MOTORS || source >= STOP_SOURCE_COUNT) {
+        return;
+    }
+
+    uint64_t latency = (stoppedUs > observedUs) ? stoppedUs - observedUs : 0;
+    uint32_t latencyUs = (latency > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)latency;
+
+    motorHistograms[motorIndex].record(latencyUs);
+    sourceHistograms[source].record(latencyUs);
+
+    Logger::logf(LOG_DEBUG, CAT_HOMING, "Motor %d: switch-to-stop %lu us (%s)",
+                 motorIndex, (unsigned long)latencyUs, getSourceName(source));
+}
+
+const LatencyHistogram& StopLatencyMonitor::getMotorHistogram(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        motorIndex = 0;
+    }
+    return motorHistograms[motorIndex];
+}
+
+const LatencyHistogram& StopLatencyMonitor::getSourceHistogram(StopSource source) {
+    if (source >= STOP_SOURCE_COUNT) {
+        source = STOP_SOURCE_POLL;
+    }
+    return sourceHistograms[source];
+}
+
+void StopLatencyMonitor::reset() {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        motorHistograms[i].reset();
+    }
+    for (uint8_t s = 0; s < STOP_SOURCE_COUNT; s++) {
+        sourceHistograms[s].reset();
+    }
+}
+
+void StopLatencyMonitor::print() {
+    Logger::info(CAT_HOMING, "Switch-to-stop latency:");
+
+    for (uint8_t s = 0; s < STOP_SOURCE_COUNT; s++) {
+        if (sourceHistograms[s].getCount() > 0) {
+            sourceHistograms[s].print(CAT_HOMING, getSourceName((StopSource)s));
+        }
+    }
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        const LatencyHistogram& h = motorHistograms[i];
+        if (h.getCount() == 0) {
+            continue;
+        }
+        Logger::logf(LOG_INFO, CAT_HOMING, "  Motor %02d: %3lu stops, mean %6lu us, max %6lu us, last %6lu us",
+                     i, (unsigned long)h.getCount(), (unsigned long)h.getMean(),
+                     (unsigned long)h.getMax(), (unsigned long)h.getLast());
+    }
+}
+
+const char* StopLatencyMonitor::getSourceName(StopSource source) {
+    switch (source) {
+        case STOP_SOURCE_INTERRUPT: return "interrupt";
+        case STOP_SOURCE_POLL:      return "poll";
+        default:                    return "unknown";
+    }
+}
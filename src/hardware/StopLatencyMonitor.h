@@ -0,0 +1,63 @@
+/**
+ * Stop Latency Monitor
+ *
+ * Measures how long a motor keeps running after its limit switch is
+ * observed closed: from the switch observation (interrupt or poll read)
+ * to completion of the I2C write that stops the motor. Kept per motor
+ * and per detection path.
+ */
+
+#ifndef STOP_LATENCY_MONITOR_H
+#define STOP_LATENCY_MONITOR_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../utils/LatencyHistogram.h"
+
+// How a switch closure was detected
+enum StopSource {
+    STOP_SOURCE_INTERRUPT,  // MCP23017 interrupt-on-change
+    STOP_SOURCE_POLL,       // I2C poll of the switch
+    STOP_SOURCE_COUNT
+};
+
+class StopLatencyMonitor {
+public:
+    /**
+     * Record one switch-to-stop measurement
+     * @param observedUs Clock time the switch was seen closed
+     * @param stoppedUs Clock time the stop write completed
+     */
+    static void record(uint8_t motorIndex, StopSource source, uint64_t observedUs, uint64_t stoppedUs);
+
+    /**
+     * Get a motor's histogram (all sources)
+     */
+    static const LatencyHistogram& getMotorHistogram(uint8_t motorIndex);
+
+    /**
+     * Get the histogram for one detection path (all motors)
+     */
+    static const LatencyHistogram& getSourceHistogram(StopSource source);
+
+    /**
+     * Clear all histograms
+     */
+    static void reset();
+
+    /**
+     * Print per-path histograms and per-motor summaries
+     */
+    static void print();
+
+    /**
+     * Name of a detection path
+     */
+    static const char* getSourceName(StopSource source);
+
+private:
+    static LatencyHistogram motorHistograms[NUM_MOTORS];
+    static LatencyHistogram sourceHistograms[STOP_SOURCE_COUNT];
+};
+
+#endif // STOP_LATENCY_MONITOR_H
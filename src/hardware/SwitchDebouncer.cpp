@@ -0,0 +1,133 @@
+/**
+ * Switch Debouncer Implementation
+ */
+
+#include "SwitchDebouncer.h"
+
+static_assert(SWITCH_DEBOUNCE_SAMPLES >= 1 && SWITCH_DEBOUNCE_SAMPLES <= 7,
+              "SWITCH_DEBOUNCE_SAMPLES must fit the 3-bit vertical counter");
+
+uint32_t SwitchDebouncer::stable = 0;
+uint32_t SwitchDebouncer::count0 = 0;
+uint32_t SwitchDebouncer::count1 = 0;
+uint32_t SwitchDebouncer::count2 = 0;
+uint8_t SwitchDebouncer::settleSamples = SWITCH_DEBOUNCE_SAMPLES;
+bool SwitchDebouncer::sampled = false;
+uint64_t SwitchDebouncer::lastSampleUs = 0;
+uint64_t SwitchDebouncer::runStartUs[NUM_MOTORS] = {0};
+uint64_t SwitchDebouncer::edgeUs[NUM_MOTORS] = {0};
+uint32_t SwitchDebouncer::edgeCount = 0;
+uint32_t SwitchDebouncer::rejectedCount = 0;
+
+static const uint32_t ALL_SWITCHES = (1UL << NUM_MOTORS) - 1;
+
+uint32_t SwitchDebouncer::update(uint32_t raw, uint64_t nowUs) {
+    raw &= ALL_SWITCHES;
+
+    // A gap in sampling breaks the consecutive-sample guarantee
+    if (!sampled || nowUs - lastSampleUs > (uint64_t)SWITCH_DEBOUNCE_STALE_MS * 1000) {
+        reset(raw, nowUs);
+        return 0;
+    }
+    lastSampleUs = nowUs;
+
+    // Switches reading against their stable state count up; the rest reset
+    uint32_t delta = raw ^ stable;
+    uint32_t pending = count0 | count1 | count2;
+
+    uint32_t next0 = ~count0 & delta;
+    uint32_t next1 = (count1 ^ count0) & delta;
+    uint32_t next2 = (count2 ^ (count1 & count0)) & delta;
+
+    // Changes that disagreed last sample but not now were bounce
+    uint32_t bounced = pending & ~delta;
+    while (bounced) {
+        rejectedCount++;
+        bounced &= bounced - 1;
+    }
+
+    // Timestamp the first sample of each new run
+    uint32_t started = delta & ~pending;
+    while (started) {
+        uint8_t i = __builtin_ctz(started);
+        runStartUs[i] = nowUs;
+        started &= started - 1;
+    }
+
+    // Counters equal to the settle window, compared one bit plane at a time
+    uint32_t target0 = (settleSamples & 1) ? 0xFFFFFFFFUL : 0;
+    uint32_t target1 = (settleSamples & 2) ? 0xFFFFFFFFUL : 0;
+    uint32_t target2 = (settleSamples & 4) ? 0xFFFFFFFFUL : 0;
+    uint32_t settled = delta & ~(next0 ^ target0) & ~(next1 ^ target1) & ~(next2 ^ target2);
+
+    stable ^= settled;
+    count0 = next0 & ~settled;
+    count1 = next1 & ~settled;
+    count2 = next2 & ~settled;
+
+    uint32_t edges = settled;
+    while (edges) {
+        uint8_t i = __builtin_ctz(edges);
+        edgeUs[i] = runStartUs[i];
+        edgeCount++;
+        edges &= edges - 1;
+    }
+
+    return settled;
+}
+
+void SwitchDebouncer::reset(uint32_t raw, uint64_t nowUs) {
+    stable = raw & ALL_SWITCHES;
+    count0 = 0;
+    count1 = 0;
+    count2 = 0;
+    sampled = true;
+    lastSampleUs = nowUs;
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        edgeUs[i] = 0;
+    }
+}
+
+uint32_t SwitchDebouncer::getStable() {
+    return stable;
+}
+
+bool SwitchDebouncer::isTriggered(uint8_t switchIndex) {
+    return switchIndex < NUM_MOTORS && (stable & (1UL << switchIndex));
+}
+
+bool SwitchDebouncer::hasSample() {
+    return sampled;
+}
+
+uint64_t SwitchDebouncer::getLastSampleUs() {
+    return lastSampleUs;
+}
+
+uint64_t SwitchDebouncer::getEdgeTimeUs(uint8_t switchIndex) {
+    return switchIndex < NUM_MOTORS ? edgeUs[switchIndex] : 0;
+}
+
+void SwitchDebouncer::setSettleSamples(uint8_t samples) {
+    if (samples < 1) samples = 1;
+    if (samples > 7) samples = 7;
+
+    // Counters above a smaller window would never match it again
+    settleSamples = samples;
+    count0 = 0;
+    count1 = 0;
+    count2 = 0;
+}
+
+uint8_t SwitchDebouncer::getSettleSamples() {
+    return settleSamples;
+}
+
+uint32_t SwitchDebouncer::getEdgeCount() {
+    return edgeCount;
+}
+
+uint32_t SwitchDebouncer::getRejectedCount() {
+    return rejectedCount;
+}
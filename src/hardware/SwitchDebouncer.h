@@ -0,0 +1,90 @@
+/**
+ * Switch Debouncer
+ *
+ * Debounces all 24 limit switches at once on the 32-bit switch word. Each
+ * switch has a 3-bit counter held "vertically" across three words (bit N
+ * of each word is one bit of switch N's counter), so one sample costs a
+ * handful of word operations regardless of how many switches bounce.
+ *
+ * A switch changes its stable state after it has read the opposite value
+ * for the settle window (a number of consecutive samples); any sample that
+ * agrees with the stable state resets its counter. Each accepted edge is
+ * timestamped with the first sample of the run that confirmed it.
+ */
+
+#ifndef SWITCH_DEBOUNCER_H
+#define SWITCH_DEBOUNCER_H
+
+#include <Arduino.h>
+#include "../config.h"
+
+class SwitchDebouncer {
+public:
+    /**
+     * Feed one raw sample of the switch word
+     * Restarts from the sample if the last one is older than SWITCH_DEBOUNCE_STALE_MS.
+     * @param raw Bit N set = switch N read triggered
+     * @param nowUs Clock::nowMicros() of the sample
+     * @return Switches whose stable state changed on this sample
+     */
+    static uint32_t update(uint32_t raw, uint64_t nowUs);
+
+    /**
+     * Take a sample as the stable state without debouncing it
+     */
+    static void reset(uint32_t raw, uint64_t nowUs);
+
+    /**
+     * Debounced switch word (bit N set = switch N triggered)
+     */
+    static uint32_t getStable();
+
+    /**
+     * Check if a switch's debounced state is triggered
+     */
+    static bool isTriggered(uint8_t switchIndex);
+
+    /**
+     * Check if any sample has been taken
+     */
+    static bool hasSample();
+
+    /**
+     * Clock::nowMicros() of the most recent sample
+     */
+    static uint64_t getLastSampleUs();
+
+    /**
+     * Clock::nowMicros() when a switch's current stable state began
+     * (0 = unchanged since the debouncer was last reset)
+     */
+    static uint64_t getEdgeTimeUs(uint8_t switchIndex);
+
+    /**
+     * Set the settle window
+     * @param samples Consecutive samples a change must hold (1-7; 1 = no debouncing)
+     */
+    static void setSettleSamples(uint8_t samples);
+    static uint8_t getSettleSamples();
+
+    /**
+     * Number of accepted edges and of changes rejected as bounce since boot
+     */
+    static uint32_t getEdgeCount();
+    static uint32_t getRejectedCount();
+
+private:
+    static uint32_t stable;
+    static uint32_t count0;             // Vertical counter bit 0
+    static uint32_t count1;             // Vertical counter bit 1
+    static uint32_t count2;             // Vertical counter bit 2
+    static uint8_t settleSamples;
+    static bool sampled;
+    static uint64_t lastSampleUs;
+    static uint64_t runStartUs[NUM_MOTORS];  // First sample of each switch's pending change
+    static uint64_t edgeUs[NUM_MOTORS];
+    static uint32_t edgeCount;
+    static uint32_t rejectedCount;
+};
+
+#endif // SWITCH_DEBOUNCER_H
@@ -3,8 +3,29 @@
  */
 
 #include "SwitchReader.h"
+#include "MotorController.h"
+#include "PinTopology.h"
+#include "../utils/Clock.h"
 
 bool SwitchReader::initialized = false;
+bool SwitchReader::irqActive = false;
+TaskHandle_t SwitchReader::irqTask = nullptr;
+portMUX_TYPE SwitchReader::irqMux = portMUX_INITIALIZER_UNLOCKED;
+volatile uint32_t SwitchReader::armedMask = 0;
+volatile uint32_t SwitchReader::latchedMask = 0;
+uint64_t SwitchReader::latchFiredUs[NUM_MOTORS] = {0};
+uint64_t SwitchReader::latchStoppedUs[NUM_MOTORS] = {0};
+volatile int64_t SwitchReader::irqTimeUs[NUM_SWITCH_BOARDS] = {0};
+volatile uint32_t SwitchReader::irqCount = 0;
+bool SwitchReader::samplerRunning = false;
+TaskHandle_t SwitchReader::samplerTask = nullptr;
+portMUX_TYPE SwitchReader::sampleMux = portMUX_INITIALIZER_UNLOCKED;
+SwitchSnapshot SwitchReader::snapshots[SWITCH_SNAPSHOT_RING];
+uint32_t SwitchReader::latestSequence = 0;
+uint32_t SwitchReader::sampleFailures = 0;
+
+using PinTopology::SWITCH_BOARD_ADDRESS;
+static const uint8_t SWITCH_INT_PIN[NUM_SWITCH_BOARDS] = {SWITCH_INT_PIN_0, SWITCH_INT_PIN_1};
 
 bool SwitchReader::begin() {
     Logger::info(CAT_SWITCH, "Initializing Switch Reader...");
@@ -83,10 +104,13 @@ uint8_t SwitchReader::readAllSwitches(bool states[NUM_MOTORS]) {
 
     Logger::debug(CAT_SWITCH, "Reading all switches...");
 
+    uint32_t triggered;
+    uint32_t valid;
+    readBoards(triggered, valid);
+
     for (uint8_t i = 0; i < NUM_MOTORS; i++) {
-        uint8_t value;
-        if (readSwitch(i, value)) {
-            states[i] = (value == LOW);  // LOW = triggered
+        if (valid & (1UL << i)) {
+            states[i] = (triggered & (1UL << i)) != 0;
             successCount++;
         } else {
             states[i] = false;  // Default to not triggered on error
@@ -99,6 +123,184 @@ uint8_t SwitchReader::readAllSwitches(bool states[NUM_MOTORS]) {
     return successCount;
 }
 
+bool SwitchReader::readSnapshot(uint32_t& triggered) {
+    if (!initialized) {
+        return false;
+    }
+
+    uint32_t valid;
+    readBoards(triggered, valid);
+    return valid == (1UL << NUM_MOTORS) - 1;
+}
+
+bool SwitchReader::sample() {
+    uint32_t triggered;
+    bool success = readSnapshot(triggered);
+
+    portENTER_CRITICAL(&sampleMux);
+    if (success) {
+        // Timestamped inside the lock so samples from two tasks stay in order
+        uint64_t nowUs = Clock::nowMicros();
+        SwitchDebouncer::update(triggered, nowUs);
+
+        uint32_t sequence = latestSequence + 1;
+        SwitchSnapshot& slot = snapshots[sequence % SWITCH_SNAPSHOT_RING];
+        slot.sequence = sequence;
+        slot.timeUs = nowUs;
+        slot.raw = triggered;
+        slot.stable = SwitchDebouncer::getStable();
+        latestSequence = sequence;
+    } else {
+        sampleFailures++;
+    }
+    portEXIT_CRITICAL(&sampleMux);
+
+    return success;
+}
+
+bool SwitchReader::beginSampler() {
+    if (!initialized) {
+        Logger::error(CAT_SWITCH, "Switch Reader not initialized");
+        return false;
+    }
+
+    if (samplerRunning) {
+        return true;
+    }
+
+    if (xTaskCreatePinnedToCore(samplerTaskMain, "switch_sample", 4096, nullptr,
+                                SWITCH_SAMPLER_TASK_PRIORITY, &samplerTask,
+                                SWITCH_SAMPLER_TASK_CORE) != pdPASS) {
+        Logger::error(CAT_SWITCH, "Failed to start switch sampler task - switches read on demand");
+        return false;
+    }
+
+    samplerRunning = true;
+    Logger::logf(LOG_INFO, CAT_SWITCH, "Switch sampler running every %d ms on core %d",
+                 SWITCH_SAMPLE_INTERVAL_MS, SWITCH_SAMPLER_TASK_CORE);
+    return true;
+}
+
+bool SwitchReader::samplerActive() {
+    return samplerRunning;
+}
+
+void SwitchReader::sampleIfNoSampler() {
+    // The sampler paces itself on real time, so virtual-time runs sample here
+    if (!samplerRunning || Clock::isVirtual()) {
+        sample();
+    }
+}
+
+void SwitchReader::samplerTaskMain(void* arg) {
+    TickType_t lastWake = xTaskGetTickCount();
+    bool failing = false;
+
+    for (;;) {
+        // Under virtual time the motion task samples on its own clock
+        if (Clock::isVirtual()) {
+            vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SWITCH_SAMPLE_INTERVAL_MS));
+            continue;
+        }
+
+        bool success = sample();
+
+        // Log transitions only - a dead board would otherwise log 100 times a second
+        if (!success && !failing) {
+            Logger::warning(CAT_SWITCH, "Switch sampler: read failed - cached state is going stale");
+        } else if (success && failing) {
+            Logger::info(CAT_SWITCH, "Switch sampler: reads recovered");
+        }
+        failing = !success;
+
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SWITCH_SAMPLE_INTERVAL_MS));
+    }
+}
+
+bool SwitchReader::getLatestSnapshot(SwitchSnapshot& snapshot) {
+    portENTER_CRITICAL(&sampleMux);
+    uint32_t sequence = latestSequence;
+    if (sequence != 0) {
+        snapshot = snapshots[sequence % SWITCH_SNAPSHOT_RING];
+    }
+    portEXIT_CRITICAL(&sampleMux);
+
+    return sequence != 0;
+}
+
+bool SwitchReader::getSnapshot(uint32_t sequence, SwitchSnapshot& snapshot) {
+    bool found = false;
+
+    portENTER_CRITICAL(&sampleMux);
+    const SwitchSnapshot& slot = snapshots[sequence % SWITCH_SNAPSHOT_RING];
+    if (sequence != 0 && slot.sequence == sequence) {
+        snapshot = slot;
+        found = true;
+    }
+    portEXIT_CRITICAL(&sampleMux);
+
+    return found;
+}
+
+bool SwitchReader::waitForSnapshot(uint32_t afterSequence, SwitchSnapshot& snapshot, uint32_t timeoutMs) {
+    if (!samplerRunning || Clock::isVirtual()) {
+        return sample() && getLatestSnapshot(snapshot);
+    }
+
+    // Ticks rather than Clock time: the sampler runs on real time
+    TickType_t start = xTaskGetTickCount();
+    for (;;) {
+        if (getLatestSnapshot(snapshot) && snapshot.sequence > afterSequence) {
+            return true;
+        }
+        if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(timeoutMs)) {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+}
+
+bool SwitchReader::getFreshSnapshot(SwitchSnapshot& snapshot) {
+    snapshot.sequence = 0;
+    if (getLatestSnapshot(snapshot) &&
+        Clock::nowMicros() - snapshot.timeUs <= (uint64_t)SWITCH_SNAPSHOT_MAX_AGE_MS * 1000) {
+        return true;
+    }
+
+    return waitForSnapshot(snapshot.sequence, snapshot, SWITCH_SNAPSHOT_MAX_AGE_MS);
+}
+
+bool SwitchReader::isTriggeredDebounced(uint8_t switchIndex) {
+    portENTER_CRITICAL(&sampleMux);
+    bool triggered = SwitchDebouncer::isTriggered(switchIndex);
+    portEXIT_CRITICAL(&sampleMux);
+
+    return triggered;
+}
+
+uint64_t SwitchReader::getEdgeTimeUs(uint8_t switchIndex) {
+    portENTER_CRITICAL(&sampleMux);
+    uint64_t edgeUs = SwitchDebouncer::getEdgeTimeUs(switchIndex);
+    portEXIT_CRITICAL(&sampleMux);
+
+    return edgeUs;
+}
+
+void SwitchReader::readBoards(uint32_t& triggered, uint32_t& valid) {
+    triggered = 0;
+    valid = 0;
+
+    for (uint8_t board = 0; board < NUM_SWITCH_BOARDS; board++) {
+        uint16_t raw;
+        if (!GPIOExpander::readGPIOAB(SWITCH_BOARD_ADDRESS[board], raw)) {
+            continue;
+        }
+
+        triggered |= PinTopology::demuxClosed(board, raw);
+        valid |= PinTopology::SWITCHES.boardSwitches[board];
+    }
+}
+
 void SwitchReader::printAllSwitches() {
     if (!initialized) {
         Logger::error(CAT_SWITCH, "Switch Reader not initialized");
@@ -109,8 +311,18 @@ void SwitchReader::printAllSwitches() {
     Logger::info(CAT_SWITCH, "LIMIT SWITCH STATUS");
     Logger::separator();
 
+    // Cached state from the sampler - no bus traffic while motors run
+    SwitchSnapshot snapshot;
+    if (!getFreshSnapshot(snapshot)) {
+        Logger::error(CAT_SWITCH, "No recent switch sample - check the switch boards");
+        Logger::separator();
+        return;
+    }
+
     bool states[NUM_MOTORS];
-    readAllSwitches(states);
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        states[i] = (snapshot.stable & (1UL << i)) != 0;
+    }
 
     // Print in groups of 8 for readability
     for (uint8_t group = 0; group < 3; group++) {
@@ -120,8 +332,9 @@ void SwitchReader::printAllSwitches() {
         Logger::logf(LOG_INFO, CAT_SWITCH, "Switches %02d-%02d:", startIdx, endIdx - 1);
 
         for (uint8_t i = startIdx; i < endIdx; i++) {
-            Logger::logf(LOG_INFO, CAT_SWITCH, "  Switch %02d: %s",
-                         i, getStateString(states[i]));
+            bool settling = ((snapshot.raw ^ snapshot.stable) & (1UL << i)) != 0;
+            Logger::logf(LOG_INFO, CAT_SWITCH, "  Switch %02d: %s%s",
+                         i, getStateString(states[i]), settling ? " (settling)" : "");
         }
 
         if (group < 2) {
@@ -138,10 +351,191 @@ void SwitchReader::printAllSwitches() {
     Logger::info(CAT_SWITCH, "");
     Logger::logf(LOG_INFO, CAT_SWITCH, "Summary: %d triggered, %d open",
                  triggeredCount, NUM_MOTORS - triggeredCount);
+    Logger::logf(LOG_INFO, CAT_SWITCH, "Interrupts: %s (%lu handled)",
+                 irqActive ? "active" : "off - polling", (unsigned long)irqCount);
+    Logger::logf(LOG_INFO, CAT_SWITCH, "Sampler: %s (snapshot #%lu, %lu ms old, %lu failed reads)",
+                 samplerRunning ? "running" : "off - read on demand",
+                 (unsigned long)snapshot.sequence,
+                 (unsigned long)((Clock::nowMicros() - snapshot.timeUs) / 1000),
+                 (unsigned long)sampleFailures);
+    Logger::logf(LOG_INFO, CAT_SWITCH, "Debounce: %u samples x %d ms (%lu edges, %lu bounces rejected)",
+                 SwitchDebouncer::getSettleSamples(),
+                 samplerRunning ? SWITCH_SAMPLE_INTERVAL_MS : SWITCH_POLL_INTERVAL_MS,
+                 (unsigned long)SwitchDebouncer::getEdgeCount(),
+                 (unsigned long)SwitchDebouncer::getRejectedCount());
 
     Logger::separator();
 }
 
+bool SwitchReader::beginInterrupts() {
+#if SWITCH_INTERRUPTS_ENABLED
+    if (!initialized) {
+        Logger::error(CAT_SWITCH, "Switch Reader not initialized");
+        return false;
+    }
+
+    if (irqActive) {
+        return true;
+    }
+
+    Logger::info(CAT_SWITCH, "Enabling switch interrupts...");
+
+    if (xTaskCreatePinnedToCore(irqTaskMain, "switch_irq", 4096, nullptr,
+                                SWITCH_IRQ_TASK_PRIORITY, &irqTask, SWITCH_IRQ_TASK_CORE) != pdPASS) {
+        Logger::error(CAT_SWITCH, "Failed to start switch interrupt task - using polling");
+        return false;
+    }
+
+    for (uint8_t board = 0; board < NUM_SWITCH_BOARDS; board++) {
+        if (!GPIOExpander::configureInterrupts(SWITCH_BOARD_ADDRESS[board],
+                                              PinTopology::SWITCHES.inputMask[board])) {
+            Logger::error(CAT_SWITCH, "Failed to configure switch interrupts - using polling");
+            return false;
+        }
+        ::pinMode(SWITCH_INT_PIN[board], INPUT);
+    }
+
+    attachInterrupt(digitalPinToInterrupt(SWITCH_INT_PIN_0), onBoard0Interrupt, FALLING);
+    attachInterrupt(digitalPinToInterrupt(SWITCH_INT_PIN_1), onBoard1Interrupt, FALLING);
+
+    irqActive = true;
+    Logger::logf(LOG_INFO, CAT_SWITCH, "Switch interrupts active (INT pins %d, %d)",
+                 SWITCH_INT_PIN_0, SWITCH_INT_PIN_1);
+    return true;
+#else
+    Logger::info(CAT_SWITCH, "Switch interrupts disabled - homing uses polling");
+    return false;
+#endif
+}
+
+bool SwitchReader::interruptsActive() {
+    return irqActive;
+}
+
+void SwitchReader::armStopOnTrigger(uint8_t switchIndex) {
+    if (switchIndex >= NUM_MOTORS) {
+        return;
+    }
+
+    portENTER_CRITICAL(&irqMux);
+    armedMask |= (1UL << switchIndex);
+    latchedMask &= ~(1UL << switchIndex);
+    portEXIT_CRITICAL(&irqMux);
+}
+
+void SwitchReader::disarmStopOnTrigger(uint8_t switchIndex) {
+    if (switchIndex >= NUM_MOTORS) {
+        return;
+    }
+
+    // An interrupt stop in progress holds the output lock until it is written
+    MotorController::lockOutputs();
+    portENTER_CRITICAL(&irqMux);
+    armedMask &= ~(1UL << switchIndex);
+    portEXIT_CRITICAL(&irqMux);
+    MotorController::unlockOutputs();
+}
+
+bool SwitchReader::consumeTrigger(uint8_t switchIndex, uint64_t& firedUs, uint64_t& stoppedUs) {
+    if (switchIndex >= NUM_MOTORS) {
+        return false;
+    }
+
+    bool triggered;
+    portENTER_CRITICAL(&irqMux);
+    triggered = (latchedMask & (1UL << switchIndex)) != 0;
+    if (triggered) {
+        latchedMask &= ~(1UL << switchIndex);
+        firedUs = latchFiredUs[switchIndex];
+        stoppedUs = latchStoppedUs[switchIndex];
+    }
+    portEXIT_CRITICAL(&irqMux);
+
+    return triggered;
+}
+
+uint32_t SwitchReader::getInterruptCount() {
+    return irqCount;
+}
+
+void IRAM_ATTR SwitchReader::onBoard0Interrupt() {
+    BaseType_t woken = pdFALSE;
+    irqTimeUs[0] = esp_timer_get_time();
+    xTaskNotifyFromISR(irqTask, 0x01, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void IRAM_ATTR SwitchReader::onBoard1Interrupt() {
+    BaseType_t woken = pdFALSE;
+    irqTimeUs[1] = esp_timer_get_time();
+    xTaskNotifyFromISR(irqTask, 0x02, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void SwitchReader::irqTaskMain(void* arg) {
+    for (;;) {
+        uint32_t notified = 0;
+        xTaskNotifyWait(0, 0xFFFFFFFF, &notified, pdMS_TO_TICKS(SWITCH_IRQ_RECHECK_MS));
+
+        if (!irqActive) {
+            continue;
+        }
+
+        for (uint8_t board = 0; board < NUM_SWITCH_BOARDS; board++) {
+            if (notified & (1UL << board)) {
+                handleBoardInterrupt(board, irqTimeUs[board]);
+            } else if (::digitalRead(SWITCH_INT_PIN[board]) == LOW) {
+                // INT still held low: an edge was missed or a capture read failed
+                handleBoardInterrupt(board, esp_timer_get_time());
+            }
+        }
+    }
+}
+
+void SwitchReader::handleBoardInterrupt(uint8_t board, int64_t firedUs) {
+    uint8_t address = SWITCH_BOARD_ADDRESS[board];
+    uint16_t flags, captured;
+
+    // Reading INTCAP releases the INT line
+    if (!GPIOExpander::readInterruptCapture(address, flags, captured)) {
+        return;
+    }
+    irqCount++;
+
+    // INTF only names the first pin to change; INTCAP holds every pin's value
+    // at that moment, so any armed switch that reads closed is stopped
+    uint32_t closed = PinTopology::demuxClosed(board, captured);
+
+    // Holding the output lock from the mask check to the stop write keeps a
+    // stop from landing after the motion task disarmed and reversed the motor
+    MotorController::lockOutputs();
+
+    portENTER_CRITICAL(&irqMux);
+    uint32_t stopMask = closed & armedMask;
+    armedMask &= ~stopMask;
+    portEXIT_CRITICAL(&irqMux);
+
+    if (stopMask == 0) {
+        MotorController::unlockOutputs();
+        return;
+    }
+
+    MotorController::setMotorDirections(stopMask, MOTOR_STOP);
+    uint64_t stoppedUs = Clock::nowMicros();
+
+    portENTER_CRITICAL(&irqMux);
+    latchedMask |= stopMask;
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (stopMask & (1UL << i)) {
+            latchFiredUs[i] = (uint64_t)firedUs;
+            latchStoppedUs[i] = stoppedUs;
+        }
+    }
+    portEXIT_CRITICAL(&irqMux);
+
+    MotorController::unlockOutputs();
+}
+
 const char* SwitchReader::getStateString(bool triggered) {
     return triggered ? "TRIGGERED (closed)" : "OPEN";
 }
@@ -9,9 +9,22 @@
 #define SWITCH_READER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "../config.h"
 #include "../utils/Logger.h"
 #include "GPIOExpander.h"
+#include "SwitchDebouncer.h"
+
+/**
+ * One background read of every switch
+ */
+struct SwitchSnapshot {
+    uint32_t sequence;      // Increments every sample (0 = none yet)
+    uint64_t timeUs;        // Clock::nowMicros() of the sample
+    uint32_t raw;           // Bit N set = switch N read triggered
+    uint32_t stable;        // Debounced state after this sample
+};
 
 class SwitchReader {
 public:
@@ -43,6 +56,110 @@ public:
      */
     static uint8_t readAllSwitches(bool states[NUM_MOTORS]);
 
+    /**
+     * Read all 24 switches with one GPIOAB transaction per switch board
+     * @param triggered Receives bit N set = switch N triggered (LOW/closed)
+     * @return true if both boards were read
+     */
+    static bool readSnapshot(uint32_t& triggered);
+
+    /**
+     * Read all switches, feed the result to SwitchDebouncer and publish a snapshot
+     * @return true if both boards were read
+     */
+    static bool sample();
+
+    /**
+     * Start the background sampler task (reads every SWITCH_SAMPLE_INTERVAL_MS)
+     * @return true if the task is running; otherwise consumers sample on demand
+     */
+    static bool beginSampler();
+
+    /**
+     * Check if the background sampler is running
+     */
+    static bool samplerActive();
+
+    /**
+     * Take a sample on the calling task unless the background sampler is running
+     * (always under virtual time, which the sampler does not follow)
+     */
+    static void sampleIfNoSampler();
+
+    /**
+     * Get the most recent snapshot (no bus access)
+     * @return false if no sample has been taken yet
+     */
+    static bool getLatestSnapshot(SwitchSnapshot& snapshot);
+
+    /**
+     * Get a recent snapshot by sequence number (no bus access)
+     * @return false if it has not been taken yet or has left the ring
+     */
+    static bool getSnapshot(uint32_t sequence, SwitchSnapshot& snapshot);
+
+    /**
+     * Wait for a snapshot newer than a sequence number
+     * Without the sampler, takes the sample on the calling task.
+     * @param afterSequence Sequence already seen (0 = any snapshot)
+     * @param timeoutMs Longest wait
+     * @return false on timeout or read failure
+     */
+    static bool waitForSnapshot(uint32_t afterSequence, SwitchSnapshot& snapshot, uint32_t timeoutMs);
+
+    /**
+     * Get a snapshot no older than SWITCH_SNAPSHOT_MAX_AGE_MS, waiting for one if needed
+     * @return false if no fresh snapshot could be had
+     */
+    static bool getFreshSnapshot(SwitchSnapshot& snapshot);
+
+    /**
+     * Debounced switch state from the most recent sample (any task, no bus access)
+     */
+    static bool isTriggeredDebounced(uint8_t switchIndex);
+
+    /**
+     * Clock::nowMicros() when a switch's debounced state last changed (any task)
+     */
+    static uint64_t getEdgeTimeUs(uint8_t switchIndex);
+
+    /**
+     * Enable interrupt-on-change on both switch boards and start the handler task
+     * (requires MotorController to be initialized first)
+     * @return true if interrupts are active, false if homing stays on polling
+     */
+    static bool beginInterrupts();
+
+    /**
+     * Check if the interrupt path is active
+     */
+    static bool interruptsActive();
+
+    /**
+     * Stop a motor from the interrupt path as soon as its switch closes
+     * (switch N belongs to motor N). Clears any previous trigger.
+     */
+    static void armStopOnTrigger(uint8_t switchIndex);
+
+    /**
+     * Cancel a pending stop-on-trigger
+     * No interrupt stop for the switch reaches the outputs after this returns.
+     */
+    static void disarmStopOnTrigger(uint8_t switchIndex);
+
+    /**
+     * Check whether the interrupt path has stopped a motor on its switch, and clear it
+     * @param firedUs Receives the Clock time the interrupt fired
+     * @param stoppedUs Receives the Clock time the stop write completed
+     * @return true if the switch triggered since it was armed
+     */
+    static bool consumeTrigger(uint8_t switchIndex, uint64_t& firedUs, uint64_t& stoppedUs);
+
+    /**
+     * Number of switch board interrupts handled
+     */
+    static uint32_t getInterruptCount();
+
     /**
      * Print status of all switches to serial
      */
@@ -58,6 +175,54 @@ public:
 private:
     static bool initialized;
 
+    // Interrupt path state (shared with the handler task)
+    static bool irqActive;
+    static TaskHandle_t irqTask;
+    static portMUX_TYPE irqMux;
+    static volatile uint32_t armedMask;
+    static volatile uint32_t latchedMask;
+    static uint64_t latchFiredUs[NUM_MOTORS];
+    static uint64_t latchStoppedUs[NUM_MOTORS];
+    static volatile int64_t irqTimeUs[NUM_SWITCH_BOARDS];
+    static volatile uint32_t irqCount;
+
+    // Snapshot ring (written by the sampler, read by any task under sampleMux)
+    static bool samplerRunning;
+    static TaskHandle_t samplerTask;
+    static portMUX_TYPE sampleMux;
+    static SwitchSnapshot snapshots[SWITCH_SNAPSHOT_RING];
+    static uint32_t latestSequence;
+    static uint32_t sampleFailures;
+
+    /**
+     * INT pin ISRs - record the time and wake the handler task
+     */
+    static void IRAM_ATTR onBoard0Interrupt();
+    static void IRAM_ATTR onBoard1Interrupt();
+
+    /**
+     * Handler task: reads INTF/INTCAP and stops armed motors
+     */
+    static void irqTaskMain(void* arg);
+
+    /**
+     * Sampler task: reads every switch at a fixed rate
+     */
+    static void samplerTaskMain(void* arg);
+
+    /**
+     * Service one switch board's interrupt
+     * @param firedUs esp_timer time at which the interrupt fired
+     */
+    static void handleBoardInterrupt(uint8_t board, int64_t firedUs);
+
+    /**
+     * Read each switch board once and demux the pins into switch bits
+     * @param triggered Receives bit N set = switch N triggered
+     * @param valid Receives bit N set = switch N was read
+     */
+    static void readBoards(uint32_t& triggered, uint32_t& valid);
+
     /**
      * Validate switch index
      */
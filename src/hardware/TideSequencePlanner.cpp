@@ -0,0 +1,224 @@
+/**
+ * Tide Sequence Planner Implementation
+ */
+
+#include "TideSequencePlanner.h"
+#include "MotionExecutor.h"
+#include "../core/TaskManager.h"
+#include "../utils/Clock.h"
+
+// Static member initialization
+TidePlanResult TideSequencePlanner::lastResult = {0, 0, 0, 0, 0};
+
+void TideSequencePlanner::clearPlan(TidePlan& plan) {
+    plan.moveCount = 0;
+    plan.laneCount = 0;
+    plan.predictedMakespanMs = 0;
+    plan.sequentialTimeMs = 0;
+}
+
+bool TideSequencePlanner::addMove(TidePlan& plan, uint8_t motor, MotorDirection direction, uint16_t durationMs) {
+    if (durationMs == 0 || motor >= NUM_MOTORS || plan.moveCount >= NUM_MOTORS) {
+        return false;
+    }
+
+    PlannedMove& move = plan.moves[plan.moveCount++];
+    move.motor = motor;
+    move.direction = direction;
+    move.durationMs = durationMs;
+    move.lane = 0;
+    move.startOffsetMs = 0;
+    return true;
+}
+
+uint8_t TideSequencePlanner::getLaneLimit(uint8_t maxConcurrent) {
+    uint8_t currentLimit = MOTOR_CURRENT_BUDGET_MA / MOTOR_RUN_CURRENT_MA;
+
+    uint8_t lanes = maxConcurrent;
+    if (lanes > currentLimit) lanes = currentLimit;
+    if (lanes > NUM_MOTORS) lanes = NUM_MOTORS;
+    if (lanes == 0) lanes = 1;
+
+    return lanes;
+}
+
+void TideSequencePlanner::buildPlan(TidePlan& plan, uint8_t maxConcurrent) {
+    uint8_t lanes = getLaneLimit(maxConcurrent);
+    if (lanes > plan.moveCount) {
+        lanes = (plan.moveCount > 0) ? plan.moveCount : 1;
+    }
+    plan.laneCount = lanes;
+    plan.predictedMakespanMs = 0;
+    plan.sequentialTimeMs = 0;
+
+    // Sort longest-first (insertion sort - at most 24 moves)
+    for (uint8_t i = 1; i < plan.moveCount; i++) {
+        PlannedMove key = plan.moves[i];
+        int8_t j = i - 1;
+        while (j >= 0 && plan.moves[j].durationMs < key.durationMs) {
+            plan.moves[j + 1] = plan.moves[j];
+            j--;
+        }
+        plan.moves[j + 1] = key;
+    }
+
+    uint32_t laneFree[NUM_MOTORS] = {0};
+
+    for (uint8_t i = 0; i < plan.moveCount; i++) {
+        PlannedMove& move = plan.moves[i];
+
+        // Lane that becomes available first
+        uint8_t lane = 0;
+        for (uint8_t l = 1; l < lanes; l++) {
+            if (laneFree[l] < laneFree[lane]) {
+                lane = l;
+            }
+        }
+
+        // Push the start later until it is clear of every earlier start
+        uint32_t start = laneFree[lane];
+        bool shifted = true;
+        while (shifted) {
+            shifted = false;
+            for (uint8_t k = 0; k < i; k++) {
+                uint32_t other = plan.moves[k].startOffsetMs;
+                if (start < other + TIDE_START_STAGGER_MS && other < start + TIDE_START_STAGGER_MS) {
+                    start = other + TIDE_START_STAGGER_MS;
+                    shifted = true;
+                }
+            }
+        }
+
+        move.lane = lane;
+        move.startOffsetMs = start;
+        laneFree[lane] = start + move.durationMs;
+
+        if (laneFree[lane] > plan.predictedMakespanMs) {
+            plan.predictedMakespanMs = laneFree[lane];
+        }
+        plan.sequentialTimeMs += move.durationMs;
+    }
+
+    if (plan.moveCount > 1) {
+        plan.sequentialTimeMs += (uint32_t)(plan.moveCount - 1) * PAUSE_BETWEEN_MOTORS_MS;
+    }
+
+    // A freshly built plan has a prediction but no measured result yet
+    lastResult.movesCompleted = 0;
+    lastResult.moveCount = plan.moveCount;
+    lastResult.laneCount = plan.laneCount;
+    lastResult.predictedMakespanMs = plan.predictedMakespanMs;
+    lastResult.actualMakespanMs = 0;
+}
+
+bool TideSequencePlanner::executePlan(const TidePlan& plan) {
+    lastResult.movesCompleted = 0;
+    lastResult.moveCount = plan.moveCount;
+    lastResult.laneCount = plan.laneCount;
+    lastResult.predictedMakespanMs = plan.predictedMakespanMs;
+    lastResult.actualMakespanMs = 0;
+
+    bool started[NUM_MOTORS] = {false};
+    bool running[NUM_MOTORS] = {false};
+    bool laneBusy[NUM_MOTORS] = {false};
+    uint8_t startedCount = 0;
+    uint8_t runningCount = 0;
+    bool aborted = false;
+
+    uint64_t planStart = Clock::nowMillis();
+
+    while (startedCount < plan.moveCount || runningCount > 0) {
+        if (MotorController::isEmergencyStopped()) {
+            Logger::warning(CAT_MOTOR, "Tide plan aborted by emergency stop");
+            aborted = true;
+            break;
+        }
+
+        // Stop finished moves before starting new ones to stay within the current budget
+        MotionExecutor::tick();
+
+        uint32_t elapsed = (uint32_t)(Clock::nowMillis() - planStart);
+
+        for (uint8_t i = 0; i < plan.moveCount; i++) {
+            const PlannedMove& move = plan.moves[i];
+
+            if (running[i] && !MotionExecutor::isMoving(move.motor)) {
+                running[i] = false;
+                laneBusy[move.lane] = false;
+                runningCount--;
+                lastResult.actualMakespanMs = elapsed;
+                if (!MotionExecutor::wasCancelled(move.motor)) {
+                    lastResult.movesCompleted++;
+                }
+            }
+
+            if (started[i] || elapsed < move.startOffsetMs) {
+                continue;
+            }
+
+            // A move that runs late holds back the rest of its lane, so the
+            // number of motors running never exceeds the lane (current) budget
+            if (laneBusy[move.lane] || runningCount >= plan.laneCount ||
+                !lanePredecessorsStarted(plan, i, started)) {
+                continue;
+            }
+
+            started[i] = true;
+            startedCount++;
+            if (MotionExecutor::startMove(move.motor, move.direction, move.durationMs)) {
+                running[i] = true;
+                laneBusy[move.lane] = true;
+                runningCount++;
+            } else {
+                Logger::logf(LOG_ERROR, CAT_MOTOR, "Motor %u failed to run", move.motor);
+            }
+        }
+
+        TaskManager::waitInOperation(1);
+    }
+
+    if (aborted) {
+        lastResult.actualMakespanMs = (uint32_t)(Clock::nowMillis() - planStart);
+    }
+
+    Logger::logf(LOG_INFO, CAT_MOTOR,
+                "Plan makespan: predicted %lu ms, actual %lu ms (%u lanes)",
+                (unsigned long)lastResult.predictedMakespanMs,
+                (unsigned long)lastResult.actualMakespanMs,
+                plan.laneCount);
+
+    return !aborted && lastResult.movesCompleted == plan.moveCount;
+}
+
+void TideSequencePlanner::logPlan(const TidePlan& plan) {
+    Logger::logf(LOG_INFO, CAT_MOTOR, "Tide plan: %u moves in %u lanes",
+                 plan.moveCount, plan.laneCount);
+
+    for (uint8_t i = 0; i < plan.moveCount; i++) {
+        const PlannedMove& move = plan.moves[i];
+        Logger::logf(LOG_INFO, CAT_MOTOR,
+                    "  Lane %u | Motor %02u %s | Start +%lu ms | Run %u ms",
+                    move.lane, move.motor,
+                    MotorController::getDirectionString(move.direction),
+                    (unsigned long)move.startOffsetMs, move.durationMs);
+    }
+
+    Logger::logf(LOG_INFO, CAT_MOTOR,
+                "Predicted makespan: %lu ms (sequential: %lu ms)",
+                (unsigned long)plan.predictedMakespanMs,
+                (unsigned long)plan.sequentialTimeMs);
+}
+
+bool TideSequencePlanner::lanePredecessorsStarted(const TidePlan& plan, uint8_t index, const bool* started) {
+    // Within a lane, moves were packed in index order
+    for (uint8_t k = 0; k < index; k++) {
+        if (plan.moves[k].lane == plan.moves[index].lane && !started[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const TidePlanResult& TideSequencePlanner::getLastResult() {
+    return lastResult;
+}
@@ -0,0 +1,105 @@
+/**
+ * Tide Sequence Planner
+ *
+ * Packs the 24 tide moves into parallel lanes to minimize the total
+ * sequence time (makespan). Moves are assigned longest-first to the lane
+ * that frees up earliest, under a limit on concurrent motors and total
+ * motor current, and starts are staggered to avoid inrush spikes.
+ */
+
+#ifndef TIDE_SEQUENCE_PLANNER_H
+#define TIDE_SEQUENCE_PLANNER_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../utils/Logger.h"
+#include "MotorController.h"
+
+/**
+ * One motor move within a plan
+ */
+struct PlannedMove {
+    uint8_t motor;              // Motor number (0-23)
+    MotorDirection direction;   // MOTOR_FORWARD or MOTOR_REVERSE
+    uint16_t durationMs;        // Run time in milliseconds
+    uint8_t lane;               // Assigned lane (set by buildPlan)
+    uint32_t startOffsetMs;     // Start time relative to plan start (set by buildPlan)
+};
+
+/**
+ * Complete concurrent move plan
+ */
+struct TidePlan {
+    PlannedMove moves[NUM_MOTORS];  // Moves, sorted longest-first after buildPlan
+    uint8_t moveCount;              // Number of valid entries in moves[]
+    uint8_t laneCount;              // Number of lanes used
+    uint32_t predictedMakespanMs;   // Planned time from first start to last stop
+    uint32_t sequentialTimeMs;      // Time the same moves take one after another
+};
+
+/**
+ * Outcome of the most recent plan execution
+ */
+struct TidePlanResult {
+    uint8_t movesCompleted;         // Moves that ran to completion
+    uint8_t moveCount;              // Moves in the plan
+    uint8_t laneCount;              // Lanes used
+    uint32_t predictedMakespanMs;   // Planned makespan
+    uint32_t actualMakespanMs;      // Measured makespan
+};
+
+class TideSequencePlanner {
+public:
+    /**
+     * Reset a plan to contain no moves
+     */
+    static void clearPlan(TidePlan& plan);
+
+    /**
+     * Append a move to a plan (zero-length moves are ignored)
+     * @return true if the move was added
+     */
+    static bool addMove(TidePlan& plan, uint8_t motor, MotorDirection direction, uint16_t durationMs);
+
+    /**
+     * Effective lane count after applying the motor current budget
+     * @param maxConcurrent Requested maximum concurrent motors
+     */
+    static uint8_t getLaneLimit(uint8_t maxConcurrent);
+
+    /**
+     * Assign lanes and start offsets (longest-processing-time-first packing)
+     * @param plan Plan with moves added
+     * @param maxConcurrent Requested maximum concurrent motors
+     */
+    static void buildPlan(TidePlan& plan, uint8_t maxConcurrent);
+
+    /**
+     * Run a built plan through the MotionExecutor (blocks until done)
+     * A move starts no earlier than its offset and only once the previous
+     * move in its lane has stopped.
+     * @param plan Plan prepared by buildPlan()
+     * @return true if every move completed
+     */
+    static bool executePlan(const TidePlan& plan);
+
+    /**
+     * Log the plan (lanes, start offsets, predicted makespan)
+     */
+    static void logPlan(const TidePlan& plan);
+
+    /**
+     * Get the result of the most recently built or executed plan
+     */
+    static const TidePlanResult& getLastResult();
+
+private:
+    static TidePlanResult lastResult;
+
+    /**
+     * Check that every earlier move in a move's lane has been started
+     */
+    static bool lanePredecessorsStarted(const TidePlan& plan, uint8_t index, const bool* started);
+};
+
+#endif // TIDE_SEQUENCE_PLANNER_H
@@ -12,17 +12,36 @@
 #include "hardware/GPIOExpander.h"
 #include "hardware/SwitchReader.h"
 #include "hardware/MotorController.h"
+#include "hardware/MotionExecutor.h"
+#include "hardware/MotionJobQueue.h"
+#include "hardware/EmergencyStop.h"
+#include "hardware/MotorSpeedModel.h"
+#include "hardware/MotorTelemetry.h"
+#include "hardware/StopLatencyMonitor.h"
 #include "hardware/LEDController.h"
 #include "core/StateManager.h"
 #include "core/ConfigManager.h"
+#include "core/RehomeScheduler.h"
+#include "core/ContinuousTracker.h"
+#include "core/RollingWindow.h"
+#include "core/TaskManager.h"
+#include "core/MotionCommandQueue.h"
 #include "network/WiFiManager.h"
 #include "network/WebServer.h"
 #include "network/TimeManager.h"
 #include "data/TideData.h"
+#include "utils/BoundedQueue.h"
+
+#ifdef TIDECLOCK_SIM
+#include "sim/PlantSimulator.h"
+#endif
 
 // Forward declarations
 void printHelp();
-void processSerialCommand();
+void processSerialCommand(String command);
+void readConsole();
+void serviceConsole();
+void postSerialCommand(MotionCommand command);
 void systemInitialization();
 
 void setup() {
@@ -79,25 +98,70 @@ void setup() {
     Logger::info(CAT_SYSTEM, "Serial interface: Active");
     Logger::info(CAT_SYSTEM, "NOAA Integration: Enabled");
     Logger::separator();
+
+    // Hand over to the pinned network and motion tasks
+    TaskManager::begin(readConsole, serviceConsole);
 }
 
 void loop() {
-    // Handle web server requests
-    TideClockWebServer::handle();
+    // Everything runs on the network and motion tasks once they have started
+    if (!TaskManager::runFallbackPasses()) {
+        vTaskDelete(nullptr);
+    }
 
-    // Handle WiFi events
-    WiFiManager::handle();
+    // Small delay to prevent overwhelming the system
+    delay(10);
+}
 
-    // Update LED controller
-    LEDController::update();
+// Console lines read by the network task, run by the motion task
+struct ConsoleLine {
+    char text[CONSOLE_LINE_MAX];
+};
 
-    // Check for serial commands
-    if (Serial.available() > 0) {
-        processSerialCommand();
+static BoundedQueue<ConsoleLine, CONSOLE_QUEUE_LENGTH> consoleLines;
+
+void readConsole() {
+    if (Serial.available() <= 0) {
+        return;
     }
 
-    // Small delay to prevent overwhelming the system
-    delay(10);
+    String command = Serial.readStringUntil('\n');
+    command.trim();
+
+    if (command.length() == 0) {
+        return;
+    }
+
+    // Emergency stop must work while the motion task is busy homing or
+    // running a sequence, so it is posted here rather than queued
+    if (command == "S") {
+        Logger::logf(LOG_INFO, CAT_TEST, "Command received: %s", command.c_str());
+        MotionCommand stop = {};
+        stop.type = MOTION_COMMAND_ESTOP;
+        postSerialCommand(stop);
+        return;
+    }
+
+    ConsoleLine line = {};
+    strncpy(line.text, command.c_str(), CONSOLE_LINE_MAX - 1);
+    if (!consoleLines.push(line)) {
+        Logger::error(CAT_TEST, "Console queue full - command dropped");
+    }
+}
+
+void serviceConsole() {
+    // Run serial commands read by the network task
+    ConsoleLine line;
+    while (consoleLines.pop(line)) {
+        processSerialCommand(String(line.text));
+    }
+}
+
+void postSerialCommand(MotionCommand command) {
+    command.source = COMMAND_SOURCE_SERIAL;
+    if (MotionCommandQueue::post(command) == 0) {
+        Logger::error(CAT_TEST, "Motion command queue full - command not queued");
+    }
 }
 
 void systemInitialization() {
@@ -138,8 +202,26 @@ void systemInitialization() {
         Logger::error(CAT_SYSTEM, "Motor controller initialization failed!");
         allSuccess = false;
     }
+    EmergencyStop::begin();  // Falls back to stopping inline without its task
 
-    // Step 7: Initialize LED controller
+    // Step 7: Enable switch interrupts (homing falls back to polling without them)
+    SwitchReader::beginInterrupts();
+    SwitchReader::beginSampler();  // Consumers read switches on demand without it
+
+    // Step 8: Initialize motion executor (non-blocking timed moves)
+    MotionExecutor::begin();
+    MotionJobQueue::begin();
+
+    // Step 9: Load learned motor speeds (position <-> run time conversion)
+    MotorSpeedModel::begin();
+    MotorTelemetry::begin();
+
+    // Step 10: Start drift-budget re-home scheduler
+    RehomeScheduler::begin();
+    ContinuousTracker::begin();
+    RollingWindow::begin();
+
+    // Step 11: Initialize LED controller
     if (!LEDController::begin()) {
         Logger::warning(CAT_SYSTEM, "LED controller initialization failed (non-critical)");
         // LED failure is non-critical, don't set allSuccess to false
@@ -163,11 +245,21 @@ void printHelp() {
     Serial.println("Motor Control Commands:");
     Serial.println("  h [motor]       - Home specific motor (0-23)");
     Serial.println("  H               - Home all motors sequentially");
+    Serial.println("  P [n]           - Home all motors concurrently, n at a time");
     Serial.println("  f [motor] [ms]  - Run motor forward for [ms] milliseconds");
     Serial.println("  r [motor] [ms]  - Run motor reverse for [ms] milliseconds");
+    Serial.println("  m [motor] [ms]  - Move motor to position [ms] of travel from home");
+    Serial.println("  M               - Print learned motor speed model");
+    Serial.println("  T               - Print motor telemetry (run time, homing history)");
+    Serial.println("  D [0|1]         - Print drift budgets (0/1 = disable/enable auto re-home)");
     Serial.println("  s [motor]       - Stop specific motor");
     Serial.println("  S               - Emergency stop all motors");
     Serial.println("  C               - Clear emergency stop");
+    Serial.println("  E               - Emergency stop latency report");
+    Serial.println("  J [0|1]         - Run-time jitter report (0/1 = loop/timer stop)");
+    Serial.println("  j [job]         - List motion jobs, or cancel job [job]");
+    Serial.println("  c [0|1]         - Continuous tide tracking status (0/1 = disable/enable)");
+    Serial.println("  O [0|1]         - Tide display window (0/1 = calendar day/rolling 24 h)");
     Serial.println("");
     Serial.println("Switch Reading Commands:");
     Serial.println("  w [switch]      - Read specific switch state (0-23)");
@@ -175,8 +267,11 @@ void printHelp() {
     Serial.println("");
     Serial.println("I2C Diagnostic Commands:");
     Serial.println("  i               - Scan I2C bus");
-    Serial.println("  I               - Full I2C status report");
+    Serial.println("  I               - Full I2C status and switch-to-stop latency report");
     Serial.println("  v               - Verify all devices");
+#ifdef TIDECLOCK_SIM
+    Serial.println("  Z [0|1]         - Simulated plant state (0/1 = real time/fast-forward runs)");
+#endif
     Serial.println("");
     Serial.println("System Commands:");
     Serial.println("  ?               - Print this help menu");
@@ -186,10 +281,7 @@ void printHelp() {
     Logger::separator();
 }
 
-void processSerialCommand() {
-    String command = Serial.readStringUntil('\n');
-    command.trim();
-
+void processSerialCommand(String command) {
     if (command.length() == 0) {
         return;
     }
@@ -219,16 +311,31 @@ void processSerialCommand() {
                 Logger::error(CAT_TEST, "Invalid motor index. Use: h [0-23]");
                 break;
             }
-            HomingResult result = MotorController::homeSingleMotor(arg1);
-            Logger::logf(LOG_INFO, CAT_TEST, "Homing result: %s",
-                         MotorController::getHomingResultString(result));
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_HOME;
+            command.motor = arg1;
+            postSerialCommand(command);
             break;
         }
 
         case 'H': {  // Home all motors
             Logger::info(CAT_TEST, "Starting full homing sequence...");
-            uint8_t count = MotorController::homeAllMotors();
-            Logger::logf(LOG_INFO, CAT_TEST, "Homed %d/%d motors", count, NUM_MOTORS);
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_HOME_ALL;
+            postSerialCommand(command);
+            break;
+        }
+
+        case 'P': {  // Home all motors concurrently
+            uint8_t maxConcurrent = HOMING_MAX_CONCURRENT;
+            if (arg1 > 0) {
+                maxConcurrent = (arg1 > NUM_MOTORS) ? NUM_MOTORS : arg1;
+            }
+            Logger::logf(LOG_INFO, CAT_TEST, "Starting concurrent homing (%d at a time)...", maxConcurrent);
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_HOME_ALL;
+            command.value = maxConcurrent;
+            postSerialCommand(command);
             break;
         }
 
@@ -237,7 +344,12 @@ void processSerialCommand() {
                 Logger::error(CAT_TEST, "Invalid parameters. Use: f [motor] [milliseconds]");
                 break;
             }
-            MotorController::runMotorForward(arg1, arg2);
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_MOVE;
+            command.motor = arg1;
+            command.direction = MOTOR_FORWARD;
+            command.value = arg2;
+            postSerialCommand(command);
             break;
         }
 
@@ -246,7 +358,65 @@ void processSerialCommand() {
                 Logger::error(CAT_TEST, "Invalid parameters. Use: r [motor] [milliseconds]");
                 break;
             }
-            MotorController::runMotorReverse(arg1, arg2);
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_MOVE;
+            command.motor = arg1;
+            command.direction = MOTOR_REVERSE;
+            command.value = arg2;
+            postSerialCommand(command);
+            break;
+        }
+
+        case 'm': {  // Move motor to position
+            if (arg1 < 0 || arg1 >= NUM_MOTORS || arg2 < 0 || arg2 > MAX_RUN_TIME_MS) {
+                Logger::error(CAT_TEST, "Invalid parameters. Use: m [motor] [0-9000 ms]");
+                break;
+            }
+            Logger::logf(LOG_INFO, CAT_TEST, "Motor %d at %ld ms%s, moving to %d ms",
+                         arg1, (long)MotorController::getPosition(arg1),
+                         MotorController::isPositionKnown(arg1) ? "" : " (not homed)", arg2);
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_MOVE_TO;
+            command.motor = arg1;
+            command.value = arg2;
+            postSerialCommand(command);
+            break;
+        }
+
+        case 'M': {  // Print speed model
+            MotorSpeedModel::printModel();
+            break;
+        }
+
+        case 'T': {  // Motor telemetry
+            MotorTelemetry::printStats();
+            break;
+        }
+
+        case 'D': {  // Drift budgets / auto re-home
+            if (arg1 == 0 || arg1 == 1) {
+                RehomeScheduler::setEnabled(arg1 == 1);
+                break;
+            }
+            RehomeScheduler::printBudgets();
+            break;
+        }
+
+        case 'c': {  // Continuous tide tracking
+            if (arg1 == 0 || arg1 == 1) {
+                ContinuousTracker::setEnabled(arg1 == 1);
+                break;
+            }
+            ContinuousTracker::printStatus();
+            break;
+        }
+
+        case 'O': {  // Tide display window
+            if (arg1 == 0 || arg1 == 1) {
+                RollingWindow::setEnabled(arg1 == 1);
+                break;
+            }
+            RollingWindow::printStatus();
             break;
         }
 
@@ -255,18 +425,51 @@ void processSerialCommand() {
                 Logger::error(CAT_TEST, "Invalid motor index. Use: s [0-23]");
                 break;
             }
-            MotorController::stopMotor(arg1);
-            Logger::logf(LOG_INFO, CAT_TEST, "Motor %d stopped", arg1);
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_STOP;
+            command.motor = arg1;
+            postSerialCommand(command);
             break;
         }
 
         case 'S': {  // Emergency stop all
-            MotorController::emergencyStopAll();
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_ESTOP;
+            postSerialCommand(command);
             break;
         }
 
         case 'C': {  // Clear emergency stop
-            MotorController::clearEmergencyStop();
+            MotionCommand command = {};
+            command.type = MOTION_COMMAND_CLEAR_STOP;
+            postSerialCommand(command);
+            break;
+        }
+
+        case 'E': {  // Emergency stop latency
+            EmergencyStop::printStats();
+            break;
+        }
+
+        case 'J': {  // Run-time jitter report / stop mode
+            if (arg1 == 0 || arg1 == 1) {
+                MotionExecutor::setTimerStopEnabled(arg1 == 1);
+                MotionExecutor::resetTimingStats();
+                break;
+            }
+            MotionExecutor::printTimingStats();
+            break;
+        }
+
+        case 'j': {  // Motion jobs
+            if (arg1 > 0) {
+                MotionCommand command = {};
+                command.type = MOTION_COMMAND_CANCEL_JOB;
+                command.value = arg1;
+                postSerialCommand(command);
+                break;
+            }
+            MotionJobQueue::printJobs();
             break;
         }
 
@@ -276,7 +479,12 @@ void processSerialCommand() {
                 Logger::error(CAT_TEST, "Invalid switch index. Use: w [0-23]");
                 break;
             }
-            bool triggered = SwitchReader::isSwitchTriggered(arg1);
+            SwitchSnapshot snapshot;
+            if (!SwitchReader::getFreshSnapshot(snapshot)) {
+                Logger::error(CAT_TEST, "No recent switch sample");
+                break;
+            }
+            bool triggered = (snapshot.stable & (1UL << arg1)) != 0;
             Logger::logf(LOG_INFO, CAT_TEST, "Switch %d: %s",
                          arg1, SwitchReader::getStateString(triggered));
             break;
@@ -297,8 +505,21 @@ void processSerialCommand() {
 
         case 'I': {  // Full I2C status
             I2CManager::printStatus();
+            GPIOExpander::printBusStats();
+            StopLatencyMonitor::print();
+            break;
+        }
+
+#ifdef TIDECLOCK_SIM
+        case 'Z': {  // Simulated plant state / fast-forward
+            if (arg1 == 0 || arg1 == 1) {
+                PlantSimulator::setFastForward(arg1 == 1);
+                break;
+            }
+            PlantSimulator::printState();
             break;
         }
+#endif
 
         case 'v': {  // Verify all devices
             bool allPresent = I2CManager::verifyAllDevices();
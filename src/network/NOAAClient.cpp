@@ -6,6 +6,7 @@
 #include "TimeManager.h"
 #include "../core/ConfigManager.h"
 #include "../utils/Logger.h"
+#include "../utils/Clock.h"
 #include "../config.h"
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
@@ -95,10 +96,13 @@ NOAAClient::FetchResult NOAAClient::fetchTidePredictions(
         return INCOMPLETE_DATA;
     }
 
-    // Apply motor offsets
-    applyMotorOffsets(output);
-
     // Set metadata
+    uint32_t startTime;
+    if (!parseTimestamp(output->hours[0].timestamp, startTime)) {
+        Logger::error(CAT_SYSTEM, "NOAA: Invalid first timestamp");
+        return PARSE_ERROR;
+    }
+    output->startTime = startTime;
     output->fetchTime = TimeManager::getEpochTime();
     output->isValid = true;
 
@@ -109,6 +113,90 @@ NOAAClient::FetchResult NOAAClient::fetchTidePredictions(
     return SUCCESS;
 }
 
+NOAAClient::FetchResult NOAAClient::fetchPredictionSeries(
+    const char* stationID,
+    TideSeries* output,
+    uint8_t hours,
+    uint16_t timeoutMs
+) {
+    // Validate inputs
+    if (stationID == nullptr || strlen(stationID) == 0) {
+        Logger::error(CAT_SYSTEM, "NOAA: Station ID not provided");
+        return CONFIG_ERROR;
+    }
+
+    if (output == nullptr) {
+        Logger::error(CAT_SYSTEM, "NOAA: Output series is null");
+        return CONFIG_ERROR;
+    }
+
+    // Check time synchronization
+    if (!TimeManager::isTimeSynced()) {
+        Logger::error(CAT_SYSTEM, "NOAA: Time not synchronized");
+        return NO_TIME_SYNC;
+    }
+
+    // Check WiFi connection
+    if (WiFi.status() != WL_CONNECTED) {
+        Logger::error(CAT_SYSTEM, "NOAA: WiFi not connected");
+        return NETWORK_ERROR;
+    }
+
+    // Clear output series
+    memset(output, 0, sizeof(TideSeries));
+    output->isValid = false;
+
+    strncpy(output->stationID, stationID, sizeof(output->stationID) - 1);
+    output->stationID[sizeof(output->stationID) - 1] = '\0';
+
+    String dateStr = TimeManager::getFormattedDate();
+    strncpy(output->date, dateStr.c_str(), sizeof(output->date) - 1);
+    output->date[sizeof(output->date) - 1] = '\0';
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM,
+                "NOAA: Fetching %u h of 6-minute predictions for station %s from %s",
+                hours, stationID, dateStr.c_str());
+
+    String url = buildSeriesURL(stationID, dateStr.c_str(), hours);
+
+    String response;
+    int httpCode = httpGetWithRetry(url, response, timeoutMs);
+
+    if (httpCode != 200) {
+        Logger::logf(LOG_ERROR, CAT_SYSTEM,
+                    "NOAA: HTTP request failed with code %d", httpCode);
+
+        if (httpCode == 404) {
+            return INVALID_STATION;
+        } else if (httpCode < 0) {
+            return TIMEOUT;
+        } else {
+            return NETWORK_ERROR;
+        }
+    }
+
+    if (!parseSeriesJSON(response, output)) {
+        Logger::error(CAT_SYSTEM, "NOAA: Prediction series parsing failed");
+        return PARSE_ERROR;
+    }
+
+    // Every hour requested must be covered (10 samples per hour plus the end point)
+    if (output->count < (uint16_t)hours * 10) {
+        Logger::logf(LOG_ERROR, CAT_SYSTEM,
+                    "NOAA: Incomplete series - expected %u samples, got %u",
+                    hours * 10 + 1, output->count);
+        return INCOMPLETE_DATA;
+    }
+
+    output->fetchTime = TimeManager::getEpochTime();
+    output->isValid = true;
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM,
+                "NOAA: Fetched %u 6-minute predictions", output->count);
+
+    return SUCCESS;
+}
+
 const char* NOAAClient::getErrorMessage(FetchResult result) {
     switch (result) {
         case SUCCESS:
@@ -122,7 +210,7 @@ const char* NOAAClient::getErrorMessage(FetchResult result) {
         case PARSE_ERROR:
             return "Failed to parse response - NOAA API may have changed";
         case INCOMPLETE_DATA:
-            return "Incomplete data - expected 24 hours";
+            return "Incomplete data - expected hourly data for today and tomorrow";
         case NO_TIME_SYNC:
             return "Time not synchronized - sync with NTP first";
         case CONFIG_ERROR:
@@ -137,7 +225,7 @@ String NOAAClient::buildRequestURL(const char* stationID, const char* dateStr) {
     url += "?product=predictions";
     url += "&application=TideClock";
     url += "&begin_date=" + String(dateStr);
-    url += "&end_date=" + String(dateStr);
+    url += "&range=" + String(TIDE_DATASET_HOURS);
     url += "&datum=MLLW";
     url += "&station=" + String(stationID);
     url += "&time_zone=lst_ldt";
@@ -148,9 +236,116 @@ String NOAAClient::buildRequestURL(const char* stationID, const char* dateStr) {
     return url;
 }
 
+String NOAAClient::buildSeriesURL(const char* stationID, const char* dateStr, uint8_t hours) {
+    String url = NOAA_API_BASE;
+    url += "?product=predictions";
+    url += "&application=TideClock";
+    url += "&begin_date=" + String(dateStr);
+    url += "&range=" + String(hours);
+    url += "&datum=MLLW";
+    url += "&station=" + String(stationID);
+    url += "&time_zone=lst_ldt";
+    url += "&units=english";
+    url += "&interval=6";
+    url += "&format=json";
+
+    return url;
+}
+
+bool NOAAClient::parseSeriesJSON(const String& response, TideSeries* output) {
+    // ~40 bytes per sample once parsed; 10 samples per hour
+    DynamicJsonDocument doc(TIDE_SERIES_MAX_SAMPLES * 96);
+
+    DeserializationError error = deserializeJson(doc, response);
+    if (error) {
+        Logger::logf(LOG_ERROR, CAT_SYSTEM,
+                    "NOAA: JSON parse error: %s", error.c_str());
+        return false;
+    }
+
+    // Check for error response from NOAA
+    if (doc.containsKey("error")) {
+        JsonObject errorObj = doc["error"];
+        const char* errorMsg = errorObj["message"] | "Unknown NOAA error";
+        Logger::logf(LOG_ERROR, CAT_SYSTEM, "NOAA API error: %s", errorMsg);
+        return false;
+    }
+
+    JsonArray predictions = doc["predictions"];
+    if (predictions.isNull()) {
+        Logger::error(CAT_SYSTEM, "NOAA: 'predictions' array not found");
+        return false;
+    }
+
+    uint16_t count = 0;
+    for (JsonVariant pred : predictions) {
+        if (count >= TIDE_SERIES_MAX_SAMPLES) {
+            Logger::logf(LOG_WARNING, CAT_SYSTEM,
+                        "NOAA: Series truncated to %u samples", TIDE_SERIES_MAX_SAMPLES);
+            break;
+        }
+
+        const char* timestamp = pred["t"];
+        const char* valueStr = pred["v"];
+        if (timestamp == nullptr || valueStr == nullptr) {
+            continue;
+        }
+
+        uint32_t epoch;
+        if (!parseTimestamp(timestamp, epoch)) {
+            Logger::logf(LOG_WARNING, CAT_SYSTEM,
+                        "NOAA: Invalid timestamp: %s", timestamp);
+            continue;
+        }
+
+        // Interpolation needs strictly ascending times (repeats occur at DST changes)
+        if (count > 0 && epoch <= output->times[count - 1]) {
+            continue;
+        }
+
+        float tideHeight = atof(valueStr);
+        if (isnan(tideHeight)) {
+            continue;
+        }
+
+        output->times[count] = epoch;
+        output->heights[count] = tideHeight;
+        count++;
+    }
+
+    output->count = count;
+    return count >= 2;
+}
+
+bool NOAAClient::parseTimestamp(const char* timestamp, uint32_t& epoch) {
+    if (timestamp == nullptr) {
+        return false;
+    }
+
+    // Expected format: "YYYY-MM-DD HH:MM" (local time)
+    struct tm timeinfo;
+    memset(&timeinfo, 0, sizeof(timeinfo));
+    if (sscanf(timestamp, "%d-%d-%d %d:%d", &timeinfo.tm_year, &timeinfo.tm_mon,
+               &timeinfo.tm_mday, &timeinfo.tm_hour, &timeinfo.tm_min) != 5) {
+        return false;
+    }
+
+    timeinfo.tm_year -= 1900;
+    timeinfo.tm_mon -= 1;
+    timeinfo.tm_isdst = -1;
+
+    time_t t = mktime(&timeinfo);
+    if (t < 0) {
+        return false;
+    }
+
+    epoch = (uint32_t)t;
+    return true;
+}
+
 bool NOAAClient::parseJSON(const String& response, TideDataset* output) {
-    // Create JSON document (8KB should be sufficient for 24 hours)
-    DynamicJsonDocument doc(8192);
+    // Create JSON document (16KB should be sufficient for 48 hours)
+    DynamicJsonDocument doc(16384);
 
     // Parse JSON
     DeserializationError error = deserializeJson(doc, response);
@@ -185,14 +380,17 @@ bool NOAAClient::parseJSON(const String& response, TideDataset* output) {
     }
 
     // Get configuration for scaling
-    const TideClockConfig& config = ConfigManager::getConfig();
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
     float minTide = config.minTideHeight;
     float maxTide = config.maxTideHeight;
     uint16_t maxRunTime = config.maxRunTime;  // Get runtime max motor time
 
     // Parse each prediction
     uint8_t validCount = 0;
-    bool hourSeen[24] = {false};
+    bool hourSeen[TIDE_DATASET_HOURS] = {false};
+    char firstDate[11] = "";
+    char secondDate[11] = "";
 
     for (JsonVariant pred : predictions) {
         JsonObject predObj = pred.as<JsonObject>();
@@ -214,19 +412,35 @@ bool NOAAClient::parseJSON(const String& response, TideDataset* output) {
             continue;
         }
 
+        // Day from the date part: first date = today, second = tomorrow
+        uint8_t day = 0;
+        if (firstDate[0] == '\0') {
+            strncpy(firstDate, timestamp, 10);
+            firstDate[10] = '\0';
+        } else if (strncmp(timestamp, firstDate, 10) != 0) {
+            if (secondDate[0] == '\0') {
+                strncpy(secondDate, timestamp, 10);
+                secondDate[10] = '\0';
+            } else if (strncmp(timestamp, secondDate, 10) != 0) {
+                continue;  // Beyond the two days held (range end point)
+            }
+            day = 1;
+        }
+        uint8_t index = day * 24 + hour;
+
         // Check for duplicate hours
-        if (hourSeen[hour]) {
+        if (hourSeen[index]) {
             Logger::logf(LOG_WARNING, CAT_SYSTEM,
-                        "NOAA: Duplicate hour %u - using first occurrence", hour);
+                        "NOAA: Duplicate hour %u - using first occurrence", index);
             continue;
         }
-        hourSeen[hour] = true;
+        hourSeen[index] = true;
 
         // Parse tide height
         float tideHeight = atof(valueStr);
 
         // Populate hourly data
-        HourlyTideData* hourData = &output->hours[hour];
+        HourlyTideData* hourData = &output->hours[index];
         hourData->hour = hour;
 
         // Copy timestamp
@@ -235,13 +449,13 @@ bool NOAAClient::parseJSON(const String& response, TideDataset* output) {
 
         hourData->rawTideHeight = tideHeight;
         hourData->scaledRunTime = scaleToRunTime(tideHeight, minTide, maxTide, maxRunTime);
-        hourData->finalRunTime = 0;  // Will be set in applyMotorOffsets()
+        hourData->finalRunTime = hourData->scaledRunTime;  // Already clamped to maxRunTime
 
         validCount++;
 
         Logger::logf(LOG_INFO, CAT_SYSTEM,
-                    "NOAA: Hour %02u: %.2f ft -> %u ms",
-                    hour, tideHeight, hourData->scaledRunTime);
+                    "NOAA: Hour %02u%s: %.2f ft -> %u ms",
+                    hour, day ? " (+1)" : "", tideHeight, hourData->scaledRunTime);
     }
 
     output->recordCount = validCount;
@@ -266,15 +480,15 @@ bool NOAAClient::validateData(TideDataset* data) {
     }
 
     // Check record count
-    if (data->recordCount < 24) {
+    if (data->recordCount < TIDE_DATASET_HOURS) {
         Logger::logf(LOG_ERROR, CAT_SYSTEM,
-                    "NOAA: Incomplete data - expected 24 hours, got %u",
-                    data->recordCount);
+                    "NOAA: Incomplete data - expected %u hours, got %u",
+                    TIDE_DATASET_HOURS, data->recordCount);
         return false;
     }
 
-    // Check that all hours 0-23 have valid data
-    for (uint8_t hour = 0; hour < 24; hour++) {
+    // Check that every hour of both days has valid data
+    for (uint8_t hour = 0; hour < TIDE_DATASET_HOURS; hour++) {
         HourlyTideData* hourData = &data->hours[hour];
 
         if (hourData->timestamp[0] == '\0') {
@@ -324,42 +538,6 @@ uint16_t NOAAClient::scaleToRunTime(float tideHeight, float minTide, float maxTi
     return (uint16_t)(scaledTime + 0.5);  // Round to nearest integer
 }
 
-void NOAAClient::applyMotorOffsets(TideDataset* data) {
-    if (data == nullptr) {
-        return;
-    }
-
-    Logger::info(CAT_SYSTEM, "NOAA: Applying motor offsets...");
-
-    // Get configured max run time
-    const TideClockConfig& config = ConfigManager::getConfig();
-    uint16_t maxRunTime = config.maxRunTime;
-
-    for (uint8_t hour = 0; hour < 24; hour++) {
-        HourlyTideData* hourData = &data->hours[hour];
-
-        // Get motor offset for this hour (motor index = hour)
-        float offset = ConfigManager::getMotorOffset(hour);
-
-        // Apply offset
-        float finalTime = hourData->scaledRunTime * offset;
-
-        // Clamp to configured maximum (not hardcoded)
-        if (finalTime > maxRunTime) {
-            finalTime = maxRunTime;
-        }
-
-        // Round and store
-        hourData->finalRunTime = (uint16_t)(finalTime + 0.5);
-
-        if (offset != 1.0) {
-            Logger::logf(LOG_INFO, CAT_SYSTEM,
-                        "NOAA: Hour %02u: offset %.3f -> %u ms -> %u ms",
-                        hour, offset, hourData->scaledRunTime, hourData->finalRunTime);
-        }
-    }
-}
-
 uint8_t NOAAClient::extractHour(const char* timestamp) {
     if (timestamp == nullptr) {
         return 255;
@@ -414,7 +592,7 @@ int NOAAClient::httpGetWithRetry(const String& url, String& response, uint16_t t
             Logger::logf(LOG_WARNING, CAT_SYSTEM,
                         "NOAA: Request failed (code %d), retrying in %lu ms",
                         httpCode, retryDelay);
-            delay(retryDelay);
+            Clock::delayMs(retryDelay);
         }
     }
 
@@ -24,13 +24,13 @@ public:
         TIMEOUT,              // Request timed out
         INVALID_STATION,      // Station ID not found or invalid
         PARSE_ERROR,          // JSON parsing failed
-        INCOMPLETE_DATA,      // Less than 24 hours of data
+        INCOMPLETE_DATA,      // Less than TIDE_DATASET_HOURS hours of data
         NO_TIME_SYNC,         // System time not synchronized
         CONFIG_ERROR          // Missing or invalid configuration
     };
 
     /**
-     * Fetch tide predictions from NOAA API
+     * Fetch hourly tide predictions for today and tomorrow from NOAA API
      *
      * stationID: NOAA station ID (e.g., "8729108")
      * output: Pointer to TideDataset to populate
@@ -44,6 +44,23 @@ public:
         uint16_t timeoutMs = 10000
     );
 
+    /**
+     * Fetch 6-minute tide predictions starting at local midnight today
+     *
+     * stationID: NOAA station ID (e.g., "8729108")
+     * output: Pointer to TideSeries to populate
+     * hours: Hours of predictions to request (from midnight)
+     * timeoutMs: HTTP request timeout in milliseconds
+     *
+     * Returns: FetchResult status code
+     */
+    static FetchResult fetchPredictionSeries(
+        const char* stationID,
+        TideSeries* output,
+        uint8_t hours,
+        uint16_t timeoutMs = 10000
+    );
+
     /**
      * Get human-readable error message for result code
      */
@@ -54,12 +71,43 @@ private:
      * Build NOAA API request URL
      *
      * stationID: NOAA station ID
-     * dateStr: Date in YYYYMMDD format
+     * dateStr: Start date in YYYYMMDD format (TIDE_DATASET_HOURS are requested)
      *
      * Returns: Complete URL string
      */
     static String buildRequestURL(const char* stationID, const char* dateStr);
 
+    /**
+     * Build NOAA API request URL for 6-minute predictions
+     *
+     * stationID: NOAA station ID
+     * dateStr: Start date in YYYYMMDD format
+     * hours: Number of hours from the start of the date
+     *
+     * Returns: Complete URL string
+     */
+    static String buildSeriesURL(const char* stationID, const char* dateStr, uint8_t hours);
+
+    /**
+     * Parse NOAA JSON response of 6-minute predictions
+     *
+     * response: JSON response body from NOAA
+     * output: TideSeries to populate
+     *
+     * Returns: true if at least two ascending samples were parsed
+     */
+    static bool parseSeriesJSON(const String& response, TideSeries* output);
+
+    /**
+     * Convert a local timestamp to Unix time
+     *
+     * timestamp: String in format "YYYY-MM-DD HH:MM"
+     * epoch: Receives the Unix time
+     *
+     * Returns: true if the timestamp was valid
+     */
+    static bool parseTimestamp(const char* timestamp, uint32_t& epoch);
+
     /**
      * Parse NOAA JSON response
      *
@@ -91,15 +139,6 @@ private:
      */
     static uint16_t scaleToRunTime(float tideHeight, float minTide, float maxTide, uint16_t maxRunTime);
 
-    /**
-     * Apply motor-specific offset multipliers
-     *
-     * data: TideDataset with scaledRunTime populated
-     *
-     * Updates finalRunTime for each hour
-     */
-    static void applyMotorOffsets(TideDataset* data);
-
     /**
      * Extract hour from timestamp string
      *
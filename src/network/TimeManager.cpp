@@ -4,6 +4,7 @@
 
 #include "TimeManager.h"
 #include "../utils/Logger.h"
+#include "../utils/Clock.h"
 #include <WiFi.h>
 
 // NTP Configuration
@@ -43,10 +44,10 @@ bool TimeManager::syncWithNTP(uint16_t timeoutMs) {
     configTime(0, 0, NTP_SERVER1, NTP_SERVER2, NTP_SERVER3);
 
     // Wait for time to be set
-    unsigned long startTime = millis();
+    uint64_t startTime = Clock::nowMillis();
     struct tm timeinfo;
 
-    while (millis() - startTime < timeoutMs) {
+    while (Clock::nowMillis() - startTime < timeoutMs) {
         if (getLocalTime(&timeinfo)) {
             // Check if year is reasonable (> 2020)
             if (timeinfo.tm_year + 1900 > 2020) {
@@ -62,7 +63,7 @@ bool TimeManager::syncWithNTP(uint16_t timeoutMs) {
                 return true;
             }
         }
-        delay(100);
+        Clock::delayMs(100);
     }
 
     Logger::error(CAT_SYSTEM, "NTP sync timeout");
@@ -7,10 +7,22 @@
 #include "../config.h"
 #include "../core/StateManager.h"
 #include "../core/ConfigManager.h"
+#include "../core/RehomeScheduler.h"
+#include "../core/ContinuousTracker.h"
+#include "../core/RollingWindow.h"
 #include "../hardware/MotorController.h"
+#include "../hardware/MotionExecutor.h"
+#include "../hardware/MotionJobQueue.h"
+#include "../hardware/EmergencyStop.h"
+#include "../hardware/TideSequencePlanner.h"
+#include "../hardware/MotorSpeedModel.h"
+#include "../hardware/MotorTelemetry.h"
+#include "../hardware/StopLatencyMonitor.h"
 #include "../hardware/SwitchReader.h"
+#include "../hardware/GPIOExpander.h"
 #include "../hardware/LEDController.h"
 #include "../utils/Logger.h"
+#include "../utils/Clock.h"
 #include "WiFiManager.h"
 #include <ArduinoJson.h>
 #include <esp_system.h>
@@ -23,6 +35,7 @@
 // Static member initialization
 WebServer* TideClockWebServer::server = nullptr;
 bool TideClockWebServer::running = false;
+TideDataset TideClockWebServer::tideBuffer;
 
 void TideClockWebServer::begin() {
     Logger::info(CAT_SYSTEM, "Starting web server...");
@@ -40,20 +53,29 @@ void TideClockWebServer::begin() {
     server->on("/api/logs", HTTP_GET, handleGetLogs);
     server->on("/api/home", HTTP_POST, handleHome);
     server->on("/api/emergency-stop", HTTP_POST, handleEmergencyStop);
+    server->on("/api/emergency-stop", HTTP_GET, handleGetEmergencyStop);
     server->on("/api/clear-stop", HTTP_POST, handleClearStop);
     server->on("/api/test-motor", HTTP_POST, handleTestMotor);
+    server->on("/api/motion-job", HTTP_POST, handleSubmitMotionJob);
+    server->on("/api/motion-job", HTTP_GET, handleGetMotionJob);
+    server->on("/api/cancel-motion-job", HTTP_POST, handleCancelMotionJob);
+    server->on("/api/motion-command", HTTP_GET, handleGetMotionCommand);
     server->on("/api/save-config", HTTP_POST, handleSaveConfig);
+    server->on("/api/motion-timing", HTTP_GET, handleGetMotionTiming);
+    server->on("/api/positions", HTTP_GET, handleGetPositions);
+    server->on("/api/reset-speeds", HTTP_POST, handleResetSpeeds);
+    server->on("/api/drift", HTTP_GET, handleGetDrift);
+    server->on("/api/motor-stats", HTTP_GET, handleGetMotorStats);
+    server->on("/api/stop-latency", HTTP_GET, handleGetStopLatency);
 
     // Phase 3: NOAA Integration routes
     server->on("/api/fetch", HTTP_POST, handleFetchTide);
     server->on("/api/tide-data", HTTP_GET, handleGetTideData);
     server->on("/api/run-tide", HTTP_POST, handleRunTide);
     server->on("/api/sync-time", HTTP_POST, handleSyncTime);
-
-    // Motor offset calibration routes
-    server->on("/api/motor-offsets", HTTP_GET, handleGetMotorOffsets);
-    server->on("/api/motor-offsets", HTTP_POST, handleSaveMotorOffsets);
-    server->on("/api/reset-offsets", HTTP_POST, handleResetMotorOffsets);
+    server->on("/api/continuous", HTTP_GET, handleGetContinuous);
+    server->on("/api/continuous", HTTP_POST, handleSetContinuous);
+    server->on("/api/rolling-window", HTTP_POST, handleSetRollingWindow);
 
     // Phase 4: LED Control routes
     server->on("/api/led-config", HTTP_GET, handleGetLEDConfig);
@@ -107,7 +129,7 @@ void TideClockWebServer::handleNotFound() {
 // ============================================================================
 
 void TideClockWebServer::handleGetStatus() {
-    StaticJsonDocument<1024> doc;
+    StaticJsonDocument<1536> doc;
 
     // System state
     doc["state"] = StateManager::getStateName();
@@ -123,7 +145,8 @@ void TideClockWebServer::handleGetStatus() {
     wifi["connected"] = WiFiManager::isConnected();
 
     // Configuration
-    const TideClockConfig& config = ConfigManager::getConfig();
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
     JsonObject cfg = doc.createNestedObject("config");
     cfg["switchRelease"] = config.switchReleaseTime;
     cfg["maxRunTime"] = config.maxRunTime;
@@ -140,6 +163,40 @@ void TideClockWebServer::handleGetStatus() {
     JsonObject motor = doc.createNestedObject("motor");
     motor["emergencyStop"] = MotorController::isEmergencyStopped();
 
+    // Latest homing or tide sequence run by the motion task
+    const MotionOperation& op = MotionCommandQueue::getLastOperation();
+    if (op.startedAt != 0) {
+        JsonObject operation = doc.createNestedObject("operation");
+        operation["type"] = MotionCommandQueue::getTypeName(op.type);
+        operation["running"] = op.running;
+        if (op.type == MOTION_COMMAND_RUN_TIDE) {
+            operation["dryRun"] = op.dryRun;
+        }
+        if (!op.running) {
+            operation["success"] = op.success;
+            operation["durationMs"] = op.finishedAt - op.startedAt;
+            if (op.type != MOTION_COMMAND_RUN_TIDE) {
+                operation["motorsHomed"] = op.motorsHomed;
+            } else if (op.maxConcurrent > 0) {
+                // Concurrent runs report the planned and measured makespan
+                const TidePlanResult& result = TideSequencePlanner::getLastResult();
+                operation["lanes"] = result.laneCount;
+                operation["predictedMakespanMs"] = result.predictedMakespanMs;
+                if (!op.dryRun) {
+                    operation["actualMakespanMs"] = result.actualMakespanMs;
+                }
+            }
+        }
+    }
+
+    // Expander bus usage
+    GPIOBusStats bus = GPIOExpander::getBusStats();
+    JsonObject i2c = doc.createNestedObject("i2c");
+    i2c["transactions"] = bus.transactions;
+    i2c["saved"] = (bus.baselineTransactions > bus.transactions)
+                   ? bus.baselineTransactions - bus.transactions : 0;
+    i2c["errors"] = bus.errors;
+
     // Tide data status (Phase 3)
     JsonObject tideData = doc.createNestedObject("tideData");
     tideData["available"] = false;
@@ -158,13 +215,157 @@ void TideClockWebServer::handleGetStatus() {
 }
 
 void TideClockWebServer::handleGetSwitches() {
-    StaticJsonDocument<512> doc;
+    // Served from the sampler's cache - no bus traffic competing with motor writes
+    SwitchSnapshot snapshot;
+    if (!SwitchReader::getFreshSnapshot(snapshot)) {
+        sendError(503, "No recent switch sample");
+        return;
+    }
+    uint32_t triggered = snapshot.stable;
+
+    StaticJsonDocument<1536> doc;
+    doc["mask"] = triggered;
+    doc["raw"] = snapshot.raw;
+    doc["sequence"] = snapshot.sequence;
+    doc["ageMs"] = (uint32_t)((Clock::nowMicros() - snapshot.timeUs) / 1000);
     JsonArray switches = doc.createNestedArray("switches");
 
     for (int i = 0; i < NUM_MOTORS; i++) {
         JsonObject sw = switches.createNestedObject();
         sw["id"] = i;
-        sw["triggered"] = SwitchReader::isSwitchTriggered(i);
+        sw["triggered"] = (triggered & (1UL << i)) != 0;
+    }
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
+void TideClockWebServer::handleGetMotionTiming() {
+    DynamicJsonDocument doc(3072);  // Per-motor timing for 24 motors
+
+    doc["stopMode"] = MotionExecutor::isTimerStopEnabled() ? "timer" : "loop";
+    doc["timerLeadUs"] = MotionExecutor::getTimerLeadUs();
+    addHistogram(doc.createNestedObject("error"), MotionExecutor::getJitterHistogram());
+
+    // Last completed move per motor: commanded vs measured on-time
+    JsonArray motors = doc.createNestedArray("motors");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        uint16_t commandedMs;
+        uint32_t actualUs;
+        if (!MotionExecutor::getLastMoveTiming(i, commandedMs, actualUs)) {
+            continue;
+        }
+
+        JsonObject motor = motors.createNestedObject();
+        motor["id"] = i;
+        motor["commandedMs"] = commandedMs;
+        motor["actualUs"] = actualUs;
+    }
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
+void TideClockWebServer::handleGetMotorStats() {
+    // 24 motors x 12 fields - too large for a stack document
+    DynamicJsonDocument doc(8192);
+    const MotorTelemetryData& data = MotorTelemetry::getData();
+
+    JsonArray motors = doc.createNestedArray("motors");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        JsonObject motor = motors.createNestedObject();
+        motor["id"] = i;
+        motor["runMsForward"] = data.runMsForward[i];
+        motor["runMsReverse"] = data.runMsReverse[i];
+        motor["moves"] = data.moveCount[i];
+        motor["homes"] = data.homeCount[i];
+        motor["lastHomeMs"] = data.lastHomeMs[i];
+        motor["avgHomeMs"] = data.avgHomeMs[i];
+
+        JsonObject failures = motor.createNestedObject("homingFailures");
+        failures["timeout"] = MotorTelemetry::getFailureCount(i, HOMING_TIMEOUT);
+        failures["switchError"] = MotorTelemetry::getFailureCount(i, HOMING_SWITCH_ERROR);
+        failures["motorError"] = MotorTelemetry::getFailureCount(i, HOMING_MOTOR_ERROR);
+        failures["cancelled"] = MotorTelemetry::getFailureCount(i, HOMING_CANCELLED);
+    }
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
+void TideClockWebServer::handleGetStopLatency() {
+    DynamicJsonDocument doc(4096);  // Histograms plus 24 per-motor entries
+
+    // Per detection path, full histogram
+    JsonObject sources = doc.createNestedObject("sources");
+    for (uint8_t s = 0; s < STOP_SOURCE_COUNT; s++) {
+        StopSource source = (StopSource)s;
+        addHistogram(sources.createNestedObject(StopLatencyMonitor::getSourceName(source)),
+                     StopLatencyMonitor::getSourceHistogram(source));
+    }
+
+    // Per motor summary; ?motor=N adds that motor's full histogram
+    int detail = server->hasArg("motor") ? server->arg("motor").toInt() : -1;
+    JsonArray motors = doc.createNestedArray("motors");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        const LatencyHistogram& h = StopLatencyMonitor::getMotorHistogram(i);
+        JsonObject motor = motors.createNestedObject();
+        motor["id"] = i;
+        motor["count"] = h.getCount();
+        motor["meanUs"] = h.getMean();
+        motor["maxUs"] = h.getMax();
+        motor["lastUs"] = h.getLast();
+    }
+
+    if (detail >= 0 && detail < NUM_MOTORS) {
+        addHistogram(doc.createNestedObject("detail"), StopLatencyMonitor::getMotorHistogram(detail));
+        doc["detail"]["id"] = detail;
+    }
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
+void TideClockWebServer::handleGetPositions() {
+    DynamicJsonDocument doc(3072);
+    JsonArray motors = doc.createNestedArray("motors");
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        JsonObject motor = motors.createNestedObject();
+        motor["id"] = i;
+        motor["known"] = MotorController::isPositionKnown(i);
+        motor["positionMs"] = MotorController::getPosition(i);
+        motor["moving"] = MotionExecutor::isMoving(i);
+        motor["speedForward"] = MotorSpeedModel::getSpeed(i, MOTOR_FORWARD);
+        motor["speedReverse"] = MotorSpeedModel::getSpeed(i, MOTOR_REVERSE);
+    }
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
+void TideClockWebServer::handleGetDrift() {
+    DynamicJsonDocument doc(3072);
+
+    doc["enabled"] = RehomeScheduler::isEnabled();
+    doc["travelBudgetMs"] = DRIFT_TRAVEL_BUDGET_MS;
+    doc["reversalBudget"] = DRIFT_REVERSAL_BUDGET;
+    doc["moveBudget"] = DRIFT_MOVE_BUDGET;
+
+    JsonArray motors = doc.createNestedArray("motors");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        const DriftBudget& budget = RehomeScheduler::getBudget(i);
+        JsonObject motor = motors.createNestedObject();
+        motor["id"] = i;
+        motor["travelMs"] = budget.travelMs;
+        motor["reversals"] = budget.reversals;
+        motor["moves"] = budget.moves;
+        motor["usage"] = RehomeScheduler::getBudgetUsage(i);  // permille, 1000 = due
     }
 
     String output;
@@ -172,6 +373,21 @@ void TideClockWebServer::handleGetSwitches() {
     sendJSON(200, output.c_str());
 }
 
+void TideClockWebServer::handleResetSpeeds() {
+    Logger::info(CAT_WEB, "API: Reset motor speed model requested");
+
+    // The model and the EEPROM belong to the motion task (homing saves fitted speeds)
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_RESET_SPEEDS;
+    command.source = COMMAND_SOURCE_WEB;
+    uint32_t id = MotionCommandQueue::post(command);
+    if (id == 0) {
+        sendError(503, "Motion command queue full");
+        return;
+    }
+    sendCommandResult(id, "Motor speed model reset queued");
+}
+
 void TideClockWebServer::handleGetLogs() {
     StaticJsonDocument<2048> doc;
     JsonArray logs = doc.createNestedArray("logs");
@@ -190,39 +406,61 @@ void TideClockWebServer::handleGetLogs() {
 }
 
 void TideClockWebServer::handleHome() {
-    // Check if homing is allowed
+    // Early answer for the UI; the motion task makes the real check
     if (!StateManager::canHome()) {
         sendError(400, "Cannot home motors in current state");
         return;
     }
 
-    // Set state to HOMING
-    StateManager::setState(STATE_HOMING);
-    Logger::info(CAT_SYSTEM, "Homing initiated via web interface");
-
-    // Start homing in background (non-blocking for web response)
-    // We'll return immediately and let the operation complete
-    sendSuccess("Homing sequence started");
+    // Optional concurrent mode: {"concurrent": n} homes up to n motors at once
+    uint8_t maxConcurrent = 0;
+    if (server->hasArg("plain")) {
+        StaticJsonDocument<128> doc;
+        DeserializationError error = deserializeJson(doc, server->arg("plain"));
 
-    // Perform homing
-    uint8_t homedCount = MotorController::homeAllMotors();
+        if (!error) {
+            int requested = doc["concurrent"] | 0;
+            if (requested > NUM_MOTORS) requested = NUM_MOTORS;
+            if (requested > 0) maxConcurrent = requested;
+        }
+    }
 
-    // Return to READY state
-    StateManager::setState(STATE_READY);
+    Logger::info(CAT_SYSTEM, "Homing initiated via web interface");
 
-    Logger::logf(LOG_INFO, CAT_SYSTEM,
-                 "Homing complete: %d/%d motors homed", homedCount, NUM_MOTORS);
+    // Runs on the motion task; progress is in /api/status and /api/motion-command
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_HOME_ALL;
+    command.value = maxConcurrent;
+    postCommand(command, "Homing sequence started");
 }
 
 void TideClockWebServer::handleEmergencyStop() {
+    // Outputs are already low when post() returns; the priority lane does the rest
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_ESTOP;
+    command.source = COMMAND_SOURCE_WEB;
+    MotionCommandQueue::post(command);
     Logger::warning(CAT_SYSTEM, "Emergency stop triggered via web interface");
 
-    MotorController::emergencyStopAll();
-    StateManager::enterEmergencyStop();
-
     sendSuccess("Emergency stop activated");
 }
 
+void TideClockWebServer::handleGetEmergencyStop() {
+    StaticJsonDocument<1024> doc;
+
+    doc["active"] = MotorController::isEmergencyStopped();
+    doc["stops"] = EmergencyStop::getStopCount();
+    if (EmergencyStop::getStopCount() > 0) {
+        doc["lastSource"] = EmergencyStop::getSourceName(EmergencyStop::getLastSource());
+        doc["lastLatencyUs"] = EmergencyStop::getLastLatencyUs();
+    }
+    addHistogram(doc.createNestedObject("latency"), EmergencyStop::getLatencyHistogram());
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
 void TideClockWebServer::handleClearStop() {
     if (StateManager::getState() != STATE_EMERGENCY_STOP) {
         sendError(400, "Emergency stop not active");
@@ -231,10 +469,9 @@ void TideClockWebServer::handleClearStop() {
 
     Logger::info(CAT_SYSTEM, "Clearing emergency stop via web interface");
 
-    MotorController::clearEmergencyStop();
-    StateManager::clearEmergencyStop();
-
-    sendSuccess("Emergency stop cleared");
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_CLEAR_STOP;
+    postCommand(command, "Emergency stop clear requested");
 }
 
 void TideClockWebServer::handleTestMotor() {
@@ -267,58 +504,256 @@ void TideClockWebServer::handleTestMotor() {
         return;
     }
 
-    // Check if testing is allowed
-    if (!StateManager::canTest()) {
+    MotionCommand command = {};
+    command.motor = motor;
+
+    // Stop is always allowed so a running test move can be halted
+    if (action == "stop") {
+        Logger::logf(LOG_INFO, CAT_TEST, "Stopping motor %d", motor);
+        command.type = MOTION_COMMAND_STOP;
+        postCommand(command, "Motor stop requested");
+        return;
+    }
+
+    MotorDirection direction;
+    if (action == "forward") {
+        direction = MOTOR_FORWARD;
+    } else if (action == "reverse") {
+        direction = MOTOR_REVERSE;
+    } else {
+        sendError(400, "Invalid action (forward/reverse/stop)");
+        return;
+    }
+
+    int duration = doc["duration"] | 1000;  // Default 1000ms
+    if (duration < 0 || duration > MAX_RUN_TIME_MS) {
+        sendError(400, "Invalid duration (0-9000ms)");
+        return;
+    }
+
+    // Early answer for the UI; the motion task makes the real check
+    SystemState state = StateManager::getState();
+    if (state != STATE_READY && state != STATE_TESTING) {
         sendError(400, "Cannot test motors in current state");
         return;
     }
 
-    // Set state to TESTING
-    StateManager::setState(STATE_TESTING);
+    Logger::logf(LOG_INFO, CAT_TEST, "Testing motor %d %s for %dms",
+                 motor, action.c_str(), duration);
 
-    // Perform action
-    if (action == "forward") {
-        int duration = doc["duration"] | 1000;  // Default 1000ms
-        if (duration < 0 || duration > MAX_RUN_TIME_MS) {
-            StateManager::setState(STATE_READY);
-            sendError(400, "Invalid duration (0-9000ms)");
+    command.type = MOTION_COMMAND_MOVE;
+    command.direction = direction;
+    command.value = duration;
+    postCommand(command, "Motor test started");
+}
+
+void TideClockWebServer::handleSubmitMotionJob() {
+    if (!server->hasArg("plain")) {
+        sendError(400, "Missing request body");
+        return;
+    }
+
+    // Up to MOTION_JOB_MAX_MOVES entries - too large for a stack document
+    DynamicJsonDocument doc(6144);
+    DeserializationError error = deserializeJson(doc, server->arg("plain"));
+
+    if (error) {
+        sendError(400, "Invalid JSON");
+        return;
+    }
+
+    JsonArray list = doc["moves"];
+    if (list.isNull() || list.size() == 0 || list.size() > MOTION_JOB_MAX_MOVES) {
+        sendError(400, "moves must be a list of 1-48 moves");
+        return;
+    }
+
+    JobMove moves[MOTION_JOB_MAX_MOVES];
+    uint8_t count = 0;
+    for (JsonObject entry : list) {
+        int motor = entry["motor"] | -1;
+        String action = entry["action"] | "";
+        int duration = entry["duration"] | 1000;  // Default 1000ms
+        long offset = entry["offset"] | 0L;
+
+        if (motor < 0 || motor >= NUM_MOTORS) {
+            sendError(400, "Invalid motor index");
             return;
         }
 
-        Logger::logf(LOG_INFO, CAT_TEST,
-                     "Testing motor %d forward for %dms", motor, duration);
-        MotorController::runMotorForward(motor, duration);
-
-        sendSuccess("Motor test complete");
+        MotorDirection direction;
+        if (action == "forward") {
+            direction = MOTOR_FORWARD;
+        } else if (action == "reverse") {
+            direction = MOTOR_REVERSE;
+        } else {
+            sendError(400, "Invalid action (forward/reverse)");
+            return;
+        }
 
-    } else if (action == "reverse") {
-        int duration = doc["duration"] | 1000;
         if (duration < 0 || duration > MAX_RUN_TIME_MS) {
-            StateManager::setState(STATE_READY);
             sendError(400, "Invalid duration (0-9000ms)");
             return;
         }
 
-        Logger::logf(LOG_INFO, CAT_TEST,
-                     "Testing motor %d reverse for %dms", motor, duration);
-        MotorController::runMotorReverse(motor, duration);
+        if (offset < 0 || offset > MOTION_JOB_MAX_OFFSET_MS) {
+            sendError(400, "Invalid offset (0-60000ms)");
+            return;
+        }
+
+        moves[count].motor = motor;
+        moves[count].direction = direction;
+        moves[count].durationMs = duration;
+        moves[count].offsetMs = offset;
+        count++;
+    }
 
-        sendSuccess("Motor test complete");
+    // Only the motion task queues jobs; it also checks the system state
+    uint16_t jobId = 0;
+    int8_t slot = MotionJobQueue::stage(moves, count, jobId);
+    if (slot < 0) {
+        sendError(503, "Motion job staging full");
+        return;
+    }
 
-    } else if (action == "stop") {
-        Logger::logf(LOG_INFO, CAT_TEST, "Stopping motor %d", motor);
-        MotorController::stopMotor(motor);
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_SUBMIT_JOB;
+    command.source = COMMAND_SOURCE_WEB;
+    command.value = slot;
+    uint32_t commandId = MotionCommandQueue::post(command);
+    if (commandId == 0) {
+        MotionJobQueue::discardStaged(slot);
+        sendError(503, "Motion command queue full");
+        return;
+    }
 
-        sendSuccess("Motor stopped");
+    StaticJsonDocument<128> response;
+    response["success"] = true;
+    response["jobId"] = jobId;
+    response["commandId"] = commandId;
 
-    } else {
-        StateManager::setState(STATE_READY);
-        sendError(400, "Invalid action (forward/reverse/stop)");
+    String output;
+    serializeJson(response, output);
+    sendJSON(202, output.c_str());
+}
+
+void TideClockWebServer::handleGetMotionJob() {
+    DynamicJsonDocument doc(4096);  // Up to MOTION_JOB_MAX_MOVES moves
+
+    // Without an ID, summarize every slot
+    if (!server->hasArg("id")) {
+        JsonArray list = doc.createNestedArray("jobs");
+        for (uint8_t s = 0; s < MOTION_JOB_SLOTS; s++) {
+            const MotionJob& job = MotionJobQueue::getSlot(s);
+            if (job.state == JOB_EMPTY) {
+                continue;
+            }
+            JsonObject entry = list.createNestedObject();
+            entry["id"] = job.id;
+            entry["state"] = MotionJobQueue::getStateName(job.state);
+            entry["moves"] = job.moveCount;
+            entry["finished"] = job.finishedCount;
+        }
+
+        String output;
+        serializeJson(doc, output);
+        sendJSON(200, output.c_str());
         return;
     }
 
-    // Return to READY state
-    StateManager::setState(STATE_READY);
+    const MotionJob* job = MotionJobQueue::getJob(server->arg("id").toInt());
+    if (job == nullptr) {
+        sendError(404, "Unknown motion job");
+        return;
+    }
+
+    doc["id"] = job->id;
+    doc["state"] = MotionJobQueue::getStateName(job->state);
+    doc["moves"] = job->moveCount;
+    doc["finished"] = job->finishedCount;
+    if (job->state == JOB_RUNNING) {
+        doc["elapsedMs"] = Clock::nowMillis() - job->startedAt;
+    } else if (job->state == JOB_COMPLETE || job->state == JOB_CANCELLED) {
+        doc["elapsedMs"] = job->startedAt ? job->finishedAt - job->startedAt : 0;
+    }
+
+    JsonArray moves = doc.createNestedArray("progress");
+    for (uint8_t i = 0; i < job->moveCount; i++) {
+        JsonObject move = moves.createNestedObject();
+        move["motor"] = job->moves[i].motor;
+        move["state"] = MotionJobQueue::getMoveStateName(job->moves[i].state);
+    }
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
+}
+
+void TideClockWebServer::handleCancelMotionJob() {
+    if (!server->hasArg("plain")) {
+        sendError(400, "Missing request body");
+        return;
+    }
+
+    StaticJsonDocument<128> doc;
+    DeserializationError error = deserializeJson(doc, server->arg("plain"));
+
+    if (error) {
+        sendError(400, "Invalid JSON");
+        return;
+    }
+
+    if (!doc.containsKey("id")) {
+        sendError(400, "Missing required field: id");
+        return;
+    }
+
+    uint16_t jobId = doc["id"];
+    const MotionJob* job = MotionJobQueue::getJob(jobId);
+    if (job == nullptr || (job->state != JOB_QUEUED && job->state != JOB_RUNNING)) {
+        sendError(404, "No queued or running job with that ID");
+        return;
+    }
+
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_CANCEL_JOB;
+    command.value = jobId;
+    postCommand(command, "Motion job cancel requested");
+}
+
+void TideClockWebServer::handleGetMotionCommand() {
+    StaticJsonDocument<512> doc;
+
+    // Without an ID, report queue statistics
+    if (!server->hasArg("id")) {
+        MotionCommandStats stats = MotionCommandQueue::getStats();
+        doc["posted"] = stats.posted;
+        doc["executed"] = stats.executed;
+        doc["rejected"] = stats.rejected;
+        doc["queueFull"] = stats.queueFull;
+        doc["dropped"] = stats.dropped;
+        doc["maxDepth"] = stats.maxDepth;
+
+        String output;
+        serializeJson(doc, output);
+        sendJSON(200, output.c_str());
+        return;
+    }
+
+    MotionCommandStatus status;
+    if (!MotionCommandQueue::getStatus(server->arg("id").toInt(), status)) {
+        sendError(404, "Unknown motion command");
+        return;
+    }
+
+    doc["id"] = status.id;
+    doc["type"] = MotionCommandQueue::getTypeName(status.type);
+    doc["state"] = MotionCommandQueue::getStateName(status.state);
+    doc["message"] = status.message;
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(200, output.c_str());
 }
 
 void TideClockWebServer::handleSaveConfig() {
@@ -336,62 +771,45 @@ void TideClockWebServer::handleSaveConfig() {
         return;
     }
 
-    // Check if config changes are allowed
+    // Early answer for the UI; the motion task makes the real check
     if (!StateManager::canChangeConfig()) {
         sendError(400, "Cannot change config in current state");
         return;
     }
 
-    bool configChanged = false;
+    // Collected here, validated and applied by the motion task
+    ConfigUpdate update = {};
 
-    // Update WiFi credentials if provided
     if (doc.containsKey("wifiSSID") && doc.containsKey("wifiPassword")) {
-        const char* ssid = doc["wifiSSID"];
-        const char* password = doc["wifiPassword"];
-
-        ConfigManager::setWiFiCredentials(ssid, password);
-        configChanged = true;
-
-        Logger::info(CAT_SYSTEM, "WiFi credentials updated");
+        strncpy(update.wifiSSID, doc["wifiSSID"] | "", sizeof(update.wifiSSID) - 1);
+        strncpy(update.wifiPassword, doc["wifiPassword"] | "", sizeof(update.wifiPassword) - 1);
+        update.fields |= CONFIG_UPDATE_WIFI;
     }
 
-    // Update motor timing if provided
     if (doc.containsKey("switchRelease") && doc.containsKey("maxRunTime")) {
-        uint16_t switchRelease = doc["switchRelease"];
-        uint16_t maxRunTime = doc["maxRunTime"];
-
-        ConfigManager::setMotorTiming(switchRelease, maxRunTime);
-        configChanged = true;
-
-        Logger::info(CAT_SYSTEM, "Motor timing updated");
+        update.switchReleaseTime = doc["switchRelease"];
+        update.maxRunTime = doc["maxRunTime"];
+        update.fields |= CONFIG_UPDATE_MOTOR_TIMING;
     }
 
-    // Phase 3: Update NOAA configuration if provided
+    // Phase 3: NOAA configuration
     if (doc.containsKey("stationID")) {
-        const char* stationID = doc["stationID"];
-        ConfigManager::setNOAAStation(stationID);
-        configChanged = true;
-        Logger::logf(LOG_INFO, CAT_SYSTEM, "NOAA station ID updated: %s", stationID);
+        strncpy(update.stationID, doc["stationID"] | "", sizeof(update.stationID) - 1);
+        update.fields |= CONFIG_UPDATE_STATION;
     }
 
     if (doc.containsKey("minTide") && doc.containsKey("maxTide")) {
-        float minTide = doc["minTide"];
-        float maxTide = doc["maxTide"];
-        ConfigManager::setTideRange(minTide, maxTide);
-        configChanged = true;
-        Logger::logf(LOG_INFO, CAT_SYSTEM, "Tide range updated: %.1f - %.1f ft", minTide, maxTide);
+        update.minTideHeight = doc["minTide"];
+        update.maxTideHeight = doc["maxTide"];
+        update.fields |= CONFIG_UPDATE_TIDE_RANGE;
     }
 
-    // Save to EEPROM
-    if (configChanged) {
-        if (ConfigManager::save()) {
-            sendSuccess("Configuration saved - Restart to apply WiFi changes");
-        } else {
-            sendError(500, "Failed to save configuration");
-        }
-    } else {
+    if (update.fields == 0) {
         sendError(400, "No configuration changes provided");
+        return;
     }
+
+    postConfigUpdate(update, true, "Configuration save queued - Restart to apply WiFi changes");
 }
 
 // ============================================================================
@@ -408,34 +826,32 @@ void TideClockWebServer::handleFetchTide() {
     }
 
     // Get station ID from config
-    const TideClockConfig& config = ConfigManager::getConfig();
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
     if (strlen(config.stationID) == 0) {
         sendError(400, "NOAA station ID not configured");
         return;
     }
 
-    // Set state to FETCHING_DATA
-    StateManager::setState(STATE_FETCHING_DATA);
-
-    // Fetch data from NOAA
-    TideDataset* dataset = TideDataManager::getMutableDataset();
+    // Fetch into a private buffer; the motor states belong to the motion task
+    TideDataset* dataset = &tideBuffer;
     NOAAClient::FetchResult result = NOAAClient::fetchTidePredictions(
         config.stationID,
         dataset,
         10000  // 10 second timeout
     );
 
-    // Return to READY state
-    StateManager::setState(STATE_READY);
-
     // Handle result
     if (result == NOAAClient::SUCCESS) {
+        // Applied by the motion task, after any tide sequence in progress
         TideDataManager::setData(dataset);
+        bool deferred = StateManager::getState() == STATE_RUNNING_TIDE;
 
         // Build success response
         StaticJsonDocument<512> doc;
         doc["success"] = true;
-        doc["message"] = "Fetched " + String(dataset->recordCount) + " hours of tide data";
+        doc["message"] = "Fetched " + String(dataset->recordCount) + " hours of tide data" +
+                         (deferred ? " - applied when the tide sequence finishes" : "");
         doc["stationID"] = dataset->stationID;
         doc["stationName"] = dataset->stationName;
         doc["recordCount"] = dataset->recordCount;
@@ -444,7 +860,7 @@ void TideClockWebServer::handleFetchTide() {
         // Tide range
         float minTide = 999.0;
         float maxTide = -999.0;
-        for (uint8_t i = 0; i < 24; i++) {
+        for (uint8_t i = 0; i < TIDE_DATASET_HOURS; i++) {
             float tide = dataset->hours[i].rawTideHeight;
             if (tide < minTide) minTide = tide;
             if (tide > maxTide) maxTide = tide;
@@ -464,11 +880,13 @@ void TideClockWebServer::handleFetchTide() {
 }
 
 void TideClockWebServer::handleGetTideData() {
-    const TideDataset* dataset = TideDataManager::getCurrentDataset();
+    // Consistent copy - the motion task may be replacing the current data
+    TideDataManager::copyDataset(tideBuffer);
+    const TideDataset* dataset = &tideBuffer;
 
-    StaticJsonDocument<4096> doc;  // Larger buffer for 24 hours of data
+    DynamicJsonDocument doc(8192);  // Heap buffer for 48 hours of data
 
-    if (!TideDataManager::isDataValid()) {
+    if (!dataset->isValid || dataset->recordCount != TIDE_DATASET_HOURS) {
         doc["available"] = false;
         doc["message"] = "No valid tide data - fetch data first";
 
@@ -487,14 +905,23 @@ void TideClockWebServer::handleGetTideData() {
     doc["isStale"] = TideDataManager::isDataStale();
     doc["recordCount"] = dataset->recordCount;
 
-    // Current hour
+    // Current hour and the hours shown by the motors
+    uint8_t windowStart = RollingWindow::getWindowStart(dataset);
     if (TimeManager::isTimeSynced()) {
         doc["currentHour"] = TimeManager::getCurrentHour();
+        uint8_t currentIndex = TideDataManager::getCurrentHourIndex(dataset);
+        if (currentIndex != TIDE_WINDOW_INVALID) {
+            doc["currentIndex"] = currentIndex;
+        }
+    }
+    doc["rollingWindow"] = RollingWindow::isEnabled();
+    if (windowStart != TIDE_WINDOW_INVALID) {
+        doc["windowStart"] = windowStart;
     }
 
-    // Hourly data array
+    // Hourly data array (index 24+ = tomorrow)
     JsonArray hours = doc.createNestedArray("hours");
-    for (uint8_t i = 0; i < 24; i++) {
+    for (uint8_t i = 0; i < TIDE_DATASET_HOURS; i++) {
         const HourlyTideData* hourData = &dataset->hours[i];
 
         JsonObject hour = hours.createNestedObject();
@@ -502,8 +929,14 @@ void TideClockWebServer::handleGetTideData() {
         hour["timestamp"] = hourData->timestamp;
         hour["tideHeight"] = hourData->rawTideHeight;
         hour["scaledTime"] = hourData->scaledRunTime;
-        hour["finalTime"] = hourData->finalRunTime;
-        hour["offset"] = ConfigManager::getMotorOffset(i);
+
+        // Motor showing this hour, and its target position
+        if (windowStart != TIDE_WINDOW_INVALID && i >= windowStart && i < windowStart + NUM_MOTORS) {
+            hour["motor"] = i - windowStart;
+            hour["finalTime"] = TideDataManager::getMotorRunTime(dataset, i);
+        } else {
+            hour["finalTime"] = hourData->finalRunTime;
+        }
     }
 
     String output;
@@ -514,86 +947,72 @@ void TideClockWebServer::handleGetTideData() {
 void TideClockWebServer::handleRunTide() {
     Logger::info(CAT_WEB, "API: Run tide sequence requested");
 
-    // Parse request body for dry run option
+    // Parse request body for dry run and concurrency options
     bool dryRun = false;
+    uint8_t maxConcurrent = 0;
     if (server->hasArg("plain")) {
         StaticJsonDocument<256> doc;
         DeserializationError error = deserializeJson(doc, server->arg("plain"));
 
         if (!error) {
             dryRun = doc["dryRun"] | false;
+
+            int requested = doc["concurrent"] | 0;
+            if (requested > NUM_MOTORS) requested = NUM_MOTORS;
+            if (requested > 0) maxConcurrent = requested;
         }
     }
 
-    // Get tide data
-    TideDataset* dataset = TideDataManager::getMutableDataset();
+    // Early answers for the UI; the motion task makes the real checks
     if (!TideDataManager::isDataValid()) {
         sendError(400, "No valid tide data - fetch data first");
         return;
     }
 
-    // Check system state
     if (StateManager::getState() != STATE_READY) {
         String errorMsg = String("System not ready - current state: ") + StateManager::getStateName();
         sendError(400, errorMsg.c_str());
         return;
     }
 
-    // Set state
-    if (!dryRun) {
-        StateManager::setState(STATE_RUNNING_TIDE);
-    }
-
-    // Run tide sequence
-    bool success = MotorController::runTideSequence(dataset, dryRun);
+    // Runs on the motion task; progress and the plan are in /api/status
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_RUN_TIDE;
+    command.value = maxConcurrent;
+    command.flag = dryRun;
+    postCommand(command, dryRun ? "Dry run started - check logs for details"
+                                : "Tide sequence started");
+}
 
-    // Return to READY state
-    if (!dryRun) {
-        StateManager::setState(STATE_READY);
+void TideClockWebServer::handleGetContinuous() {
+    DynamicJsonDocument doc(3072);
+
+    doc["enabled"] = ContinuousTracker::isEnabled();
+    doc["updateIntervalMs"] = CONTINUOUS_UPDATE_INTERVAL_MS;
+    doc["maxStepMs"] = CONTINUOUS_MAX_STEP_MS;
+    doc["predictions"] = ContinuousTracker::getSampleCount();
+
+    const ContinuousUpdate& update = ContinuousTracker::getLastUpdate();
+    if (update.at != 0) {
+        JsonObject last = doc.createNestedObject("lastUpdate");
+        last["ageMs"] = Clock::nowMillis() - update.at;
+        last["liveMotor"] = update.liveMotor;
+        last["moves"] = update.moveCount;
+        last["limited"] = update.limitedCount;
+        last["skipped"] = update.skippedCount;
+        last["jobId"] = update.jobId;
     }
 
-    // Send response
-    if (success) {
-        if (dryRun) {
-            sendSuccess("Dry run completed - check logs for details");
+    JsonArray motors = doc.createNestedArray("motors");
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        JsonObject motor = motors.createNestedObject();
+        motor["id"] = i;
+        motor["target"] = ContinuousTracker::getTarget(i);  // -1 = no target yet
+        if (MotorController::isPositionKnown(i)) {
+            motor["position"] = MotorController::getPosition(i);
         } else {
-            sendSuccess("Tide sequence completed - 24 motors positioned");
+            motor["position"] = nullptr;
         }
-    } else {
-        sendError(500, "Tide sequence failed - check logs for details");
-    }
-}
-
-void TideClockWebServer::handleSyncTime() {
-    Logger::info(CAT_WEB, "API: NTP sync requested");
-
-    bool success = TimeManager::syncWithNTP(10000);
-
-    if (success) {
-        StaticJsonDocument<256> doc;
-        doc["success"] = true;
-        doc["message"] = "Time synchronized successfully";
-        doc["currentTime"] = TimeManager::getFormattedDateTime();
-        doc["epochTime"] = TimeManager::getEpochTime();
-
-        String output;
-        serializeJson(doc, output);
-        sendJSON(200, output.c_str());
-    } else {
-        sendError(500, "NTP sync failed - check WiFi connection");
-    }
-}
-
-void TideClockWebServer::handleGetMotorOffsets() {
-    Logger::info(CAT_WEB, "API: Get motor offsets requested");
-
-    StaticJsonDocument<1024> doc;
-    doc["success"] = true;
-
-    // Create array of all 24 motor offsets
-    JsonArray offsets = doc.createNestedArray("offsets");
-    for (uint8_t i = 0; i < 24; i++) {
-        offsets.add(ConfigManager::getMotorOffset(i));
     }
 
     String output;
@@ -601,78 +1020,68 @@ void TideClockWebServer::handleGetMotorOffsets() {
     sendJSON(200, output.c_str());
 }
 
-void TideClockWebServer::handleSaveMotorOffsets() {
-    Logger::info(CAT_WEB, "API: Save motor offsets requested");
-
-    // Parse request body
+void TideClockWebServer::handleSetContinuous() {
     if (!server->hasArg("plain")) {
         sendError(400, "Missing request body");
         return;
     }
 
-    StaticJsonDocument<1024> doc;
+    StaticJsonDocument<128> doc;
     DeserializationError error = deserializeJson(doc, server->arg("plain"));
-
-    if (error) {
-        sendError(400, "Invalid JSON");
+    if (error || !doc["enabled"].is<bool>()) {
+        sendError(400, "Expected {\"enabled\": true|false}");
         return;
     }
 
-    // Validate that offsets array exists
-    if (!doc.containsKey("offsets")) {
-        sendError(400, "Missing 'offsets' array");
+    bool enable = doc["enabled"];
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
+    if (enable && strlen(config.stationID) == 0) {
+        sendError(400, "NOAA station ID not configured");
         return;
     }
 
-    JsonArray offsets = doc["offsets"];
-    if (offsets.size() != 24) {
-        sendError(400, "Expected 24 motor offsets");
+    // Fetching and motion happen on the network and motion tasks
+    ContinuousTracker::setEnabled(enable);
+    sendSuccess(enable ? "Continuous tracking enabled" : "Continuous tracking disabled");
+}
+
+void TideClockWebServer::handleSetRollingWindow() {
+    if (!server->hasArg("plain")) {
+        sendError(400, "Missing request body");
         return;
     }
 
-    // Validate and save each offset
-    uint8_t successCount = 0;
-    for (uint8_t i = 0; i < 24; i++) {
-        float offset = offsets[i];
-
-        // Validate range (0.8 to 1.2)
-        if (offset < 0.8 || offset > 1.2) {
-            Logger::logf(LOG_WARNING, CAT_WEB,
-                        "Motor %u offset %.3f out of range (0.8-1.2)", i, offset);
-            continue;
-        }
-
-        // Save to config
-        ConfigManager::setMotorOffset(i, offset);
-        successCount++;
+    StaticJsonDocument<128> doc;
+    DeserializationError error = deserializeJson(doc, server->arg("plain"));
+    if (error || !doc["enabled"].is<bool>()) {
+        sendError(400, "Expected {\"enabled\": true|false}");
+        return;
     }
 
-    if (successCount == 24) {
-        // Save to EEPROM
-        if (ConfigManager::save()) {
-            Logger::info(CAT_WEB, "All motor offsets saved to EEPROM");
-            sendSuccess("Motor offsets saved successfully");
-        } else {
-            sendError(500, "Failed to save configuration to EEPROM");
-        }
-    } else {
-        String errorMsg = String("Only ") + successCount + "/24 offsets were valid";
-        sendError(400, errorMsg.c_str());
-    }
+    // The motion task shifts the display at its next check
+    bool enable = doc["enabled"];
+    RollingWindow::setEnabled(enable);
+    sendSuccess(enable ? "Rolling 24-hour window enabled" : "Calendar day window enabled");
 }
 
-void TideClockWebServer::handleResetMotorOffsets() {
-    Logger::info(CAT_WEB, "API: Reset motor offsets requested");
+void TideClockWebServer::handleSyncTime() {
+    Logger::info(CAT_WEB, "API: NTP sync requested");
+
+    bool success = TimeManager::syncWithNTP(10000);
 
-    // Reset all offsets to 1.0
-    ConfigManager::resetMotorOffsets();
+    if (success) {
+        StaticJsonDocument<256> doc;
+        doc["success"] = true;
+        doc["message"] = "Time synchronized successfully";
+        doc["currentTime"] = TimeManager::getFormattedDateTime();
+        doc["epochTime"] = TimeManager::getEpochTime();
 
-    // Save to EEPROM
-    if (ConfigManager::save()) {
-        Logger::info(CAT_WEB, "Motor offsets reset to 1.0 and saved");
-        sendSuccess("All motor offsets reset to 1.0");
+        String output;
+        serializeJson(doc, output);
+        sendJSON(200, output.c_str());
     } else {
-        sendError(500, "Failed to save configuration to EEPROM");
+        sendError(500, "NTP sync failed - check WiFi connection");
     }
 }
 
@@ -683,7 +1092,8 @@ void TideClockWebServer::handleResetMotorOffsets() {
 void TideClockWebServer::handleGetLEDConfig() {
     Logger::info(CAT_WEB, "API: Get LED configuration");
 
-    const TideClockConfig& config = ConfigManager::getConfig();
+    TideClockConfig config;
+    ConfigManager::copyConfig(config);
 
     StaticJsonDocument<512> doc;
     doc["enabled"] = config.ledEnabled;
@@ -733,93 +1143,82 @@ void TideClockWebServer::handleSaveLEDConfig() {
         return;
     }
 
-    // Update LED configuration with validation
-    bool configChanged = false;
+    // Validated and applied by the motion task, which also drives the strip
+    // and re-creates it when the pin or count changes
+    ConfigUpdate update = {};
 
     if (doc.containsKey("enabled")) {
-        ConfigManager::setLEDEnabled(doc["enabled"]);
-        LEDController::setEnabled(doc["enabled"]);
-        configChanged = true;
+        update.ledEnabled = doc["enabled"];
+        update.fields |= CONFIG_UPDATE_LED_ENABLED;
     }
 
     if (doc.containsKey("pin")) {
-        uint8_t pin = doc["pin"];
-        ConfigManager::setLEDPin(pin);
-        configChanged = true;
-        // Note: Pin change requires reinit, handled after all changes
+        update.ledPin = doc["pin"];
+        update.fields |= CONFIG_UPDATE_LED_PIN;
     }
 
     if (doc.containsKey("count")) {
-        uint16_t count = doc["count"];
-        ConfigManager::setLEDCount(count);
-        configChanged = true;
-        // Note: Count change requires reinit, handled after all changes
+        update.ledCount = doc["count"];
+        update.fields |= CONFIG_UPDATE_LED_COUNT;
     }
 
     if (doc.containsKey("mode")) {
-        uint8_t mode = doc["mode"];
-        ConfigManager::setLEDMode(mode);
-        LEDController::setMode(mode);
-        configChanged = true;
+        update.ledMode = doc["mode"];
+        update.fields |= CONFIG_UPDATE_LED_MODE;
     }
 
     if (doc.containsKey("brightness")) {
-        uint8_t brightness = doc["brightness"];
-        ConfigManager::setLEDBrightness(brightness);
-        LEDController::setBrightness(brightness);
-        configChanged = true;
+        update.ledBrightness = doc["brightness"];
+        update.fields |= CONFIG_UPDATE_LED_BRIGHTNESS;
     }
 
     if (doc.containsKey("colorIndex")) {
-        uint8_t colorIndex = doc["colorIndex"];
-        ConfigManager::setLEDColorIndex(colorIndex);
-        LEDController::setColorIndex(colorIndex);
-        configChanged = true;
+        update.ledColorIndex = doc["colorIndex"];
+        update.fields |= CONFIG_UPDATE_LED_COLOR;
     }
 
     if (doc.containsKey("startHour") && doc.containsKey("endHour")) {
-        uint8_t startHour = doc["startHour"];
-        uint8_t endHour = doc["endHour"];
-        ConfigManager::setLEDActiveHours(startHour, endHour);
-        LEDController::setActiveHours(startHour, endHour);
-        configChanged = true;
-    }
-
-    // If pin or count changed, reinitialize LED controller
-    if (doc.containsKey("pin") || doc.containsKey("count")) {
-        const TideClockConfig& config = ConfigManager::getConfig();
-        if (!LEDController::reinit(config.ledPin, config.ledCount)) {
-            sendError(500, "Failed to reinitialize LED controller");
-            return;
-        }
+        update.ledStartHour = doc["startHour"];
+        update.ledEndHour = doc["endHour"];
+        update.fields |= CONFIG_UPDATE_LED_HOURS;
     }
 
-    // Save configuration to EEPROM
-    if (configChanged) {
-        if (ConfigManager::save()) {
-            Logger::info(CAT_WEB, "LED configuration saved");
-            sendSuccess("LED configuration saved successfully");
-        } else {
-            sendError(500, "Failed to save configuration to EEPROM");
-        }
-    } else {
+    if (update.fields == 0) {
         sendSuccess("No changes to save");
+        return;
     }
+
+    postConfigUpdate(update, false, "LED configuration save queued");
 }
 
 void TideClockWebServer::handleLEDTest() {
     Logger::info(CAT_WEB, "API: LED test pattern requested");
 
-    // Trigger test pattern mode
-    LEDController::runTestPattern();
-
-    sendSuccess("Test pattern activated");
+    // Trigger test pattern mode (the strip is driven from the motion task)
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_LED_TEST;
+    postCommand(command, "Test pattern activated");
 }
 
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
 
+void TideClockWebServer::addHistogram(JsonObject obj, const LatencyHistogram& histogram) {
+    obj["count"] = histogram.getCount();
+    obj["minUs"] = histogram.getMin();
+    obj["meanUs"] = histogram.getMean();
+    obj["maxUs"] = histogram.getMax();
+
+    // Bucket i counts samples below upperUs (0 = overflow bucket)
+    JsonArray bins = obj.createNestedArray("bins");
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BINS; i++) {
+        JsonObject bin = bins.createNestedObject();
+        bin["upperUs"] = LatencyHistogram::getBinUpperUs(i);
+        bin["count"] = histogram.getBin(i);
+    }
+}
+
 void TideClockWebServer::sendJSON(int code, const char* json) {
     server->send(code, "application/json", json);
 }
@@ -834,6 +1233,82 @@ void TideClockWebServer::sendError(int code, const char* message) {
     sendJSON(code, output.c_str());
 }
 
+void TideClockWebServer::postCommand(MotionCommand command, const char* message) {
+    command.source = COMMAND_SOURCE_WEB;
+    uint32_t id = MotionCommandQueue::post(command);
+    if (id == 0) {
+        sendError(503, "Motion command queue full");
+        return;
+    }
+
+    StaticJsonDocument<192> doc;
+    doc["success"] = true;
+    doc["message"] = message;
+    doc["commandId"] = id;
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(202, output.c_str());
+}
+
+void TideClockWebServer::sendCommandResult(uint32_t id, const char* queuedMessage) {
+    // Short commands finish within a motion task pass unless an operation holds it
+    MotionCommandStatus status = {};
+    uint32_t waited = 0;
+    while (MotionCommandQueue::getStatus(id, status) && status.state == COMMAND_QUEUED &&
+           waited < CONFIG_APPLY_WAIT_MS) {
+        Clock::delayMs(MOTION_TASK_PERIOD_MS);
+        waited += MOTION_TASK_PERIOD_MS;
+    }
+
+    int code;
+    switch (status.state) {
+        case COMMAND_DONE:     code = 200; break;
+        case COMMAND_FAILED:   code = 500; break;
+        case COMMAND_REJECTED:
+        case COMMAND_DROPPED:  code = 400; break;
+        default:               code = 202; break;   // Still queued; poll /api/motion-command
+    }
+
+    StaticJsonDocument<192> doc;
+    doc["success"] = (code == 200 || code == 202);
+    if (code == 202) {
+        doc["message"] = queuedMessage;
+    } else if (code == 200) {
+        doc["message"] = status.message;
+    } else {
+        doc["error"] = status.message;
+    }
+    doc["commandId"] = id;
+
+    String output;
+    serializeJson(doc, output);
+    sendJSON(code, output.c_str());
+}
+
+void TideClockWebServer::postConfigUpdate(const ConfigUpdate& update, bool checkState,
+                                          const char* queuedMessage) {
+    int8_t slot = ConfigManager::stageUpdate(update);
+    if (slot < 0) {
+        sendError(503, "Configuration update already pending");
+        return;
+    }
+
+    MotionCommand command = {};
+    command.type = MOTION_COMMAND_APPLY_CONFIG;
+    command.source = COMMAND_SOURCE_WEB;
+    command.value = slot;
+    command.flag = checkState;
+    uint32_t id = MotionCommandQueue::post(command);
+    if (id == 0) {
+        ConfigManager::discardUpdate(slot);
+        sendError(503, "Motion command queue full");
+        return;
+    }
+
+    sendCommandResult(id, queuedMessage);
+}
+
 void TideClockWebServer::sendSuccess(const char* message) {
     StaticJsonDocument<128> doc;
     doc["success"] = true;
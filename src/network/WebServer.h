@@ -10,6 +10,10 @@
 
 #include <Arduino.h>
 #include <WebServer.h>
+#include <ArduinoJson.h>
+#include "../utils/LatencyHistogram.h"
+#include "../core/MotionCommandQueue.h"
+#include "../data/TideData.h"
 
 class TideClockWebServer {
 public:
@@ -19,7 +23,7 @@ public:
     static void begin();
 
     /**
-     * Handle client requests (call from loop)
+     * Handle client requests (call from the network task)
      */
     static void handle();
 
@@ -36,6 +40,7 @@ public:
 private:
     static WebServer* server;
     static bool running;
+    static TideDataset tideBuffer;      // Tide data copy for the handlers (network task)
 
     // Route handlers
     static void handleRoot();
@@ -47,20 +52,29 @@ private:
     static void handleGetLogs();
     static void handleHome();
     static void handleEmergencyStop();
+    static void handleGetEmergencyStop();
     static void handleClearStop();
     static void handleTestMotor();
+    static void handleSubmitMotionJob();
+    static void handleGetMotionJob();
+    static void handleCancelMotionJob();
+    static void handleGetMotionCommand();
     static void handleSaveConfig();
+    static void handleGetMotionTiming();
+    static void handleGetPositions();
+    static void handleResetSpeeds();
+    static void handleGetDrift();
+    static void handleGetMotorStats();
+    static void handleGetStopLatency();
 
     // Phase 3: NOAA Integration endpoints
     static void handleFetchTide();
     static void handleGetTideData();
     static void handleRunTide();
     static void handleSyncTime();
-
-    // Motor offset calibration endpoints
-    static void handleGetMotorOffsets();
-    static void handleSaveMotorOffsets();
-    static void handleResetMotorOffsets();
+    static void handleGetContinuous();
+    static void handleSetContinuous();
+    static void handleSetRollingWindow();
 
     // Phase 4: LED Control endpoints
     static void handleGetLEDConfig();
@@ -71,6 +85,11 @@ private:
     static void sendJSON(int code, const char* json);
     static void sendError(int code, const char* message);
     static void sendSuccess(const char* message);
+    static void postCommand(MotionCommand command, const char* message);
+    static void sendCommandResult(uint32_t id, const char* queuedMessage);
+    static void postConfigUpdate(const ConfigUpdate& update, bool checkState,
+                                 const char* queuedMessage);
+    static void addHistogram(JsonObject obj, const LatencyHistogram& histogram);
 };
 
 #endif // WEB_SERVER_H
@@ -6,6 +6,7 @@
 #include "../config.h"
 #include "../core/ConfigManager.h"
 #include "../utils/Logger.h"
+#include "../utils/Clock.h"
 #include <WiFi.h>
 
 // Static member initialization
@@ -54,7 +55,7 @@ bool WiFiManager::connect() {
             return true;
         }
 
-        delay(1000);  // Brief delay between attempts
+        Clock::delayMs(1000);  // Brief delay between attempts
     }
 
     // All attempts failed - switch to AP mode
@@ -68,14 +69,14 @@ bool WiFiManager::connect() {
 bool WiFiManager::tryStationMode(const char* ssid, const char* password) {
     WiFi.begin(ssid, password);
 
-    unsigned long startTime = millis();
+    uint64_t startTime = Clock::nowMillis();
     while (WiFi.status() != WL_CONNECTED) {
-        if (millis() - startTime > WIFI_CONNECT_TIMEOUT) {
+        if (Clock::nowMillis() - startTime > WIFI_CONNECT_TIMEOUT) {
             Logger::warning(CAT_SYSTEM, "Connection timeout");
             WiFi.disconnect();
             return false;
         }
-        delay(100);
+        Clock::delayMs(100);
     }
 
     return true;
@@ -60,7 +60,7 @@ public:
     static const char* getModeName();
 
     /**
-     * Handle WiFi events (call from loop)
+     * Handle WiFi events (call from the network task)
      */
     static void handle();
 
@@ -0,0 +1,233 @@
+/**
+ * Plant Simulator Implementation
+ */
+
+#ifdef TIDECLOCK_SIM
+
+#include "PlantSimulator.h"
+#include "../hardware/MotorController.h"
+#include "../hardware/PinTopology.h"
+#include "../utils/Clock.h"
+#include "../utils/Logger.h"
+
+// MCP23017 registers the plant models (IOCON.BANK = 0)
+#define SIM_REG_INTFA 0x0E
+#define SIM_REG_INTCAPB 0x11
+#define SIM_REG_GPIOA 0x12
+#define SIM_REG_GPIOB 0x13
+#define SIM_REG_OLATA 0x14
+#define SIM_REG_OLATB 0x15
+
+// Static member initialization
+SimMotor PlantSimulator::motors[NUM_MOTORS];
+uint16_t PlantSimulator::outputLatch[NUM_MOTOR_BOARDS] = {0};
+uint64_t PlantSimulator::lastUpdateUs = 0;
+bool PlantSimulator::fastForward = false;
+uint32_t PlantSimulator::rngState = SIM_SEED;
+portMUX_TYPE PlantSimulator::mux = portMUX_INITIALIZER_UNLOCKED;
+
+void PlantSimulator::begin(uint32_t seed) {
+    portENTER_CRITICAL(&mux);
+    rngState = seed ? seed : 1;
+    lastUpdateUs = Clock::nowMicros();
+
+    for (uint8_t board = 0; board < NUM_MOTOR_BOARDS; board++) {
+        outputLatch[board] = 0;
+    }
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        SimMotor& m = motors[i];
+        m.positionUs = (int64_t)SIM_START_POSITION_MS * 1000;
+        m.switchUs = 0;
+        m.speedForward = MOTOR_SPEED_NOMINAL - SIM_SPEED_SPREAD + random() % (2 * SIM_SPEED_SPREAD + 1);
+        m.speedReverse = MOTOR_SPEED_NOMINAL - SIM_SPEED_SPREAD + random() % (2 * SIM_SPEED_SPREAD + 1);
+        m.drive = MOTOR_STOP;
+        m.switchClosed = false;
+        m.lastEdgeUs = 0;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Plant simulator: %d motors, seed %lu", NUM_MOTORS, (unsigned long)seed);
+}
+
+bool PlantSimulator::isPresent(uint8_t address) {
+    return address >= MCP_MOTOR_0 && address < MCP_MOTOR_0 + NUM_MOTOR_BOARDS + NUM_SWITCH_BOARDS;
+}
+
+bool PlantSimulator::busWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length) {
+    if (!isPresent(address)) {
+        return false;
+    }
+
+    // Only the motor board output latches affect the plant
+    uint8_t board = address - MCP_MOTOR_0;
+    if (board >= NUM_MOTOR_BOARDS) {
+        return true;
+    }
+
+    portENTER_CRITICAL(&mux);
+    advance();
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t r = reg + i;
+        if (r == SIM_REG_OLATA || r == SIM_REG_GPIOA) {
+            outputLatch[board] = (outputLatch[board] & 0xFF00) | data[i];
+        } else if (r == SIM_REG_OLATB || r == SIM_REG_GPIOB) {
+            outputLatch[board] = (outputLatch[board] & 0x00FF) | ((uint16_t)data[i] << 8);
+        }
+    }
+    applyOutputs(board);
+    portEXIT_CRITICAL(&mux);
+
+    return true;
+}
+
+bool PlantSimulator::busRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    if (!isPresent(address)) {
+        return false;
+    }
+
+    uint8_t board = address - MCP_MOTOR_0;
+
+    portENTER_CRITICAL(&mux);
+    advance();
+    uint16_t gpio = (board < NUM_MOTOR_BOARDS) ? outputLatch[board] : readSwitchBoard(address);
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t r = reg + i;
+        if (r == SIM_REG_GPIOA || r == SIM_REG_OLATA) {
+            data[i] = (r == SIM_REG_OLATA && board >= NUM_MOTOR_BOARDS) ? 0 : (gpio & 0xFF);
+        } else if (r == SIM_REG_GPIOB || r == SIM_REG_OLATB) {
+            data[i] = (r == SIM_REG_OLATB && board >= NUM_MOTOR_BOARDS) ? 0 : (gpio >> 8);
+        } else {
+            // Configuration and interrupt registers read back as zero (no INT lines)
+            data[i] = 0;
+        }
+    }
+    portEXIT_CRITICAL(&mux);
+
+    return true;
+}
+
+void PlantSimulator::setFastForward(bool enable) {
+    fastForward = enable;
+    Logger::logf(LOG_INFO, CAT_SYSTEM, "Plant simulator: fast-forward %s",
+                 enable ? "on - homing and tide sequences run on virtual time" : "off");
+}
+
+bool PlantSimulator::isFastForward() {
+    return fastForward;
+}
+
+SimMotor PlantSimulator::getMotor(uint8_t motorIndex) {
+    if (motorIndex >= NUM_MOTORS) {
+        motorIndex = 0;
+    }
+
+    portENTER_CRITICAL(&mux);
+    advance();
+    SimMotor motor = motors[motorIndex];
+    portEXIT_CRITICAL(&mux);
+
+    return motor;
+}
+
+void PlantSimulator::printState() {
+    Logger::info(CAT_SYSTEM, "Plant simulator state:");
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        SimMotor m = getMotor(i);
+        Logger::logf(LOG_INFO, CAT_SYSTEM, "  Motor %02d: %6ld ms  fwd %4u  rev %4u  %-7s  switch %s",
+                     i, (long)(m.positionUs / 1000), m.speedForward, m.speedReverse,
+                     MotorController::getDirectionString((MotorDirection)m.drive),
+                     m.switchClosed ? "CLOSED" : "open");
+    }
+}
+
+void PlantSimulator::advance() {
+    uint64_t now = Clock::nowMicros();
+    if (now <= lastUpdateUs) {
+        return;
+    }
+    uint64_t dt = now - lastUpdateUs;
+    lastUpdateUs = now;
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        SimMotor& m = motors[i];
+        if (m.drive == MOTOR_FORWARD || m.drive == MOTOR_REVERSE) {
+            uint16_t speed = (m.drive == MOTOR_FORWARD) ? m.speedForward : m.speedReverse;
+            int64_t travel = (int64_t)(dt * speed / 1000);
+            if (SIM_SLIP_PERMILLE > 0) {
+                travel -= travel * (random() % (SIM_SLIP_PERMILLE + 1)) / 1000;
+            }
+
+            m.positionUs += (m.drive == MOTOR_FORWARD) ? travel : -travel;
+
+            // Gearmotors stall against the mechanical stops
+            int64_t lower = m.switchUs - (int64_t)SIM_OVERTRAVEL_MS * 1000;
+            int64_t upper = (int64_t)SIM_TRAVEL_MAX_MS * 1000;
+            if (m.positionUs < lower) m.positionUs = lower;
+            if (m.positionUs > upper) m.positionUs = upper;
+        }
+
+        bool closed = m.switchClosed
+            ? m.positionUs <= m.switchUs + (int64_t)SIM_SWITCH_HYSTERESIS_MS * 1000
+            : m.positionUs <= m.switchUs;
+        if (closed != m.switchClosed) {
+            m.switchClosed = closed;
+            m.lastEdgeUs = now;
+        }
+    }
+}
+
+void PlantSimulator::applyOutputs(uint8_t board) {
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        if (!(PinTopology::MOTORS.boardMotors[board] & (1UL << i))) {
+            continue;
+        }
+
+        bool in1 = outputLatch[board] & PinTopology::MOTORS.in1Mask[i];
+        bool in2 = outputLatch[board] & PinTopology::MOTORS.in2Mask[i];
+        if (in1 && !in2) {
+            motors[i].drive = MOTOR_FORWARD;
+        } else if (in2 && !in1) {
+            motors[i].drive = MOTOR_REVERSE;
+        } else {
+            motors[i].drive = MOTOR_STOP;  // Coast or brake
+        }
+    }
+}
+
+uint16_t PlantSimulator::readSwitchBoard(uint8_t address) {
+    uint16_t gpio = 0xFFFF;  // Pull-ups: unused and open pins read high
+    uint64_t now = lastUpdateUs;
+
+    for (uint8_t i = 0; i < NUM_MOTORS; i++) {
+        const SwitchPinMap& pin = SWITCH_PIN_MAP[i];
+        if (pin.mcpAddress != address) {
+            continue;
+        }
+
+        bool closed = motors[i].switchClosed;
+        if (motors[i].lastEdgeUs != 0 && now - motors[i].lastEdgeUs < SIM_BOUNCE_US) {
+            closed = random() & 1;
+        } else if (SIM_READ_NOISE_PERMILLE > 0 && random() % 1000 < SIM_READ_NOISE_PERMILLE) {
+            closed = !closed;
+        }
+
+        if (closed) {
+            gpio &= ~(1U << pin.pin);
+        }
+    }
+
+    return gpio;
+}
+
+uint32_t PlantSimulator::random() {
+    uint32_t x = rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rngState = x;
+    return x;
+}
+
+#endif // TIDECLOCK_SIM
@@ -0,0 +1,114 @@
+/**
+ * Plant Simulator
+ *
+ * Software model of the 24 gearmotors and their limit switches, standing
+ * in for the five MCP23017 boards in TIDECLOCK_SIM builds. GPIOExpander
+ * routes its register reads and writes here instead of to the I2C bus, so
+ * everything above it (homing, timed moves, tide sequences) runs
+ * unmodified.
+ *
+ * Motor board output latches drive the motors; each motor travels at its
+ * own forward/reverse speed with random slip, between a lower mechanical
+ * stop just below its switch and an upper stop. Switch board GPIO reads
+ * return the switch levels (active low, as with the pull-ups), with
+ * contact bounce after each edge and optional read noise. Motion is
+ * integrated on Clock time. With fast-forward on (serial 'Z 1'), homing
+ * and tide sequences switch the Clock to virtual time, so they run to
+ * completion as fast as the CPU allows.
+ */
+
+#ifndef PLANT_SIMULATOR_H
+#define PLANT_SIMULATOR_H
+
+#ifdef TIDECLOCK_SIM
+
+#include <Arduino.h>
+#include "../config.h"
+
+/**
+ * One simulated motor and its limit switch
+ * Positions are in microseconds of travel at nominal speed above the
+ * switch trip point.
+ */
+struct SimMotor {
+    int64_t positionUs;         // Current position
+    int64_t switchUs;           // Trip point (closes at or below)
+    uint16_t speedForward;      // Permille of nominal
+    uint16_t speedReverse;      // Permille of nominal
+    uint8_t drive;              // MotorDirection from the output latches
+    bool switchClosed;          // Contact state (with hysteresis)
+    uint64_t lastEdgeUs;        // Clock time of the last contact change
+};
+
+class PlantSimulator {
+public:
+    /**
+     * Reset every motor to its start position with seeded speeds
+     */
+    static void begin(uint32_t seed = SIM_SEED);
+
+    /**
+     * Check if a simulated board answers at an I2C address
+     */
+    static bool isPresent(uint8_t address);
+
+    /**
+     * Register write (sequential addressing, IOCON.BANK = 0)
+     * @return false if no board at the address
+     */
+    static bool busWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length);
+
+    /**
+     * Register read (sequential addressing, IOCON.BANK = 0)
+     * @return false if no board at the address
+     */
+    static bool busRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+    /**
+     * Run homing and tide sequences on virtual time
+     */
+    static void setFastForward(bool enable);
+    static bool isFastForward();
+
+    /**
+     * Get a motor's state (advanced to the current time)
+     */
+    static SimMotor getMotor(uint8_t motorIndex);
+
+    /**
+     * Print every motor's position, speed and switch state
+     */
+    static void printState();
+
+private:
+    static SimMotor motors[NUM_MOTORS];
+    static uint16_t outputLatch[NUM_MOTOR_BOARDS];
+    static uint64_t lastUpdateUs;
+    static bool fastForward;
+    static uint32_t rngState;
+    static portMUX_TYPE mux;
+
+    /**
+     * Integrate motion from the last update to the current Clock time
+     */
+    static void advance();
+
+    /**
+     * Re-derive each motor's drive from a motor board's latches
+     */
+    static void applyOutputs(uint8_t board);
+
+    /**
+     * GPIO level of a switch board (bit set = pin high = switch open)
+     */
+    static uint16_t readSwitchBoard(uint8_t address);
+
+    /**
+     * Deterministic pseudo-random number (xorshift32)
+     */
+    static uint32_t random();
+};
+
+#endif // TIDECLOCK_SIM
+
+#endif // PLANT_SIMULATOR_H
@@ -0,0 +1,102 @@
+/**
+ * Bounded Queue
+ *
+ * Fixed-size lock-free FIFO for passing small structs between tasks.
+ * Any number of producers may push; one consumer pops. Each cell carries
+ * a sequence number that says whether it is free for the producer at a
+ * given position or holds data for the consumer at that position, so a
+ * push is one compare-and-swap on the tail plus two stores and never
+ * blocks or disables interrupts. Capacity must be a power of two.
+ */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+template <typename T, uint32_t CAPACITY>
+class BoundedQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "BoundedQueue capacity must be a power of two");
+
+public:
+    BoundedQueue() : head(0), tail(0) {
+        for (uint32_t i = 0; i < CAPACITY; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Append an item (any task)
+     * @return false if the queue is full
+     */
+    bool push(const T& item) {
+        uint32_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells[pos & (CAPACITY - 1)];
+            uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(seq - pos);
+
+            if (diff == 0) {
+                // Cell is free at this position - claim it
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Consumer has not freed this cell yet
+                return false;
+            } else {
+                // Another producer claimed it first
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest item (consumer task only)
+     * @return false if the queue is empty
+     */
+    bool pop(T& item) {
+        uint32_t pos = head.load(std::memory_order_relaxed);
+        Cell* cell = &cells[pos & (CAPACITY - 1)];
+        uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+
+        // Empty, or a producer has claimed the cell but not finished writing
+        if ((int32_t)(seq - (pos + 1)) < 0) {
+            return false;
+        }
+
+        item = cell->item;
+        cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Approximate number of queued items (exact when no push is in flight)
+     */
+    uint32_t size() const {
+        return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+    }
+
+    static uint32_t capacity() { return CAPACITY; }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        T item;
+    };
+
+    Cell cells[CAPACITY];
+    std::atomic<uint32_t> head;     // Next position to pop (consumer only)
+    std::atomic<uint32_t> tail;     // Next position to claim for a push
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,91 @@
+/**
+ * Monotonic Clock Implementation
+ */
+
+#include "Clock.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+bool Clock::virtualTime = false;
+volatile uint64_t Clock::virtualUs = 0;
+volatile uint64_t Clock::hardwareOffsetUs = 0;
+
+#ifdef ESP_PLATFORM
+// 64-bit virtual time and offsets are not read atomically on the ESP32
+static portMUX_TYPE virtualMux = portMUX_INITIALIZER_UNLOCKED;
+#define VIRTUAL_LOCK()   portENTER_CRITICAL_SAFE(&virtualMux)
+#define VIRTUAL_UNLOCK() portEXIT_CRITICAL_SAFE(&virtualMux)
+#else
+#define VIRTUAL_LOCK()
+#define VIRTUAL_UNLOCK()
+#endif
+
+static uint64_t hardwareMicros() {
+#ifdef ESP_PLATFORM
+    return (uint64_t)esp_timer_get_time();
+#else
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint64_t Clock::nowMicros() {
+    VIRTUAL_LOCK();
+    uint64_t now = virtualTime ? virtualUs : hardwareMicros() + hardwareOffsetUs;
+    VIRTUAL_UNLOCK();
+    return now;
+}
+
+uint64_t Clock::nowMillis() {
+    return nowMicros() / 1000;
+}
+
+void Clock::delayMs(uint32_t ms) {
+    if (virtualTime) {
+        advance((uint64_t)ms * 1000);
+        // Still let other tasks run, as a real delay would
+        yield();
+        return;
+    }
+
+    delay(ms);
+}
+
+void Clock::useVirtualTime() {
+    VIRTUAL_LOCK();
+    if (!virtualTime) {
+        virtualUs = hardwareMicros() + hardwareOffsetUs;
+        virtualTime = true;
+    }
+    VIRTUAL_UNLOCK();
+}
+
+void Clock::useHardwareTime() {
+    VIRTUAL_LOCK();
+    if (virtualTime) {
+        uint64_t hardware = hardwareMicros();
+        if (virtualUs > hardware) {
+            hardwareOffsetUs = virtualUs - hardware;
+        }
+        virtualTime = false;
+    }
+    VIRTUAL_UNLOCK();
+}
+
+bool Clock::isVirtual() {
+    return virtualTime;
+}
+
+void Clock::advance(uint64_t us) {
+    if (!virtualTime) {
+        return;
+    }
+
+    VIRTUAL_LOCK();
+    virtualUs += us;
+    VIRTUAL_UNLOCK();
+}
@@ -0,0 +1,64 @@
+/**
+ * Monotonic Clock
+ *
+ * 64-bit time base for all timing logic. On the ESP32 it reads the
+ * high-resolution esp_timer counter, which does not wrap for the life of
+ * an install (unlike the 32-bit millis() counter, which wraps after ~49
+ * days). Under virtual time, delays advance the clock instead of sleeping,
+ * so anything that waits through delayMs() runs as fast as the CPU allows.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <Arduino.h>
+
+class Clock {
+public:
+    /**
+     * Microseconds since boot (never wraps in practice)
+     */
+    static uint64_t nowMicros();
+
+    /**
+     * Milliseconds since boot (never wraps in practice)
+     */
+    static uint64_t nowMillis();
+
+    /**
+     * Wait for a number of milliseconds. Under virtual time the clock is
+     * advanced by the same amount and the call returns immediately.
+     * @param ms Delay in milliseconds
+     */
+    static void delayMs(uint32_t ms);
+
+    /**
+     * Switch to virtual time, starting at the current time. Time then only
+     * moves through delayMs() and advance().
+     */
+    static void useVirtualTime();
+
+    /**
+     * Return to the hardware clock, carrying on from the virtual time
+     * reached (the clock never steps backwards)
+     */
+    static void useHardwareTime();
+
+    /**
+     * Check if virtual time is active
+     */
+    static bool isVirtual();
+
+    /**
+     * Advance virtual time (no effect on the hardware clock)
+     * @param us Microseconds to advance
+     */
+    static void advance(uint64_t us);
+
+private:
+    static bool virtualTime;
+    static volatile uint64_t virtualUs;
+    static volatile uint64_t hardwareOffsetUs;  // Virtual time gained, added to the hardware clock
+};
+
+#endif // CLOCK_H
@@ -0,0 +1,66 @@
+/**
+ * Latency Histogram Implementation
+ */
+
+#include "LatencyHistogram.h"
+
+// Bucket upper bounds (exclusive); the last bucket collects everything above
+static const uint32_t BIN_UPPER_US[LATENCY_HISTOGRAM_BINS - 1] = {
+    100, 250, 500, 1000, 2000, 5000, 10000, 20000, 50000
+};
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(uint32_t valueUs) {
+    uint8_t bin = 0;
+    while (bin < LATENCY_HISTOGRAM_BINS - 1 && valueUs >= BIN_UPPER_US[bin]) {
+        bin++;
+    }
+    bins[bin]++;
+
+    if (count == 0 || valueUs < minUs) minUs = valueUs;
+    if (valueUs > maxUs) maxUs = valueUs;
+    lastUs = valueUs;
+    sumUs += valueUs;
+    count++;
+}
+
+void LatencyHistogram::reset() {
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BINS; i++) {
+        bins[i] = 0;
+    }
+    count = 0;
+    minUs = 0;
+    maxUs = 0;
+    lastUs = 0;
+    sumUs = 0;
+}
+
+uint32_t LatencyHistogram::getBinUpperUs(uint8_t bin) {
+    if (bin >= LATENCY_HISTOGRAM_BINS - 1) {
+        return 0;
+    }
+    return BIN_UPPER_US[bin];
+}
+
+void LatencyHistogram::print(LogCategory category, const char* title) const {
+    Logger::logf(LOG_INFO, category, "%s: %lu samples, min %lu us, mean %lu us, max %lu us",
+                 title, (unsigned long)count, (unsigned long)getMin(),
+                 (unsigned long)getMean(), (unsigned long)maxUs);
+
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BINS; i++) {
+        if (bins[i] == 0) {
+            continue;
+        }
+
+        if (i < LATENCY_HISTOGRAM_BINS - 1) {
+            Logger::logf(LOG_INFO, category, "  < %6lu us: %lu",
+                         (unsigned long)BIN_UPPER_US[i], (unsigned long)bins[i]);
+        } else {
+            Logger::logf(LOG_INFO, category, "  >= %5lu us: %lu",
+                         (unsigned long)BIN_UPPER_US[i - 1], (unsigned long)bins[i]);
+        }
+    }
+}
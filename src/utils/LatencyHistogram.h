@@ -0,0 +1,59 @@
+/**
+ * Latency Histogram
+ *
+ * Fixed-bucket histogram of microsecond durations (timing error,
+ * switch-to-stop latency, etc.). Buckets are roughly logarithmic from
+ * 100 us to 50 ms with a final overflow bucket.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <Arduino.h>
+#include "Logger.h"
+
+#define LATENCY_HISTOGRAM_BINS 10
+
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    /**
+     * Add one sample (microseconds)
+     */
+    void record(uint32_t valueUs);
+
+    /**
+     * Clear all samples
+     */
+    void reset();
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return count > 0 ? minUs : 0; }
+    uint32_t getMax() const { return maxUs; }
+    uint32_t getMean() const { return count > 0 ? (uint32_t)(sumUs / count) : 0; }
+    uint32_t getLast() const { return lastUs; }
+    uint32_t getBin(uint8_t bin) const { return bin < LATENCY_HISTOGRAM_BINS ? bins[bin] : 0; }
+
+    /**
+     * Upper bound of a bucket in microseconds (0 for the overflow bucket)
+     */
+    static uint32_t getBinUpperUs(uint8_t bin);
+
+    /**
+     * Print summary and non-empty buckets
+     * @param category Log category to print under
+     * @param title Heading for the printout
+     */
+    void print(LogCategory category, const char* title) const;
+
+private:
+    uint32_t bins[LATENCY_HISTOGRAM_BINS];
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t lastUs;
+    uint64_t sumUs;
+};
+
+#endif // LATENCY_HISTOGRAM_H